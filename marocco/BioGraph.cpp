@@ -1,5 +1,9 @@
 #include "marocco/BioGraph.h"
 
+#include <algorithm>
+#include <functional>
+#include <set>
+
 #include <boost/bind.hpp>
 #include <boost/graph/graphviz.hpp>
 #include <boost/ref.hpp>
@@ -7,6 +11,11 @@
 namespace marocco {
 
 void BioGraph::load(ObjectStore const& os)
+{
+	load(os, locality_type());
+}
+
+void BioGraph::load(ObjectStore const& os, locality_type const& is_local)
 {
 	for (auto pop : os.populations()) {
 		if (m_vertices.find(pop.get()) == m_vertices.end()) {
@@ -20,21 +29,186 @@ void BioGraph::load(ObjectStore const& os)
 		}
 	}
 
+	m_local.clear();
+	if (is_local) {
+		for (auto const& v : make_iterable(boost::vertices(m_graph))) {
+			m_local.push_back(is_local(v));
+		}
+	}
+
 	for (auto proj : os.projections()) {
-		for (auto proj_view : proj->flatten()) {
-			auto edge = add_edge(
-			    m_vertices.at(proj_view.pre().population_ptr().get()),
-			    m_vertices.at(proj_view.post().population_ptr().get()), proj_view, m_graph);
+		auto const views = proj->flatten();
+		for (size_t view = 0; view < views.size(); ++view) {
+			auto const& proj_view = views[view];
+			auto const pre = m_vertices.at(proj_view.pre().population_ptr().get());
+			auto const post = m_vertices.at(proj_view.post().population_ptr().get());
+
+			if (!this->is_local(pre) || !this->is_local(post)) {
+				continue;
+			}
+
+			auto edge = add_edge(pre, post, proj_view, m_graph);
 
 			if (!edge.second) {
 				std::runtime_error("could not build tree");
 			}
 
 			m_edges.insert(edges_type::value_type(edge.first, m_edges.size()));
+			m_connectivity.emplace_back(proj_view.getWeights());
+			m_views.push_back(view);
 		}
 	}
 }
 
+bool BioGraph::load(ObjectStore const& os, results::BioGraph const& stored)
+{
+	auto const& vertices = stored.vertices();
+	if (os.populations().size() != vertices.size()) {
+		return false;
+	}
+
+	{
+		size_t index = 0;
+		for (auto pop : os.populations()) {
+			auto const& vertex = vertices[index++];
+			if (vertex.population != size_t(pop->id()) || vertex.size != size_t(pop->size())) {
+				return false;
+			}
+		}
+	}
+
+	// Only projection views between local populations are stored, see load() above.
+	std::unordered_map<size_t, std::vector<ProjectionView> > views;
+	size_t num_local_views = 0;
+	for (auto proj : os.projections()) {
+		auto const& flattened = views.emplace(proj->id(), proj->flatten()).first->second;
+		for (auto const& proj_view : flattened) {
+			if (vertices[proj_view.pre().population_ptr()->id()].is_local &&
+			    vertices[proj_view.post().population_ptr()->id()].is_local) {
+				++num_local_views;
+			}
+		}
+	}
+
+	// Projections added since the results were stored would be dropped otherwise.
+	if (num_local_views != stored.num_edges()) {
+		return false;
+	}
+
+	// Check all edges before modifying this graph.
+	std::set<std::pair<size_t, size_t> > seen;
+	for (auto const& item : stored.edges()) {
+		auto const it = views.find(item.projection);
+		if (it == views.end() || item.view >= it->second.size() ||
+		    !seen.emplace(item.projection, item.view).second) {
+			return false;
+		}
+		auto const& proj_view = it->second[item.view];
+		if (size_t(proj_view.pre().population_ptr()->id()) != item.source ||
+		    size_t(proj_view.post().population_ptr()->id()) != item.target ||
+		    proj_view.pre().mask().count() != item.num_sources ||
+		    proj_view.post().mask().count() != item.num_targets ||
+		    item.targets.size() != item.weights.size()) {
+			return false;
+		}
+
+		// Check the CSR representation, which SparseConnectivity would reject otherwise.
+		auto const& offsets = item.row_offsets;
+		if (offsets.size() != item.num_sources + 1 || offsets.front() != 0 ||
+		    offsets.back() != item.targets.size() ||
+		    !std::is_sorted(offsets.begin(), offsets.end())) {
+			return false;
+		}
+		for (size_t src = 0; src < item.num_sources; ++src) {
+			auto const first = item.targets.begin() + offsets[src];
+			auto const last = item.targets.begin() + offsets[src + 1];
+			if (std::adjacent_find(first, last, std::greater_equal<size_t>()) != last ||
+			    (first != last && *(last - 1) >= item.num_targets)) {
+				return false;
+			}
+		}
+	}
+
+	m_graph.clear();
+	m_vertices.clear();
+	m_edges.clear();
+	m_connectivity.clear();
+	m_local.clear();
+	m_views.clear();
+
+	bool all_local = true;
+	for (auto pop : os.populations()) {
+		auto const v = add_vertex(boost::const_pointer_cast<const Population>(pop), m_graph);
+		m_vertices[pop.get()] = v;
+		all_local &= vertices[v].is_local;
+	}
+
+	if (!all_local) {
+		for (auto const& vertex : vertices) {
+			m_local.push_back(vertex.is_local);
+		}
+	}
+
+	m_connectivity.reserve(stored.num_edges());
+	m_views.reserve(stored.num_edges());
+	for (auto const& item : stored.edges()) {
+		auto const edge =
+			add_edge(item.source, item.target, views.at(item.projection)[item.view], m_graph);
+		m_edges.insert(edges_type::value_type(edge.first, m_edges.size()));
+
+		std::vector<SparseConnectivity::Entry> rows;
+		rows.reserve(item.targets.size());
+		for (size_t ii = 0; ii < item.targets.size(); ++ii) {
+			rows.push_back(SparseConnectivity::Entry{item.targets[ii], item.weights[ii]});
+		}
+		m_connectivity.emplace_back(
+			item.num_sources, item.num_targets, item.row_offsets, std::move(rows));
+		m_views.push_back(item.view);
+	}
+
+	return true;
+}
+
+void BioGraph::store(results::BioGraph& stored) const
+{
+	stored.clear();
+
+	for (auto const& v : make_iterable(boost::vertices(m_graph))) {
+		auto const& pop = *m_graph[v];
+		stored.add(results::BioGraph::Vertex{size_t(pop.id()), size_t(pop.size()), is_local(v)});
+	}
+
+	for (size_t id = 0; id < m_connectivity.size(); ++id) {
+		auto const edge = m_edges.right.at(id);
+		auto const& connectivity = m_connectivity[id];
+
+		results::BioGraph::Edge item;
+		item.source = boost::source(edge, m_graph);
+		item.target = boost::target(edge, m_graph);
+		item.projection = m_graph[edge].projection()->id();
+		item.view = m_views[id];
+		item.num_sources = connectivity.num_sources();
+		item.num_targets = connectivity.num_targets();
+		item.row_offsets.reserve(item.num_sources + 1);
+		item.row_offsets.push_back(0);
+		item.targets.reserve(connectivity.size());
+		item.weights.reserve(connectivity.size());
+		for (size_t src = 0; src < item.num_sources; ++src) {
+			for (auto const& entry : connectivity.targets(src)) {
+				item.targets.push_back(entry.index);
+				item.weights.push_back(entry.weight);
+			}
+			item.row_offsets.push_back(item.targets.size());
+		}
+		stored.add(std::move(item));
+	}
+}
+
+bool BioGraph::is_local(vertex_descriptor const& vertex) const
+{
+	return m_local.empty() || m_local.at(vertex);
+}
+
 auto BioGraph::operator[](Population const* pop) const -> vertex_descriptor
 {
 	return m_vertices.at(pop);
@@ -60,6 +234,11 @@ auto BioGraph::edge_from_id(routing::results::Edge const& id) const -> edge_desc
 	return m_edges.right.at(id.value());
 }
 
+SparseConnectivity const& BioGraph::connectivity(edge_descriptor const& edge) const
+{
+	return m_connectivity.at(m_edges.left.at(edge));
+}
+
 void BioGraph::write_graphviz(std::string const& filename) const
 {
 	// try to open file
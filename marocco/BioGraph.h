@@ -1,7 +1,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
 #ifndef PYPLUSPLUS
+#include <functional>
 #include <unordered_map>
 #endif // !PYPLUSPLUS
 #include <boost/bimap.hpp>
@@ -16,7 +18,9 @@ class ConstPopulationPtr {};
 class ProjectionView {};
 #endif // !PYPLUSPLUS
 
+#include "marocco/SparseConnectivity.h"
 #include "marocco/util/iterable.h"
+#include "marocco/results/BioGraph.h"
 #include "marocco/routing/results/Edge.h"
 
 namespace marocco {
@@ -43,6 +47,38 @@ public:
 
 	void load(ObjectStore const& os);
 
+#ifndef PYPLUSPLUS
+	typedef std::function<bool(vertex_descriptor)> locality_type;
+
+	/**
+	 * @brief Load the part of the network that is mapped to a single wafer.
+	 * All populations are added as vertices, so that vertex descriptors still coincide
+	 * with euter population ids.  Only projections between local populations are added
+	 * as edges, though.
+	 * @param is_local Predicate which decides whether a population is mapped locally.
+	 */
+	void load(ObjectStore const& os, locality_type const& is_local);
+
+	/**
+	 * @brief Restore a graph previously stored via \c store().
+	 * Projections are flattened again to obtain their projection views, but their weight
+	 * matrices are not evaluated, synapses are taken from the stored graph instead.
+	 * @return False if the stored graph does not match the given network, e.g. because
+	 *         projections were added since, or if its synapses are inconsistent.  In this
+	 *         case this graph is left unchanged.
+	 */
+	bool load(ObjectStore const& os, results::BioGraph const& stored);
+
+	/// Store topology, edge ids and synapses of this graph in compact form.
+	void store(results::BioGraph& stored) const;
+#endif // !PYPLUSPLUS
+
+	/**
+	 * @brief Check whether the given population is part of the locally mapped network.
+	 * @note All populations are local if the graph was loaded without locality predicate.
+	 */
+	bool is_local(vertex_descriptor const& vertex) const;
+
 	/**
 	 * @brief Return vertex descriptor for the specified population.
 	 * @throw std::out_of_range If the population is not contained in this graph.
@@ -56,6 +92,13 @@ public:
 
 	edge_descriptor edge_from_id(routing::results::Edge const& id) const;
 
+	/**
+	 * @brief Return the synapses of the given projection view in sparse form.
+	 * This is built once during \c load() and should be preferred over iterating the
+	 * dense weight matrix, which is mostly empty for sparsely connected networks.
+	 */
+	SparseConnectivity const& connectivity(edge_descriptor const& edge) const;
+
 	/**
 	 * @brief Export graph in graphviz format.
 	 * @throw std::runtime_error If the specified file could not be opened.
@@ -67,6 +110,12 @@ private:
 	graph_type m_graph;
 	vertices_type m_vertices;
 	edges_type m_edges;
+	/// Indexed by edge id.
+	std::vector<SparseConnectivity> m_connectivity;
+	/// Empty if all populations are local.
+	std::vector<bool> m_local;
+	/// Index of each projection view in its flattened projection, indexed by edge id.
+	std::vector<size_t> m_views;
 #endif // !PYPLUSPLUS
 }; // BioGraph
 
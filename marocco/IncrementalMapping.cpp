@@ -0,0 +1,320 @@
+#include "marocco/IncrementalMapping.h"
+
+#include <algorithm>
+#include <sstream>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/functional/hash.hpp>
+#include <boost/serialization/vector.hpp>
+
+#include "euter/current.h"
+#include "euter/typedcellparametervector.h"
+
+#include "marocco/experiment/parameters/Experiment.h"
+#include "marocco/results/Marocco.h"
+#include "marocco/routing/STPMode.h"
+#include "marocco/util/iterable.h"
+#include "pymarocco/PyMarocco.h"
+
+namespace marocco {
+
+namespace {
+
+struct NeuronParametersVisitor
+{
+	typedef void return_type;
+
+	template <CellType N>
+	void operator()(
+		TypedCellParameterVector<N> const& v, boost::archive::binary_oarchive& archive) const
+	{
+		archive << v.parameters();
+	}
+}; // NeuronParametersVisitor
+
+} // namespace
+
+IncrementalMapping::IncrementalMapping()
+	: m_valid(false),
+	  m_bio_graph(),
+	  m_parameters(),
+	  m_neuron_parameters(),
+	  m_present(),
+	  m_changed_hicanns(),
+	  m_valid_experiment(false),
+	  m_analog_outputs(),
+	  m_spike_input(),
+	  m_configured(false)
+{
+}
+
+void IncrementalMapping::store(
+	ObjectStore const& pynn,
+	BioGraph const& bio_graph,
+	pymarocco::PyMarocco const& pymarocco,
+	resource_manager_t const& mgr)
+{
+	m_bio_graph = bio_graph;
+	m_parameters = fingerprint(pymarocco);
+	m_neuron_parameters = neuron_parameters(pynn, bio_graph);
+	m_present = present(mgr);
+	m_valid = true;
+}
+
+void IncrementalMapping::reset()
+{
+	m_valid = false;
+	m_bio_graph = BioGraph();
+	m_parameters.clear();
+	m_neuron_parameters.clear();
+	m_present.clear();
+	m_changed_hicanns.clear();
+	m_valid_experiment = false;
+	m_analog_outputs.clear();
+	m_spike_input.clear();
+	m_configured = false;
+}
+
+bool IncrementalMapping::weights_only(
+	ObjectStore const& pynn,
+	BioGraph const& bio_graph,
+	pymarocco::PyMarocco const& pymarocco,
+	resource_manager_t const& mgr) const
+{
+	return m_valid && same_network(bio_graph) && m_present == present(mgr) &&
+	       m_parameters == fingerprint(pymarocco) &&
+	       m_neuron_parameters == neuron_parameters(pynn, bio_graph);
+}
+
+bool IncrementalMapping::same_network(BioGraph const& bio_graph) const
+{
+	auto const& previous_graph = m_bio_graph.graph();
+	auto const& graph = bio_graph.graph();
+
+	if (boost::num_vertices(previous_graph) != boost::num_vertices(graph) ||
+	    boost::num_edges(previous_graph) != boost::num_edges(graph)) {
+		return false;
+	}
+
+	for (auto const& vertex : make_iterable(boost::vertices(graph))) {
+		auto const& previous_pop = *previous_graph[vertex];
+		auto const& pop = *graph[vertex];
+		if (previous_pop.id() != pop.id() || previous_pop.size() != pop.size() ||
+		    previous_pop.type() != pop.type() ||
+		    m_bio_graph.is_local(vertex) != bio_graph.is_local(vertex)) {
+			return false;
+		}
+	}
+
+	for (auto const& edge : make_iterable(boost::edges(graph))) {
+		// Edge ids are assigned in order of iteration over the projections, thus the
+		// number of edges being equal, each id is also present in the previous graph.
+		auto const previous_edge = m_bio_graph.edge_from_id(bio_graph.edge_to_id(edge));
+		if (boost::source(previous_edge, previous_graph) != boost::source(edge, graph) ||
+		    boost::target(previous_edge, previous_graph) != boost::target(edge, graph)) {
+			return false;
+		}
+
+		ProjectionView const previous_view = previous_graph[previous_edge];
+		ProjectionView const view = graph[edge];
+		auto const& previous_proj = *previous_view.projection();
+		auto const& proj = *view.projection();
+		if (previous_proj.id() != proj.id() || previous_proj.target() != proj.target() ||
+		    routing::toSTPMode(previous_proj.dynamics()) != routing::toSTPMode(proj.dynamics()) ||
+		    previous_view.pre().mask() != view.pre().mask() ||
+		    previous_view.post().mask() != view.post().mask()) {
+			return false;
+		}
+
+		if (!m_bio_graph.connectivity(previous_edge).same_synapses(bio_graph.connectivity(edge))) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::vector<BioGraph::edge_descriptor> IncrementalMapping::changed_edges(
+	BioGraph const& bio_graph) const
+{
+	std::vector<BioGraph::edge_descriptor> result;
+	for (auto const& edge : make_iterable(boost::edges(bio_graph.graph()))) {
+		auto const previous_edge = m_bio_graph.edge_from_id(bio_graph.edge_to_id(edge));
+		if (m_bio_graph.connectivity(previous_edge) != bio_graph.connectivity(edge)) {
+			result.push_back(edge);
+		}
+	}
+	return result;
+}
+
+auto IncrementalMapping::changed_hicanns() const -> hicanns_type const&
+{
+	return m_changed_hicanns;
+}
+
+void IncrementalMapping::changed_hicanns(hicanns_type const& hicanns)
+{
+	m_changed_hicanns = hicanns;
+}
+
+auto IncrementalMapping::update_experiment(
+	results::Marocco const& results,
+	experiment::parameters::Experiment const& experiment_parameters) -> ExperimentChanges
+{
+	auto current_analog_outputs = analog_outputs(results);
+	auto current_spike_input = spike_input(results, experiment_parameters);
+
+	ExperimentChanges changes;
+	changes.all = !m_valid_experiment;
+	if (m_valid_experiment) {
+		changes.analog_outputs = differing(m_analog_outputs, current_analog_outputs);
+		changes.spike_input = differing(m_spike_input, current_spike_input);
+	} else {
+		for (auto const& item : current_analog_outputs) {
+			changes.analog_outputs.insert(item.first);
+		}
+		for (auto const& item : current_spike_input) {
+			changes.spike_input.insert(item.first);
+		}
+	}
+
+	m_changed_hicanns.insert(changes.analog_outputs.begin(), changes.analog_outputs.end());
+	m_changed_hicanns.insert(changes.spike_input.begin(), changes.spike_input.end());
+
+	m_analog_outputs = std::move(current_analog_outputs);
+	m_spike_input = std::move(current_spike_input);
+	m_valid_experiment = true;
+	return changes;
+}
+
+bool IncrementalMapping::configured() const
+{
+	return m_configured;
+}
+
+void IncrementalMapping::configured(bool const value)
+{
+	m_configured = value;
+}
+
+std::string IncrementalMapping::fingerprint(pymarocco::PyMarocco const& pymarocco)
+{
+	auto parameters = pymarocco;
+	parameters.setStats(pymarocco::MappingStats());
+
+	std::ostringstream stream;
+	{
+		boost::archive::binary_oarchive archive{stream};
+		archive << parameters;
+	}
+	return stream.str();
+}
+
+std::string IncrementalMapping::neuron_parameters(
+	ObjectStore const& pynn, BioGraph const& bio_graph)
+{
+	NeuronParametersVisitor const visitor{};
+	auto const& graph = bio_graph.graph();
+
+	std::ostringstream stream;
+	{
+		boost::archive::binary_oarchive archive{stream};
+		for (auto const& vertex : make_iterable(boost::vertices(graph))) {
+			auto const& pop = *graph[vertex];
+			if (pop.parameters().is_source()) {
+				continue;
+			}
+			visitCellParameterVector(pop.parameters(), visitor, archive);
+		}
+
+		for (auto const& current_source : pynn.current_sources()) {
+			for (auto const& view : current_source->target()->populations()) {
+				size_t const id = view.population_ptr()->id();
+				archive << id;
+				auto const& mask = view.mask();
+				size_t const size = mask.size();
+				archive << size;
+				for (size_t ii = 0; ii < mask.size(); ++ii) {
+					bool const bit = mask[ii];
+					archive << bit;
+				}
+			}
+			auto const step_source =
+				boost::dynamic_pointer_cast<StepCurrentSource const>(current_source);
+			if (step_source) {
+				archive << step_source->times() << step_source->amplitudes();
+			}
+		}
+	}
+	return stream.str();
+}
+
+auto IncrementalMapping::present(resource_manager_t const& mgr) -> hicanns_type
+{
+	hicanns_type result;
+	for (auto const& hicann : mgr.present()) {
+		result.insert(hicann.toHICANNOnWafer());
+	}
+	return result;
+}
+
+auto IncrementalMapping::analog_outputs(results::Marocco const& results) -> fingerprints_type
+{
+	fingerprints_type result;
+	// Items are ordered by HICANN.  As the choice of denmems to record depends on the order
+	// of items on the same HICANN, it is taken into account.
+	for (auto const& item : results.analog_outputs) {
+		auto& seed = result[item.hicann()];
+		boost::hash_combine(seed, item.logical_neuron());
+		boost::hash_combine(seed, item.analog_output().value());
+	}
+	return result;
+}
+
+auto IncrementalMapping::spike_input(
+	results::Marocco const& results,
+	experiment::parameters::Experiment const& experiment_parameters) -> fingerprints_type
+{
+	static double const ms_to_s = 1e-3;
+	double const bio_duration_in_ms = experiment_parameters.bio_duration_in_s() / ms_to_s;
+
+	size_t timing = 0;
+	boost::hash_combine(timing, experiment_parameters.speedup());
+	boost::hash_combine(timing, experiment_parameters.offset_in_s());
+
+	fingerprints_type result;
+	for (auto const& item : results.placement) {
+		auto const& address = item.address();
+		if (!item.logical_neuron().is_external() || address == boost::none) {
+			continue;
+		}
+
+		auto const& spikes = results.spike_times.get(item.bio_neuron());
+		size_t seed = timing;
+		boost::hash_combine(seed, *address);
+		boost::hash_range(
+			seed, spikes.begin(), std::upper_bound(spikes.begin(), spikes.end(), bio_duration_in_ms));
+		// Summed up to be independent of the order of iteration over placement results.
+		result[address->toHICANNOnWafer()] += seed;
+	}
+	return result;
+}
+
+auto IncrementalMapping::differing(fingerprints_type const& lhs, fingerprints_type const& rhs)
+	-> hicanns_type
+{
+	hicanns_type result;
+	for (auto const& item : lhs) {
+		auto const it = rhs.find(item.first);
+		if (it == rhs.end() || it->second != item.second) {
+			result.insert(item.first);
+		}
+	}
+	for (auto const& item : rhs) {
+		if (lhs.find(item.first) == lhs.end()) {
+			result.insert(item.first);
+		}
+	}
+	return result;
+}
+
+} // namespace marocco
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "hal/Coordinate/HICANN.h"
+
+#include "marocco/BioGraph.h"
+#include "marocco/config.h"
+
+namespace pymarocco {
+class PyMarocco;
+} // namespace pymarocco
+
+namespace marocco {
+
+namespace experiment {
+namespace parameters {
+class Experiment;
+} // namespace parameters
+} // namespace experiment
+
+namespace results {
+class Marocco;
+} // namespace results
+
+/**
+ * @brief State of the last mapping run of “in the loop”-style experiments.
+ * If the network only differs from the last run in its synaptic weights, placement and
+ * routing results can be reused and only the synapse weights of the affected HICANNs
+ * have to be transformed again.
+ * Independently of that, per-HICANN content hashes of analog outputs and spike input
+ * are kept, so that repeated runs only reconfigure HICANNs whose experiment setup changed.
+ * @see PyMarocco::incremental_weight_update
+ */
+class IncrementalMapping
+{
+public:
+	typedef std::set<HMF::Coordinate::HICANNOnWafer> hicanns_type;
+
+	/// HICANNs whose experiment configuration differs from the last run.
+	struct ExperimentChanges
+	{
+		/// There is no previous configuration to compare against, e.g. after \c reset().
+		bool all;
+		hicanns_type analog_outputs;
+		hicanns_type spike_input;
+	};
+
+	IncrementalMapping();
+
+	/**
+	 * @brief Remember network, mapping parameters and available resources of a
+	 *        successful mapping run.
+	 */
+	void store(
+		ObjectStore const& pynn,
+		BioGraph const& bio_graph,
+		pymarocco::PyMarocco const& pymarocco,
+		resource_manager_t const& mgr);
+
+	/**
+	 * @brief Forget the last mapping run, e.g. because its results are about to be replaced.
+	 * This also invalidates the stored experiment configuration.
+	 */
+	void reset();
+
+	/**
+	 * @brief Check whether the given network can be mapped by only updating synapse
+	 *        weights.
+	 * This is the case if populations, projections (including the set of existing
+	 * synapses), parameters of neurons and current sources, mapping parameters and
+	 * defects are unchanged since the last run.
+	 * @note Parameters of spike sources are not compared, as spike times are always
+	 *       extracted again.
+	 */
+	bool weights_only(
+		ObjectStore const& pynn,
+		BioGraph const& bio_graph,
+		pymarocco::PyMarocco const& pymarocco,
+		resource_manager_t const& mgr) const;
+
+	/**
+	 * @brief Projection views whose synaptic weights differ from the last run.
+	 * @pre \c weights_only() holds for the given network.
+	 */
+	std::vector<BioGraph::edge_descriptor> changed_edges(BioGraph const& bio_graph) const;
+
+	/**
+	 * @brief HICANNs whose configuration was modified by the last mapping run.
+	 * Includes changes of analog outputs and spike input, see \c update_experiment().
+	 */
+	hicanns_type const& changed_hicanns() const;
+	void changed_hicanns(hicanns_type const& hicanns);
+
+	/**
+	 * @brief Compare analog outputs and spike input of the given experiment to the last
+	 *        call, based on per-HICANN content hashes.
+	 * Affected HICANNs are added to \c changed_hicanns() and the hashes of the given
+	 * experiment are stored for the next call.
+	 * @note Spike times after the end of the experiment are ignored, as they are never
+	 *       uploaded to the hardware.
+	 */
+	ExperimentChanges update_experiment(
+		results::Marocco const& results,
+		experiment::parameters::Experiment const& experiment_parameters);
+
+	/**
+	 * @brief Whether the hardware holds the configuration of the last run.
+	 * Only then HICANNs not contained in \c changed_hicanns() can be skipped when the
+	 * hardware is configured again.  Cleared by \c reset().
+	 */
+	bool configured() const;
+	void configured(bool value);
+
+private:
+	typedef std::map<HMF::Coordinate::HICANNOnWafer, size_t> fingerprints_type;
+
+	/// Serialized mapping parameters, excluding the statistics of previous runs.
+	static std::string fingerprint(pymarocco::PyMarocco const& pymarocco);
+	static hicanns_type present(resource_manager_t const& mgr);
+	/// Serialized parameters of neurons (excluding spike sources) and current sources.
+	static std::string neuron_parameters(ObjectStore const& pynn, BioGraph const& bio_graph);
+	static fingerprints_type analog_outputs(results::Marocco const& results);
+	static fingerprints_type spike_input(
+		results::Marocco const& results,
+		experiment::parameters::Experiment const& experiment_parameters);
+	/// HICANNs with differing hashes, including those only present in one of both.
+	static hicanns_type differing(fingerprints_type const& lhs, fingerprints_type const& rhs);
+
+	bool same_network(BioGraph const& bio_graph) const;
+
+	bool m_valid;
+	BioGraph m_bio_graph;
+	std::string m_parameters;
+	std::string m_neuron_parameters;
+	hicanns_type m_present;
+	hicanns_type m_changed_hicanns;
+	bool m_valid_experiment;
+	fingerprints_type m_analog_outputs;
+	fingerprints_type m_spike_input;
+	bool m_configured;
+}; // IncrementalMapping
+
+} // namespace marocco
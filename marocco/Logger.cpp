@@ -1,6 +1,7 @@
 #include "marocco/Logger.h"
 
 #include <memory>
+#include <log4cxx/asyncappender.h>
 #include <log4cxx/basicconfigurator.h>
 #include <log4cxx/consoleappender.h>
 #include <colorlayout.h>
@@ -20,13 +21,13 @@ std::string demangle(std::string const& n)
 	return status==0 ? name.get() : "__cxa_demangle error";
 }
 
-void Logger::init(LevelPtr const& level)
+void Logger::init(LevelPtr const& level, bool asynchronous)
 {
 	typedef vector<pair<string, log4cxx::LevelPtr>> type;
-	init(type { make_pair( DEFAULT_LOGGER, level) });
+	init(type { make_pair( DEFAULT_LOGGER, level) }, asynchronous);
 }
 
-void Logger::init(vector<pair<string, log4cxx::LevelPtr>> const& levels)
+void Logger::init(vector<pair<string, log4cxx::LevelPtr>> const& levels, bool asynchronous)
 {
 	static bool is_init = false;
 	if (!is_init) {
@@ -36,9 +37,15 @@ void Logger::init(vector<pair<string, log4cxx::LevelPtr>> const& levels)
 		// clever way to ensure propper configuration.
 		BasicConfigurator::resetConfiguration();
 
-		ConsoleAppender* console = new ConsoleAppender(
-			LayoutPtr(new ColorLayout()));
-		BasicConfigurator::configure(AppenderPtr(console));
+		AppenderPtr console(new ConsoleAppender(LayoutPtr(new ColorLayout())));
+		if (asynchronous) {
+			// Formatting and writing of log messages happens in a separate thread.
+			AsyncAppender* async = new AsyncAppender();
+			async->addAppender(console);
+			BasicConfigurator::configure(AppenderPtr(async));
+		} else {
+			BasicConfigurator::configure(console);
+		}
 
 		for (auto const& lvl : levels)
 		{
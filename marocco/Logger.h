@@ -33,8 +33,15 @@ class Logger
 public:
 	typedef void (log4cxx::Logger:: *type)(std::string const&) const;
 
-	static void init(log4cxx::LevelPtr const& level = log4cxx::Level::getAll());
-	static void init(std::vector<std::pair<std::string, log4cxx::LevelPtr> > const& levels);
+	/**
+	 * @param asynchronous Deliver log messages via a background thread, so log sites
+	 *                     do not block on console output.
+	 */
+	static void init(
+		log4cxx::LevelPtr const& level = log4cxx::Level::getAll(), bool asynchronous = false);
+	static void init(
+		std::vector<std::pair<std::string, log4cxx::LevelPtr> > const& levels,
+		bool asynchronous = false);
 
 	template<typename T>
 	Logger(type f, T const* _this);
@@ -49,6 +56,14 @@ public:
 	template<typename T>
 	static char const* getLogger(T const* t);
 
+	/**
+	 * @brief Returns the log4cxx logger for the given class.
+	 * The logger is looked up in the log4cxx repository only once per class, which
+	 * avoids the string-keyed lookup on every log statement.
+	 */
+	template<typename T>
+	static log4cxx::LoggerPtr const& getLoggerPtr(T const* t);
+
 private:
 	template<typename T>
 	static std::string getLogger_(T const* t);
@@ -78,37 +93,77 @@ MAROCCO_LOGGER_SINK(trace)
 #undef MAROCCO_LOGGER_SINK
 
 
+/**
+ * Compile-time minimum log level.  Log statements below this level are removed by the
+ * preprocessor, all other statements check the runtime log level before any stream
+ * formatting takes place.  Defaults to TRACE, or WARN if MAROCCO_NDEBUG is defined.
+ */
+#define MAROCCO_LOG_LEVEL_TRACE 0
+#define MAROCCO_LOG_LEVEL_DEBUG 1
+#define MAROCCO_LOG_LEVEL_INFO 2
+#define MAROCCO_LOG_LEVEL_WARN 3
+#define MAROCCO_LOG_LEVEL_ERROR 4
+#define MAROCCO_LOG_LEVEL_FATAL 5
+
+#ifndef MAROCCO_LOG_LEVEL
+#if !defined(MAROCCO_NDEBUG)
+#define MAROCCO_LOG_LEVEL MAROCCO_LOG_LEVEL_TRACE
+#else
+#define MAROCCO_LOG_LEVEL MAROCCO_LOG_LEVEL_WARN
+#endif // !MAROCCO_NDEBUG
+#endif // !MAROCCO_LOG_LEVEL
+
 #define __MAROCCO_LOGGER_MACRO(level, ...) \
 	LOG4CXX_ ## level ( \
-		log4cxx::Logger::getLogger(marocco::Logger::getLogger(this)), \
+		marocco::Logger::getLoggerPtr(this), \
 		__VA_ARGS__ )
 
-#if !defined(MAROCCO_NDEBUG)
 #define MAROCCO_FATAL(...) __MAROCCO_LOGGER_MACRO(FATAL, __VA_ARGS__ )
+
+#if MAROCCO_LOG_LEVEL <= MAROCCO_LOG_LEVEL_ERROR
 #define MAROCCO_ERROR(...) __MAROCCO_LOGGER_MACRO(ERROR, __VA_ARGS__ )
+#else
+#define MAROCCO_ERROR(...)
+#endif
+
+#if MAROCCO_LOG_LEVEL <= MAROCCO_LOG_LEVEL_WARN
 #define MAROCCO_WARN(...) __MAROCCO_LOGGER_MACRO(WARN, __VA_ARGS__ )
+#else
+#define MAROCCO_WARN(...)
+#endif
+
+#if MAROCCO_LOG_LEVEL <= MAROCCO_LOG_LEVEL_INFO
 #define MAROCCO_INFO(...) __MAROCCO_LOGGER_MACRO(INFO, __VA_ARGS__ )
-#define MAROCCO_DEBUG(...) __MAROCCO_LOGGER_MACRO(DEBUG, __VA_ARGS__ )
-#define MAROCCO_TRACE(...) __MAROCCO_LOGGER_MACRO(TRACE, __VA_ARGS__ )
 #else
-#define MAROCCO_FATAL(...) __MAROCCO_LOGGER_MACRO(FATAL, __VA_ARGS__ )
-#define MAROCCO_ERROR(...) __MAROCCO_LOGGER_MACRO(ERROR, __VA_ARGS__ )
-#define MAROCCO_WARN(...) __MAROCCO_LOGGER_MACRO(WARN, __VA_ARGS__ )
 #define MAROCCO_INFO(...)
+#endif
+
+#if MAROCCO_LOG_LEVEL <= MAROCCO_LOG_LEVEL_DEBUG
+#define MAROCCO_DEBUG(...) __MAROCCO_LOGGER_MACRO(DEBUG, __VA_ARGS__ )
+#else
 #define MAROCCO_DEBUG(...)
+#endif
+
+#if MAROCCO_LOG_LEVEL <= MAROCCO_LOG_LEVEL_TRACE
+#define MAROCCO_TRACE(...) __MAROCCO_LOGGER_MACRO(TRACE, __VA_ARGS__ )
+#else
 #define MAROCCO_TRACE(...)
 #endif
 
 #define __MAROCCO_LOGGER_ENABLED(LEVEL)                                                            \
-	(log4cxx::Logger::getLogger(marocco::Logger::getLogger(this))->is##LEVEL##Enabled())
+	(marocco::Logger::getLoggerPtr(this)->is##LEVEL##Enabled())
 
-#ifndef MAROCCO_NDEBUG
+#if MAROCCO_LOG_LEVEL <= MAROCCO_LOG_LEVEL_DEBUG
 #define MAROCCO_DEBUG_ENABLED() __MAROCCO_LOGGER_ENABLED(Debug)
-#define MAROCCO_TRACE_ENABLED() __MAROCCO_LOGGER_ENABLED(Trace)
 #else
 #define MAROCCO_DEBUG_ENABLED() false
+#endif
+
+#if MAROCCO_LOG_LEVEL <= MAROCCO_LOG_LEVEL_TRACE
+#define MAROCCO_TRACE_ENABLED() __MAROCCO_LOGGER_ENABLED(Trace)
+#else
 #define MAROCCO_TRACE_ENABLED() false
-#endif // !MAROCCO_NDEBUG
+#endif
 
 
 template<typename T>
@@ -131,6 +186,13 @@ char const* Logger::getLogger(T const* t)
 	return logger.c_str();
 }
 
+template<typename T>
+log4cxx::LoggerPtr const& Logger::getLoggerPtr(T const* t)
+{
+	static log4cxx::LoggerPtr const logger = log4cxx::Logger::getLogger(getLogger(t));
+	return logger;
+}
+
 template<typename T>
 std::string Logger::getLogger_(T const* /*instance*/)
 {
@@ -8,6 +8,7 @@
 #include "marocco/HardwareUsage.h"
 #include "marocco/Logger.h"
 #include "marocco/Mapper.h"
+#include "marocco/MappingCache.h"
 #include "marocco/Result.h"
 #include "marocco/parameter/AnalogOutputs.h"
 #include "marocco/parameter/CurrentSources.h"
@@ -15,8 +16,10 @@
 #include "marocco/parameter/HICANNParameters.h"
 #include "marocco/placement/Placement.h"
 #include "marocco/routing/Routing.h"
+#include "marocco/routing/RoutingPortfolio.h"
 #include "marocco/routing/SynapseLoss.h"
 #include "marocco/util/iterable.h"
+#include "marocco/util/stage_timer.h"
 
 using namespace pymarocco;
 
@@ -24,13 +27,13 @@ namespace marocco {
 
 namespace {
 
-template<typename Graph>
-size_t num_neurons(Graph const& g)
+size_t num_neurons(BioGraph const& bio_graph)
 {
+	auto const& g = bio_graph.graph();
 	size_t cnt = 0;
 	for (auto const& vd : make_iterable(vertices(g))) {
 		auto pop = g[vd];
-		if (!pop->parameters().is_source()) {
+		if (!pop->parameters().is_source() && bio_graph.is_local(vd)) {
 			cnt += pop->size();
 		}
 	}
@@ -71,6 +74,20 @@ boost::shared_ptr<calibtic::backend::Backend> load_calibtic_backend(
 	return backend;
 }
 
+boost::shared_ptr<calibtic::backend::Backend> load_calibtic_backend(
+	pymarocco::PyMarocco const& pymarocco)
+{
+	switch (pymarocco.calib_backend) {
+		case pymarocco::PyMarocco::CalibBackend::XML:
+		case pymarocco::PyMarocco::CalibBackend::Binary:
+			return load_calibtic_backend(pymarocco.calib_path, pymarocco.calib_backend);
+		case pymarocco::PyMarocco::CalibBackend::Default:
+			return {};
+		default:
+			throw std::runtime_error("unknown calibration backend type");
+	}
+}
+
 } // namespace
 
 Mapper::Mapper(
@@ -78,7 +95,22 @@ Mapper::Mapper(
 	resource_manager_t& mgr,
 	boost::shared_ptr<PyMarocco> const& pymarocco,
 	boost::shared_ptr<results::Marocco> const& results)
-	: mBioGraph(), mMgr(mgr), mHW(hw), mPyMarocco(pymarocco), m_results(results)
+	: Mapper(hw, mgr, pymarocco, results, {})
+{
+}
+
+Mapper::Mapper(
+	hardware_type& hw,
+	resource_manager_t& mgr,
+	boost::shared_ptr<PyMarocco> const& pymarocco,
+	boost::shared_ptr<results::Marocco> const& results,
+	boost::shared_ptr<IncrementalMapping> const& incremental)
+	: mBioGraph(),
+	  mMgr(mgr),
+	  mHW(hw),
+	  mPyMarocco(pymarocco),
+	  m_results(results),
+	  m_incremental(incremental)
 {
 	if (!mPyMarocco) {
 		mPyMarocco = PyMarocco::create();
@@ -90,29 +122,75 @@ Mapper::Mapper(
 }
 
 void Mapper::run(ObjectStore const& pynn)
+{
+	run(pynn, BioGraph::locality_type());
+}
+
+void Mapper::run(ObjectStore const& pynn, BioGraph::locality_type const& is_local)
 {
 	auto start = std::chrono::system_clock::now();
 
 	// B U I L D   G R A P H
-	mBioGraph.load(pynn);
+	{
+		StageTimer timer(getStats(), "bio_graph");
+		bool restored = false;
+		if (mPyMarocco->skip_mapping && !m_results->bio_graph.empty()) {
+			restored = mBioGraph.load(pynn, m_results->bio_graph);
+			if (!restored) {
+				MAROCCO_WARN("bio graph stored in mapping results does not match network");
+			}
+		}
+		if (!restored) {
+			mBioGraph.load(pynn, is_local);
+		}
 
-	// write out bio graph in graphviz format
-	if (!mPyMarocco->bio_graph.empty()) {
-		MAROCCO_INFO("writing bio graph to " << mPyMarocco->bio_graph);
-		mBioGraph.write_graphviz(mPyMarocco->bio_graph);
+		// write out bio graph in graphviz format
+		if (!mPyMarocco->bio_graph.empty()) {
+			MAROCCO_INFO("writing bio graph to " << mPyMarocco->bio_graph);
+			mBioGraph.write_graphviz(mPyMarocco->bio_graph);
+		}
 	}
 
 	auto& graph = mBioGraph.graph();
 
-	size_t neuron_count = num_neurons(graph);
+	size_t neuron_count = num_neurons(mBioGraph);
 	MAROCCO_INFO(
 	    neuron_count << " neurons in " << boost::num_vertices(graph) << " populations");
 
 	if (mPyMarocco->skip_mapping) {
+		if (m_incremental) {
+			// The hardware configuration may have been modified by the user, so nothing
+			// is known about what changed since the last run.
+			m_incremental->reset();
+			auto const allocated = mHW.getAllocatedHicannCoordinates();
+			m_incremental->changed_hicanns(
+				IncrementalMapping::hicanns_type(allocated.begin(), allocated.end()));
+		}
 		// We only need to set up the bio graph when using old results.
 		return;
 	}
 
+	if (m_incremental) {
+		if (mPyMarocco->incremental_weight_update &&
+		    m_incremental->weights_only(pynn, mBioGraph, *mPyMarocco, mMgr)) {
+			StageTimer timer(getStats(), "weight_update");
+			update_weights(pynn, timer);
+			mBioGraph.store(m_results->bio_graph);
+			timer.stop();
+
+			// Spike sources are not compared by IncrementalMapping::weights_only().
+			translate_spike_times(pynn);
+
+			auto end = std::chrono::system_clock::now();
+			getStats().timeTotal =
+				std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+			return;
+		}
+
+		// Results are about to be replaced.
+		m_incremental->reset();
+	}
+
 	// rough capacity check; in case we can stop mapping already here
 	if (neuron_count > mHW.capacity()) {
 		throw std::runtime_error("hardware capacity too low");
@@ -122,39 +200,88 @@ void Mapper::run(ObjectStore const& pynn)
 		m_results->resources.add(hicann);
 	}
 
+	std::unique_ptr<MappingCache> cache;
+	MappingCache::key_type cache_key;
+	bool cache_hit = false;
+	if (!mPyMarocco->mapping_cache.empty()) {
+		StageTimer timer(getStats(), "mapping_cache");
+		cache.reset(new MappingCache(mPyMarocco->mapping_cache, mPyMarocco->mapping_cache_max_size));
+		cache_key = MappingCache::key(mBioGraph, *mPyMarocco, mMgr, mHW.index());
+		cache_hit = cache->load(cache_key, *m_results, mHW, getStats());
+	}
+
 	// The 3 1/2-steps to complete happiness
 
-	// 1.  P L A C E M E N T
-	placement::Placement placer(*mPyMarocco, graph, mHW, mMgr);
-	auto placement = placer.run(m_results->placement);
+	std::unique_ptr<BaseResult> placement_result;
+	size_t total_loss = 0;
 
-	// 2.  R O U T I N G
-	routing::Routing router(
-		mBioGraph, mHW, mMgr, *mPyMarocco, m_results->placement);
-	router.run(m_results->l1_routing, m_results->synapse_routing);
-	auto synapse_loss = router.getSynapseLoss();
+	if (cache_hit) {
+		MAROCCO_INFO("Reusing cached placement and routing results");
+		allocate_cached_resources();
+		placement_result.reset(new placement::Result(m_results->placement));
+		total_loss = getStats().getSynapseLoss();
+	} else {
+		// 1.  P L A C E M E N T
+		{
+			StageTimer timer(getStats(), "placement");
+			placement::Placement placer(*mPyMarocco, mBioGraph, mHW, mMgr);
+			placement_result = placer.run(m_results->placement);
+		}
 
-	// 3.  P A R A M E T E R   T R A N S L A T I O N
+		// 2.  R O U T I N G
+		StageTimer routing_timer(getStats(), "routing");
+		boost::shared_ptr<routing::SynapseLoss> synapse_loss;
+		if (mPyMarocco->routing_portfolio.empty()) {
+			routing::Routing router(
+				mBioGraph, mHW, mMgr, *mPyMarocco, m_results->placement);
+			router.run(m_results->l1_routing, m_results->synapse_routing);
+			synapse_loss = router.getSynapseLoss();
+		} else {
+			routing::RoutingPortfolio portfolio(
+				mBioGraph, mHW, mMgr, *mPyMarocco, m_results->placement);
+			portfolio.run(m_results->l1_routing, m_results->synapse_routing);
+			synapse_loss = portfolio.getSynapseLoss();
+		}
+		routing_timer.stop();
 
-	boost::shared_ptr<calibtic::backend::Backend> calib_backend;
-	switch (mPyMarocco->calib_backend) {
-		case pymarocco::PyMarocco::CalibBackend::XML:
-		case pymarocco::PyMarocco::CalibBackend::Binary:
-			calib_backend =
-			    load_calibtic_backend(mPyMarocco->calib_path, mPyMarocco->calib_backend);
-			break;
-		case pymarocco::PyMarocco::CalibBackend::Default:
-			break;
-		default:
-			throw std::runtime_error("unknown calibration backend type");
+		if (synapse_loss) {
+			synapse_loss->fill(getStats());
+			total_loss = synapse_loss->getTotalLoss();
+		} else {
+			MAROCCO_WARN("no synapse loss data available");
+		}
+
+		if (cache) {
+			StageTimer timer(getStats(), "mapping_cache");
+			// Hardware configuration is stored before parameter translation, which is
+			// always carried out as it depends on neuron parameters and calibration.
+			cache->store(cache_key, *m_results, mHW, getStats());
+		}
 	}
 
+	if (cache) {
+		getStats().setMappingCacheHits(cache->hits());
+		getStats().setMappingCacheMisses(cache->misses());
+	}
+
+	// 3.  P A R A M E T E R   T R A N S L A T I O N
+
+	StageTimer parameter_timer(getStats(), "parameter_translation");
+
+	auto const calib_backend = load_calibtic_backend(*mPyMarocco);
+
 	for (auto const& hicann : mMgr.allocated()) {
+		auto const hicann_start = StageTimer::clock_type::now();
+		trace::Scope trace(
+			"hicann_parameters", "parameter",
+			{"hicann", std::int64_t(hicann.toHICANNOnWafer().toEnum().value())});
 		auto& chip = mHW[hicann];
 		parameter::HICANNParameters hicann_parameters(
 			mBioGraph, chip, *mPyMarocco, m_results->placement, m_results->synapse_routing,
 			calib_backend, pynn.getDuration());
 		hicann_parameters.run();
+		parameter_timer.hot_spot(
+			hicann.toHICANNOnWafer(), StageTimer::clock_type::now() - hicann_start);
 	}
 
 	// collect current sources
@@ -170,6 +297,9 @@ void Mapper::run(ObjectStore const& pynn)
 				}
 
 				auto vertex = mBioGraph[population_view.population_ptr().get()];
+				if (!mBioGraph.is_local(vertex)) {
+					continue;
+				}
 				bio_current_sources[BioNeuron(vertex, ii)] = current_source;
 			}
 		}
@@ -186,8 +316,9 @@ void Mapper::run(ObjectStore const& pynn)
 	parameter::AnalogOutputs aouts(mBioGraph, m_results->placement);
 	aouts.run(m_results->analog_outputs);
 
-	parameter::SpikeTimes spike_times(mBioGraph, pynn.getDuration());
-	spike_times.run(m_results->spike_times);
+	parameter_timer.stop();
+
+	translate_spike_times(pynn);
 
 	auto end = std::chrono::system_clock::now();
 	getStats().timeTotal =
@@ -199,25 +330,106 @@ void Mapper::run(ObjectStore const& pynn)
 	getStats().setNumProjections(pynn.projections().size());
 	getStats().setNumNeurons(neuron_count);
 
-	if (synapse_loss) {
-		synapse_loss->fill(getStats());
-	} else {
-		MAROCCO_WARN("no synapse loss data available");
-	}
-
 	// and print them
 	MAROCCO_INFO(getStats());
 
-	if (synapse_loss && !mPyMarocco->continue_despite_synapse_loss &&
-	    synapse_loss->getTotalLoss() != 0) {
+	if (!mPyMarocco->continue_despite_synapse_loss && total_loss != 0) {
 		throw std::runtime_error("Synapses lost but synapse loss is not accepted. Set "
 		                         "PyMarocco continue_despite_synapse_loss to true to "
 		                         "continue with loss.");
 	}
 
 	// generate Hardware stats
-	HardwareUsage usage(mHW, mMgr, *placement);
-	usage.fill(getStats());
+	{
+		StageTimer timer(getStats(), "hardware_usage");
+		HardwareUsage usage(mHW, mMgr, *placement_result);
+		usage.fill(getStats());
+	}
+
+	mBioGraph.store(m_results->bio_graph);
+
+	if (m_incremental) {
+		IncrementalMapping::hicanns_type hicanns;
+		for (auto const& hicann : mMgr.allocated()) {
+			hicanns.insert(hicann.toHICANNOnWafer());
+		}
+		m_incremental->store(pynn, mBioGraph, *mPyMarocco, mMgr);
+		m_incremental->changed_hicanns(hicanns);
+	}
+}
+
+void Mapper::translate_spike_times(ObjectStore const& pynn)
+{
+	StageTimer timer(getStats(), "spike_times");
+	parameter::SpikeTimes spike_times(mBioGraph, pynn.getDuration());
+	spike_times.run(m_results->spike_times);
+}
+
+void Mapper::allocate_cached_resources()
+{
+	std::set<HMF::Coordinate::HICANNOnWafer> hicanns;
+	for (auto const& item : m_results->placement) {
+		if (auto const& neuron_block = item.neuron_block()) {
+			hicanns.insert(neuron_block->toHICANNOnWafer());
+		}
+		if (auto const& address = item.address()) {
+			hicanns.insert(address->toHICANNOnWafer());
+		}
+	}
+
+	for (auto const& item : m_results->l1_routing) {
+		for (auto const& hicann : item.hicanns()) {
+			hicanns.insert(hicann);
+		}
+	}
+
+	for (auto const& hicann : mHW.getAllocatedHicannCoordinates()) {
+		hicanns.insert(hicann);
+	}
+
+	for (auto const& hicann : hicanns) {
+		HMF::Coordinate::HICANNGlobal const resource(hicann, mHW.index());
+		if (mMgr.available(resource)) {
+			mMgr.allocate(resource);
+		}
+	}
+}
+
+void Mapper::update_weights(ObjectStore const& pynn, StageTimer& timer)
+{
+	IncrementalMapping::hicanns_type hicanns;
+	auto const& synapses = m_results->synapse_routing.synapses();
+	auto const& graph = mBioGraph.graph();
+	auto const changed_edges = m_incremental->changed_edges(mBioGraph);
+	for (auto const& edge : changed_edges) {
+		auto const edge_id = mBioGraph.edge_to_id(edge);
+		for (auto const& item : synapses.find(graph[edge].projection()->id())) {
+			if (!(item.edge() == edge_id) || !item.hardware_synapse()) {
+				continue;
+			}
+			hicanns.insert(item.hardware_synapse()->toHICANNOnWafer());
+		}
+	}
+
+	MAROCCO_INFO(
+		"Only synaptic weights changed, reusing placement and routing: " << changed_edges.size()
+		<< " projection view(s) with changed weights on " << hicanns.size() << " HICANN(s)");
+
+	auto const calib_backend = load_calibtic_backend(*mPyMarocco);
+	for (auto const& hicann : hicanns) {
+		auto const hicann_start = StageTimer::clock_type::now();
+		parameter::HICANNParameters hicann_parameters(
+			mBioGraph, mHW[hicann], *mPyMarocco, m_results->placement,
+			m_results->synapse_routing, calib_backend, pynn.getDuration());
+		hicann_parameters.update_synapses();
+		timer.hot_spot(hicann, StageTimer::clock_type::now() - hicann_start);
+	}
+
+	// Synapse loss is unchanged, as placement and routing are reused.
+	routing::SynapseLoss::update_weights(mBioGraph, changed_edges, getStats());
+
+	m_incremental->store(pynn, mBioGraph, *mPyMarocco, mMgr);
+	m_incremental->changed_hicanns(hicanns);
 }
 
 Mapper::hardware_type&
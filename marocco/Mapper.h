@@ -5,12 +5,15 @@
 #include <utility>
 
 #include "marocco/BioGraph.h"
+#include "marocco/IncrementalMapping.h"
 #include "marocco/config.h"
 #include "marocco/results/Marocco.h"
 #include "pymarocco/PyMarocco.h"
 
 namespace marocco {
 
+class StageTimer;
+
 class Mapper
 {
 public:
@@ -22,8 +25,26 @@ public:
 		boost::shared_ptr<pymarocco::PyMarocco> const& pymarocco,
 		boost::shared_ptr<results::Marocco> const& results);
 
+	/**
+	 * @param incremental State of the last mapping run, which is updated by \c run().
+	 *        If \c PyMarocco::incremental_weight_update is set and only synaptic weights
+	 *        changed since then, placement and routing results are reused.
+	 */
+	Mapper(
+		hardware_type& hw,
+		resource_manager_t& mgr,
+		boost::shared_ptr<pymarocco::PyMarocco> const& pymarocco,
+		boost::shared_ptr<results::Marocco> const& results,
+		boost::shared_ptr<IncrementalMapping> const& incremental);
+
 	void run(ObjectStore const& pynn);
 
+	/**
+	 * @brief Map the part of the network that is local to the wafer of this mapper.
+	 * @see BioGraph::load()
+	 */
+	void run(ObjectStore const& pynn, BioGraph::locality_type const& is_local);
+
 	hardware_type&       getHardware();
 	hardware_type const& getHardware() const;
 
@@ -36,6 +57,18 @@ public:
 	boost::shared_ptr<results::Marocco const> results() const;
 
 private:
+	/**
+	 * @brief Transform synapse weights of HICANNs affected by changed projection views.
+	 * Weight statistics are updated accordingly.
+	 */
+	void update_weights(ObjectStore const& pynn, StageTimer& timer);
+
+	/// Extract spike times of spike sources into the mapping results.
+	void translate_spike_times(ObjectStore const& pynn);
+
+	/// Allocate HICANNs used by placement and routing results loaded from the mapping cache.
+	void allocate_cached_resources();
+
 	BioGraph mBioGraph;
 
 	// resource manager
@@ -47,6 +80,8 @@ private:
 	boost::shared_ptr<pymarocco::PyMarocco> mPyMarocco;
 
 	boost::shared_ptr<results::Marocco> m_results;
+
+	boost::shared_ptr<IncrementalMapping> m_incremental;
 };
 
 } // namespace marocco
@@ -0,0 +1,468 @@
+#include "marocco/MappingCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <dlfcn.h>
+#include <unistd.h>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "marocco/Logger.h"
+#include "marocco/placement/internal/FiringRateVisitor.h"
+#include "marocco/routing/STPMode.h"
+#include "marocco/routing/internal/SynapseTargetVisitor.h"
+#include "marocco/util/iterable.h"
+#include "pymarocco/PyMarocco.h"
+
+#ifndef MAROCCO_VERSION
+#define MAROCCO_VERSION "unknown"
+#endif // MAROCCO_VERSION
+
+using namespace HMF::Coordinate;
+namespace bfs = boost::filesystem;
+
+namespace marocco {
+
+namespace {
+
+/// Has to be increased whenever the layout of cache entries changes.
+size_t const cache_format_version = 2;
+
+char const* const results_filename = "results.bin";
+char const* const hardware_filename = "wafer.bin";
+char const* const stats_filename = "stats.bin";
+char const* const statistics_filename = "statistics";
+
+/**
+ * @brief 64-bit FNV-1a hash.
+ * In contrast to \c std::hash, the result only depends on the hashed bytes, which allows
+ * to use it as a persistent key.
+ */
+class Fingerprint
+{
+public:
+	Fingerprint() : m_state(14695981039346656037ull)
+	{
+	}
+
+	void add(void const* data, size_t size)
+	{
+		auto const* bytes = static_cast<unsigned char const*>(data);
+		for (size_t ii = 0; ii < size; ++ii) {
+			m_state ^= bytes[ii];
+			m_state *= 1099511628211ull;
+		}
+	}
+
+	void add(size_t value)
+	{
+		add(&value, sizeof(value));
+	}
+
+	void add(double value)
+	{
+		add(&value, sizeof(value));
+	}
+
+	void add(std::string const& value)
+	{
+		add(value.size());
+		add(value.data(), value.size());
+	}
+
+	template <typename Mask>
+	void add_mask(Mask const& mask)
+	{
+		add(size_t(mask.size()));
+		for (size_t ii = 0; ii < mask.size(); ++ii) {
+			add(size_t(mask[ii]));
+		}
+	}
+
+	/// Parameter classes are hashed via their serialized representation.
+	template <typename T>
+	void add_serialized(T const& value)
+	{
+		std::ostringstream stream;
+		{
+			boost::archive::binary_oarchive archive{stream};
+			archive << value;
+		}
+		add(stream.str());
+	}
+
+	template <typename T>
+	void add_disabled(T const& component)
+	{
+		add(size_t(std::distance(component->begin_disabled(), component->end_disabled())));
+		for (auto it = component->begin_disabled(); it != component->end_disabled(); ++it) {
+			add(size_t(it->toEnum().value()));
+		}
+	}
+
+	std::string hex() const
+	{
+		std::ostringstream stream;
+		stream << std::hex << std::setw(16) << std::setfill('0') << m_state;
+		return stream.str();
+	}
+
+private:
+	std::uint64_t m_state;
+}; // Fingerprint
+
+/**
+ * @brief Identifies the build of marocco, s.t. entries created by different code are not
+ *        reused.
+ * The version determined at configure time does not change when the code is modified
+ * afterwards, thus the shared object (or executable) containing this function is hashed.
+ */
+std::string const& build_id()
+{
+	static std::string const id = [] {
+		Dl_info info;
+		if (dladdr(reinterpret_cast<void*>(&build_id), &info) != 0 && info.dli_fname) {
+			bfs::ifstream stream(info.dli_fname, std::ios::binary);
+			if (stream) {
+				Fingerprint fingerprint;
+				std::vector<char> buffer(1 << 16);
+				while (stream.read(buffer.data(), buffer.size()) || stream.gcount() > 0) {
+					fingerprint.add(buffer.data(), size_t(stream.gcount()));
+				}
+				return std::string(MAROCCO_VERSION) + "-" + fingerprint.hex();
+			}
+		}
+
+		// Without a way to identify the build, entries must not be reused by other
+		// processes, which possibly run different code.
+		LOG4CXX_WARN(
+			log4cxx::Logger::getLogger("marocco"),
+			"Could not identify build of marocco, mapping cache will not be reused");
+		std::ostringstream stream;
+		stream << MAROCCO_VERSION << "-" << ::getpid() << "-"
+		       << std::chrono::system_clock::now().time_since_epoch().count();
+		return stream.str();
+	}();
+	return id;
+}
+
+void add_network(
+	Fingerprint& fingerprint, BioGraph const& bio_graph, pymarocco::PyMarocco const& pymarocco)
+{
+	auto const& graph = bio_graph.graph();
+	bool const consider_firing_rate = pymarocco.input_placement.consider_firing_rate();
+	placement::internal::FiringRateVisitor firing_rate_visitor(pymarocco.experiment.speedup());
+	routing::internal::SynapseTargetVisitor const synapse_target_visitor{};
+
+	fingerprint.add(size_t(boost::num_vertices(graph)));
+	for (auto const& vertex : make_iterable(boost::vertices(graph))) {
+		auto const& pop = *graph[vertex];
+		fingerprint.add(size_t(pop.id()));
+		fingerprint.add(size_t(pop.size()));
+		fingerprint.add(size_t(pop.type()));
+		fingerprint.add(size_t(bio_graph.is_local(vertex)));
+
+		if (!bio_graph.is_local(vertex)) {
+			continue;
+		}
+
+		// Neuron parameters only matter for the mapping in so far as they determine the
+		// available synaptic inputs or the bandwidth needed for external input.
+		for (size_t neuron = 0; neuron < pop.size(); ++neuron) {
+			if (!pop.parameters().is_source()) {
+				fingerprint.add(size_t(visitCellParameterVector(
+					pop.parameters(), synapse_target_visitor, neuron).size()));
+			} else if (consider_firing_rate) {
+				fingerprint.add(
+					visitCellParameterVector(pop.parameters(), firing_rate_visitor, neuron));
+			}
+		}
+	}
+
+	// Edge ids reflect the order of projections and thus the order of routing.
+	size_t const num_edges = boost::num_edges(graph);
+	fingerprint.add(num_edges);
+	for (size_t id = 0; id < num_edges; ++id) {
+		auto const edge = bio_graph.edge_from_id(routing::results::Edge(id));
+		ProjectionView const view = graph[edge];
+		auto const& proj = *view.projection();
+		fingerprint.add(size_t(boost::source(edge, graph)));
+		fingerprint.add(size_t(boost::target(edge, graph)));
+		fingerprint.add(size_t(proj.id()));
+		fingerprint.add(proj.target());
+		fingerprint.add(size_t(routing::toSTPMode(proj.dynamics())));
+		fingerprint.add_mask(view.pre().mask());
+		fingerprint.add_mask(view.post().mask());
+
+		auto const& connectivity = bio_graph.connectivity(edge);
+		fingerprint.add(connectivity.num_sources());
+		fingerprint.add(connectivity.num_targets());
+		fingerprint.add(connectivity.size());
+		for (size_t src = 0; src < connectivity.num_sources(); ++src) {
+			for (auto const& synapse : connectivity.targets(src)) {
+				fingerprint.add(src);
+				fingerprint.add(synapse.index);
+				fingerprint.add(synapse.weight);
+			}
+		}
+	}
+}
+
+void add_defects(Fingerprint& fingerprint, resource_manager_t const& mgr)
+{
+	for (auto const& hicann : mgr.present()) {
+		fingerprint.add(size_t(hicann.toHICANNOnWafer().toEnum().value()));
+
+		auto const defects = mgr.get(hicann);
+		fingerprint.add(size_t(defects->neurons()->has_value()));
+		fingerprint.add_disabled(defects->neurons());
+		fingerprint.add_disabled(defects->mergers0());
+		fingerprint.add_disabled(defects->mergers1());
+		fingerprint.add_disabled(defects->mergers2());
+		fingerprint.add_disabled(defects->mergers3());
+		fingerprint.add_disabled(defects->dncmergers());
+		fingerprint.add_disabled(defects->hbuses());
+		fingerprint.add_disabled(defects->vbuses());
+		fingerprint.add_disabled(defects->drivers());
+		fingerprint.add_disabled(defects->synapses());
+	}
+}
+
+size_t entry_size(bfs::path const& entry)
+{
+	size_t result = 0;
+	for (auto const& file : make_iterable(bfs::directory_iterator(entry), bfs::directory_iterator())) {
+		if (bfs::is_regular_file(file.status())) {
+			result += bfs::file_size(file.path());
+		}
+	}
+	return result;
+}
+
+} // namespace
+
+MappingCache::MappingCache(std::string const& directory, size_t max_size)
+	: m_directory(directory), m_max_size(max_size), m_hits(0), m_misses(0)
+{
+	bfs::create_directories(m_directory);
+
+	bfs::ifstream stream(bfs::path(m_directory) / statistics_filename);
+	if (stream) {
+		stream >> m_hits >> m_misses;
+		if (!stream) {
+			MAROCCO_WARN("Could not read statistics of mapping cache in " << m_directory);
+			m_hits = 0;
+			m_misses = 0;
+		}
+	}
+}
+
+auto MappingCache::key(
+	BioGraph const& bio_graph,
+	pymarocco::PyMarocco const& pymarocco,
+	resource_manager_t const& mgr,
+	Wafer const& wafer) -> key_type
+{
+	Fingerprint fingerprint;
+	fingerprint.add(build_id());
+	fingerprint.add(cache_format_version);
+	fingerprint.add(size_t(wafer.value()));
+
+	add_network(fingerprint, bio_graph, pymarocco);
+
+	fingerprint.add_serialized(pymarocco.input_placement);
+	fingerprint.add_serialized(pymarocco.manual_placement);
+	fingerprint.add_serialized(pymarocco.merger_routing);
+	fingerprint.add_serialized(pymarocco.neuron_placement);
+	fingerprint.add_serialized(pymarocco.l1_address_assignment);
+	fingerprint.add_serialized(pymarocco.l1_routing);
+	fingerprint.add_serialized(pymarocco.routing_portfolio);
+	fingerprint.add_serialized(pymarocco.synapse_routing);
+	// Used to estimate the bandwidth of external input.
+	fingerprint.add(pymarocco.experiment.speedup());
+
+	add_defects(fingerprint, mgr);
+
+	return fingerprint.hex();
+}
+
+bool MappingCache::load(
+	key_type const& key,
+	results::Marocco& results,
+	sthal::Wafer& hardware,
+	pymarocco::MappingStats& stats)
+{
+	bfs::path const entry = bfs::path(m_directory) / key;
+	if (!bfs::is_directory(entry)) {
+		update_statistics(false);
+		return false;
+	}
+
+	MAROCCO_INFO("Loading placement and routing results from mapping cache " << entry);
+	try {
+		// Everything is loaded into temporaries first, s.t. a broken entry (e.g. because
+		// of a full disk or a changed archive version) does not leave partial results.
+		results::Marocco cached_results;
+		cached_results.load((entry / results_filename).native());
+
+		pymarocco::MappingStats cached_stats;
+		{
+			bfs::ifstream stream(entry / stats_filename);
+			if (!stream) {
+				throw std::runtime_error("could not open statistics");
+			}
+			boost::archive::binary_iarchive archive{stream};
+			size_t synapses_set;
+			archive >> cached_stats >> synapses_set;
+			// Not part of the serialized representation of MappingStats.
+			cached_stats.setSynapsesSet(synapses_set);
+		}
+
+		auto const hardware_path = (entry / hardware_filename).native();
+		{
+			sthal::Wafer cached_hardware(hardware.index());
+			cached_hardware.load(hardware_path.c_str());
+		}
+		hardware.load(hardware_path.c_str());
+
+		results = std::move(cached_results);
+		// Keep timing information of the current run.
+		cached_stats.addStages(stats);
+		stats = cached_stats;
+	} catch (std::exception const& err) {
+		MAROCCO_WARN("Removing unreadable entry " << entry << " from mapping cache: " << err.what());
+		boost::system::error_code error;
+		bfs::remove_all(entry, error);
+		update_statistics(false);
+		return false;
+	}
+
+	// Mark entry as recently used.
+	bfs::last_write_time(entry, std::time(nullptr));
+
+	update_statistics(true);
+	return true;
+}
+
+void MappingCache::store(
+	key_type const& key,
+	results::Marocco const& results,
+	sthal::Wafer const& hardware,
+	pymarocco::MappingStats const& stats)
+{
+	bfs::path const entry = bfs::path(m_directory) / key;
+	if (bfs::exists(entry)) {
+		return;
+	}
+
+	bfs::path const tmp = bfs::path(m_directory) / bfs::unique_path(key + ".tmp-%%%%-%%%%");
+	bfs::create_directory(tmp);
+
+	results.save((tmp / results_filename).native(), /*overwrite=*/true);
+	hardware.dump((tmp / hardware_filename).native().c_str(), /*overwrite=*/true);
+
+	{
+		bfs::ofstream stream(tmp / stats_filename);
+		boost::archive::binary_oarchive archive{stream};
+		// Timing information is specific to the run that created the entry.
+		auto cached = stats;
+		cached.clearStages();
+		size_t const synapses_set = stats.getSynapsesSet();
+		archive << cached << synapses_set;
+	}
+
+	boost::system::error_code error;
+	bfs::rename(tmp, entry, error);
+	if (error) {
+		// Most likely another process stored the same entry in the meantime.
+		bfs::remove_all(tmp);
+		return;
+	}
+
+	MAROCCO_INFO("Stored placement and routing results in mapping cache " << entry);
+	evict();
+}
+
+size_t MappingCache::hits() const
+{
+	return m_hits;
+}
+
+size_t MappingCache::misses() const
+{
+	return m_misses;
+}
+
+void MappingCache::update_statistics(bool hit)
+{
+	// Re-read counts to include lookups of other processes since construction.
+	{
+		bfs::ifstream stream(bfs::path(m_directory) / statistics_filename);
+		size_t hits, misses;
+		if (stream && stream >> hits >> misses) {
+			m_hits = hits;
+			m_misses = misses;
+		}
+	}
+
+	++(hit ? m_hits : m_misses);
+
+	bfs::path const tmp =
+		bfs::path(m_directory) / bfs::unique_path(std::string(statistics_filename) + ".tmp-%%%%-%%%%");
+	{
+		bfs::ofstream stream(tmp);
+		stream << m_hits << " " << m_misses << "\n";
+	}
+	bfs::rename(tmp, bfs::path(m_directory) / statistics_filename);
+}
+
+void MappingCache::evict()
+{
+	if (m_max_size == 0) {
+		return;
+	}
+
+	struct Entry
+	{
+		bfs::path path;
+		std::time_t last_used;
+		size_t size;
+	};
+
+	std::vector<Entry> entries;
+	size_t total_size = 0;
+	for (auto const& item : make_iterable(bfs::directory_iterator(m_directory), bfs::directory_iterator())) {
+		auto const& path = item.path();
+		if (!bfs::is_directory(item.status()) ||
+		    path.filename().native().find(".tmp-") != std::string::npos) {
+			continue;
+		}
+		entries.push_back(Entry{path, bfs::last_write_time(path), entry_size(path)});
+		total_size += entries.back().size;
+	}
+
+	// Most recently used entries first.
+	std::sort(entries.begin(), entries.end(), [](Entry const& lhs, Entry const& rhs) {
+		return lhs.last_used > rhs.last_used;
+	});
+
+	// The most recently used entry is always kept, even if it exceeds the limit on its own.
+	while (total_size > m_max_size && entries.size() > 1) {
+		auto const& entry = entries.back();
+		MAROCCO_DEBUG("Removing least recently used entry " << entry.path << " from mapping cache");
+		boost::system::error_code error;
+		bfs::remove_all(entry.path, error);
+		total_size -= entry.size;
+		entries.pop_back();
+	}
+}
+
+} // namespace marocco
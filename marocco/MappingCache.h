@@ -0,0 +1,94 @@
+#pragma once
+
+#include <string>
+
+#include "hal/Coordinate/HICANN.h"
+#include "sthal/Wafer.h"
+
+#include "marocco/BioGraph.h"
+#include "marocco/config.h"
+#include "marocco/results/Marocco.h"
+#include "pymarocco/MappingStats.h"
+
+namespace pymarocco {
+class PyMarocco;
+} // namespace pymarocco
+
+namespace marocco {
+
+/**
+ * @brief Content-addressed on-disk cache of placement and routing results.
+ * Entries are identified by a hash of all inputs that affect placement and routing, see
+ * \c key().  Each entry holds the mapping results, the hardware configuration after
+ * routing and the routing statistics in a separate subdirectory of the cache directory.
+ * If the accumulated size of all entries exceeds the given limit, least recently used
+ * entries are removed.
+ * Cumulative hit and miss counts are stored alongside the entries.
+ * @note Entries are written to a temporary directory and then renamed, so that several
+ *       processes can share the same cache directory.  Concurrent updates of the hit and
+ *       miss counts may get lost, though.
+ */
+class MappingCache
+{
+public:
+	typedef std::string key_type;
+
+	/**
+	 * @param directory Cache directory, which is created if it does not exist.
+	 * @param max_size Maximum accumulated size of all entries in bytes, 0 means unlimited.
+	 */
+	MappingCache(std::string const& directory, size_t max_size);
+
+	/**
+	 * @brief Hash of all inputs that affect placement and routing.
+	 * This includes the topology and weights of the network, mapping-relevant neuron
+	 * properties (number of synapse targets and, if considered, firing rates of spike
+	 * sources), the placement and routing parameters, defects and the build of marocco
+	 * (a hash of the library, in addition to the version determined at configure time).
+	 */
+	static key_type key(
+		BioGraph const& bio_graph,
+		pymarocco::PyMarocco const& pymarocco,
+		resource_manager_t const& mgr,
+		HMF::Coordinate::Wafer const& wafer);
+
+	/**
+	 * @brief Replace results, hardware configuration and statistics with the cached ones.
+	 * @return False if there is no entry for the given key.  Unreadable entries are
+	 *         removed and treated as missing.
+	 */
+	bool load(
+		key_type const& key,
+		results::Marocco& results,
+		sthal::Wafer& hardware,
+		pymarocco::MappingStats& stats);
+
+	/**
+	 * @brief Store placement and routing results of a mapping run.
+	 * An existing entry for the same key is kept.
+	 */
+	void store(
+		key_type const& key,
+		results::Marocco const& results,
+		sthal::Wafer const& hardware,
+		pymarocco::MappingStats const& stats);
+
+	/// Cumulative number of cache hits of all processes using this cache directory.
+	size_t hits() const;
+
+	/// Cumulative number of cache misses of all processes using this cache directory.
+	size_t misses() const;
+
+private:
+	void update_statistics(bool hit);
+
+	/// Remove least recently used entries until the size limit is met.
+	void evict();
+
+	std::string m_directory;
+	size_t m_max_size;
+	size_t m_hits;
+	size_t m_misses;
+}; // MappingCache
+
+} // namespace marocco
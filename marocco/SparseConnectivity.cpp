@@ -0,0 +1,154 @@
+#include "marocco/SparseConnectivity.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace marocco {
+
+SparseConnectivity::SparseConnectivity()
+	: m_num_sources(0),
+	  m_num_targets(0),
+	  m_row_offsets(1, 0),
+	  m_rows(),
+	  m_column_offsets(1, 0),
+	  m_columns()
+{
+}
+
+SparseConnectivity::SparseConnectivity(
+	size_t num_sources,
+	size_t num_targets,
+	std::vector<size_t> row_offsets,
+	std::vector<Entry> rows)
+	: m_num_sources(num_sources),
+	  m_num_targets(num_targets),
+	  m_row_offsets(std::move(row_offsets)),
+	  m_rows(std::move(rows)),
+	  m_column_offsets(),
+	  m_columns()
+{
+	if (m_row_offsets.size() != m_num_sources + 1 || m_row_offsets.front() != 0 ||
+	    m_row_offsets.back() != m_rows.size() ||
+	    !std::is_sorted(m_row_offsets.begin(), m_row_offsets.end())) {
+		throw std::invalid_argument("inconsistent row offsets");
+	}
+	for (size_t src = 0; src < m_num_sources; ++src) {
+		for (size_t ii = m_row_offsets[src]; ii < m_row_offsets[src + 1]; ++ii) {
+			if (m_rows[ii].index >= m_num_targets ||
+			    (ii > m_row_offsets[src] && m_rows[ii - 1].index >= m_rows[ii].index)) {
+				throw std::invalid_argument("invalid target index");
+			}
+		}
+	}
+	build_columns();
+}
+
+void SparseConnectivity::build_columns()
+{
+	// Counting sort of the CSR entries by target.  As rows are visited in order, the
+	// entries of each column end up sorted by source.
+	m_column_offsets.assign(m_num_targets + 1, 0);
+	for (auto const& entry : m_rows) {
+		++m_column_offsets[entry.index + 1];
+	}
+	for (size_t trg = 0; trg < m_num_targets; ++trg) {
+		m_column_offsets[trg + 1] += m_column_offsets[trg];
+	}
+
+	m_columns.resize(m_rows.size());
+	std::vector<size_t> next(m_column_offsets.begin(), m_column_offsets.end() - 1);
+	for (size_t src = 0; src < m_num_sources; ++src) {
+		for (size_t ii = m_row_offsets[src]; ii < m_row_offsets[src + 1]; ++ii) {
+			auto const& entry = m_rows[ii];
+			m_columns[next[entry.index]++] = Entry{src, entry.weight};
+		}
+	}
+}
+
+size_t SparseConnectivity::num_sources() const
+{
+	return m_num_sources;
+}
+
+size_t SparseConnectivity::num_targets() const
+{
+	return m_num_targets;
+}
+
+size_t SparseConnectivity::size() const
+{
+	return m_rows.size();
+}
+
+auto SparseConnectivity::targets(size_t source) const -> iterable<const_iterator>
+{
+	if (source >= m_num_sources) {
+		throw std::out_of_range("source index out of range");
+	}
+	return make_iterable(
+		m_rows.cbegin() + m_row_offsets[source], m_rows.cbegin() + m_row_offsets[source + 1]);
+}
+
+auto SparseConnectivity::sources(size_t target) const -> iterable<const_iterator>
+{
+	if (target >= m_num_targets) {
+		throw std::out_of_range("target index out of range");
+	}
+	return make_iterable(
+		m_columns.cbegin() + m_column_offsets[target],
+		m_columns.cbegin() + m_column_offsets[target + 1]);
+}
+
+size_t SparseConnectivity::position(size_t source, size_t target) const
+{
+	if (source >= m_num_sources || target >= m_num_targets) {
+		return size();
+	}
+	auto const first = m_rows.cbegin() + m_row_offsets[source];
+	auto const last = m_rows.cbegin() + m_row_offsets[source + 1];
+	auto const it = std::lower_bound(first, last, target, [](Entry const& entry, size_t index) {
+		return entry.index < index;
+	});
+	if (it == last || it->index != target) {
+		return size();
+	}
+	return it - m_rows.cbegin();
+}
+
+double SparseConnectivity::weight(size_t source, size_t target) const
+{
+	size_t const pos = position(source, target);
+	if (pos == size()) {
+		throw std::out_of_range("no such synapse");
+	}
+	return m_rows[pos].weight;
+}
+
+bool SparseConnectivity::same_synapses(SparseConnectivity const& other) const
+{
+	return m_num_sources == other.m_num_sources && m_num_targets == other.m_num_targets &&
+	       m_row_offsets == other.m_row_offsets &&
+	       std::equal(
+	           m_rows.cbegin(), m_rows.cend(), other.m_rows.cbegin(),
+	           [](Entry const& lhs, Entry const& rhs) { return lhs.index == rhs.index; });
+}
+
+bool SparseConnectivity::operator==(SparseConnectivity const& other) const
+{
+	return same_synapses(other) &&
+	       std::equal(
+	           m_rows.cbegin(), m_rows.cend(), other.m_rows.cbegin(),
+	           [](Entry const& lhs, Entry const& rhs) { return lhs.weight == rhs.weight; });
+}
+
+bool SparseConnectivity::operator!=(SparseConnectivity const& other) const
+{
+	return !(*this == other);
+}
+
+bool SparseConnectivity::is_synapse(double weight)
+{
+	return !std::isnan(weight) && weight > 0.;
+}
+
+} // namespace marocco
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "marocco/util/iterable.h"
+
+namespace marocco {
+
+/**
+ * @brief Compressed representation of the synapses of a single projection view.
+ * Only entries of the weight matrix which correspond to actual synapses (i.e. weights
+ * which are neither NaN nor zero) are stored, both grouped by source (CSR) and grouped
+ * by target (CSC).  Indices are relative to the pre- and post-synaptic masks of the
+ * projection view, i.e. the same indices that are used to access its weight matrix.
+ */
+class SparseConnectivity
+{
+public:
+	struct Entry
+	{
+		/// Relative index of the target (CSR) or source (CSC) neuron.
+		size_t index;
+		double weight;
+	};
+
+	typedef std::vector<Entry>::const_iterator const_iterator;
+
+	SparseConnectivity();
+
+	/**
+	 * @tparam Matrix Dense matrix type providing \c size1(), \c size2() and element
+	 *         access via \c operator(), e.g. \c Connector::const_matrix_view_type.
+	 */
+	template <typename Matrix>
+	explicit SparseConnectivity(Matrix const& weights);
+
+	/**
+	 * @brief Construct from an existing CSR representation, e.g. one stored alongside
+	 *        mapping results.
+	 * @param row_offsets Offsets into \c rows for each source plus one past the end.
+	 * @param rows Synapses grouped by source and sorted by target index.
+	 * @throw std::invalid_argument If the given representation is inconsistent.
+	 */
+	SparseConnectivity(
+		size_t num_sources,
+		size_t num_targets,
+		std::vector<size_t> row_offsets,
+		std::vector<Entry> rows);
+
+	size_t num_sources() const;
+	size_t num_targets() const;
+
+	/// Number of synapses.
+	size_t size() const;
+
+	/**
+	 * @brief Synapses originating from the given source, sorted by target index.
+	 * @throw std::out_of_range If the index exceeds the number of sources.
+	 */
+	iterable<const_iterator> targets(size_t source) const;
+
+	/**
+	 * @brief Synapses terminating at the given target, sorted by source index.
+	 * @throw std::out_of_range If the index exceeds the number of targets.
+	 */
+	iterable<const_iterator> sources(size_t target) const;
+
+	/**
+	 * @brief Position of the given synapse in row-major (CSR) order, i.e. the order in
+	 *        which synapses are visited by iterating \c targets() for all sources.
+	 * @return Position in the range [0, size()) or \c size() if there is no such synapse.
+	 */
+	size_t position(size_t source, size_t target) const;
+
+	/**
+	 * @brief Weight of the given synapse.
+	 * @throw std::out_of_range If there is no such synapse.
+	 */
+	double weight(size_t source, size_t target) const;
+
+	/// Check whether both contain the same synapses, regardless of their weights.
+	bool same_synapses(SparseConnectivity const& other) const;
+
+	/// Check whether both contain the same synapses with identical weights.
+	bool operator==(SparseConnectivity const& other) const;
+	bool operator!=(SparseConnectivity const& other) const;
+
+	static bool is_synapse(double weight);
+
+private:
+	/// Derive CSC representation from CSR representation.
+	void build_columns();
+
+	size_t m_num_sources;
+	size_t m_num_targets;
+	std::vector<size_t> m_row_offsets;
+	std::vector<Entry> m_rows;
+	std::vector<size_t> m_column_offsets;
+	std::vector<Entry> m_columns;
+}; // SparseConnectivity
+
+template <typename Matrix>
+SparseConnectivity::SparseConnectivity(Matrix const& weights)
+	: m_num_sources(weights.size1()),
+	  m_num_targets(weights.size2()),
+	  m_row_offsets(),
+	  m_rows(),
+	  m_column_offsets(),
+	  m_columns()
+{
+	m_row_offsets.reserve(m_num_sources + 1);
+	m_row_offsets.push_back(0);
+	for (size_t src = 0; src < m_num_sources; ++src) {
+		for (size_t trg = 0; trg < m_num_targets; ++trg) {
+			double const weight = weights(src, trg);
+			if (is_synapse(weight)) {
+				m_rows.push_back(Entry{trg, weight});
+			}
+		}
+		m_row_offsets.push_back(m_rows.size());
+	}
+	build_columns();
+}
+
+} // namespace marocco
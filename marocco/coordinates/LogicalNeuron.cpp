@@ -1,6 +1,7 @@
 #include "marocco/coordinates/LogicalNeuron.h"
 
 #include <bitset>
+#include <limits>
 #include <boost/bind.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/ref.hpp>
@@ -41,7 +42,7 @@ void LogicalNeuron::iterator::increment()
 {
 	// Dereferencing is okay because calling increment on an end iterator has undefined
 	// behavior anyways.
-	auto const& size = m_chunk_iterator->second;
+	auto const size = unpack(*m_chunk_iterator).second;
 
 	if (++m_offset >= size) {
 		m_offset = 0;
@@ -51,7 +52,7 @@ void LogicalNeuron::iterator::increment()
 
 auto LogicalNeuron::iterator::dereference() const -> neuron_type
 {
-	auto const& chunk_neuron = m_chunk_iterator->first;
+	auto const chunk_neuron = unpack(*m_chunk_iterator).first;
 	return neuron_on_block_type(X(chunk_neuron.x() + m_offset), Y(chunk_neuron.y()))
 		.toNeuronOnWafer(m_block);
 }
@@ -97,7 +98,7 @@ LogicalNeuron LogicalNeuron::Builder::done()
 	if (m_chunks.empty()) {
 		throw std::invalid_argument("logical neuron needs at least one chunk");
 	}
-	LogicalNeuron ret(m_block, std::move(m_chunks));
+	LogicalNeuron ret(m_block, m_chunks);
 	m_chunks.clear();
 	return ret;
 }
@@ -115,10 +116,18 @@ LogicalNeuron LogicalNeuron::rectangular(neuron_type const& topleft, size_t cons
 	check_neuron_size(size);
 
 	auto const column = topleft.toNeuronOnNeuronBlock().x();
-	return on(topleft.toNeuronBlockOnWafer())
-		.add(NeuronOnNeuronBlock(column, Y(0)), size - size / 2)
-		.add(NeuronOnNeuronBlock(column, Y(1)), size / 2)
-		.done();
+	if (column + size / 2 - 1 > NeuronOnNeuronBlock::x_type::max) {
+		throw std::invalid_argument("neuron dimensions exceed neuron block bounds");
+	}
+
+	// Rectangular neurons are always valid, so we can skip the checks of the builder.
+	LogicalNeuron result;
+	result.m_size = size;
+	result.m_block = topleft.toNeuronBlockOnWafer();
+	result.m_num_chunks = 2;
+	result.m_inline_chunks[0] = pack(std::make_pair(NeuronOnNeuronBlock(column, Y(0)), size / 2));
+	result.m_inline_chunks[1] = pack(std::make_pair(NeuronOnNeuronBlock(column, Y(1)), size / 2));
+	return result;
 }
 
 LogicalNeuron LogicalNeuron::external(
@@ -127,19 +136,35 @@ LogicalNeuron LogicalNeuron::external(
 	return LogicalNeuron(external_identifier, index);
 }
 
-LogicalNeuron::LogicalNeuron() : m_external_identifier(0u), m_external_index(0u)
+LogicalNeuron::LogicalNeuron()
+	: m_external_identifier(0u),
+	  m_external_index(0u),
+	  m_block(),
+	  m_num_chunks(0u),
+	  m_inline_chunks(),
+	  m_chunks()
 {
 }
 
 LogicalNeuron::LogicalNeuron(external_identifier_type const external_identifier, size_t const index)
-	: m_external_identifier(external_identifier), m_external_index(index)
+	: m_external_identifier(external_identifier),
+	  m_external_index(index),
+	  m_block(),
+	  m_num_chunks(0u),
+	  m_inline_chunks(),
+	  m_chunks()
 {
 }
 
-LogicalNeuron::LogicalNeuron(neuron_block_type const& block, container_type&& chunks)
-	: m_external_identifier(0u), m_size(0u), m_block(block), m_chunks(std::move(chunks))
+LogicalNeuron::LogicalNeuron(neuron_block_type const& block, container_type const& chunks)
+	: m_external_identifier(0u),
+	  m_size(0u),
+	  m_block(block),
+	  m_num_chunks(0u),
+	  m_inline_chunks(),
+	  m_chunks()
 {
-	if (m_chunks.empty()) {
+	if (chunks.empty()) {
 		throw std::invalid_argument("neuron has to have at least one chunk");
 	}
 
@@ -151,9 +176,9 @@ LogicalNeuron::LogicalNeuron(neuron_block_type const& block, container_type&& ch
 
 	for (auto yy : iter_all<neuron_on_block_type::y_type>()) {
 		bitset_type current_row;
-		auto it = m_chunks.lower_bound(
+		auto it = chunks.lower_bound(
 			std::make_pair(neuron_on_block_type(X(neuron_on_block_type::x_type::min), yy), 0u));
-		auto end = m_chunks.upper_bound(
+		auto end = chunks.upper_bound(
 			std::make_pair(neuron_on_block_type(X(neuron_on_block_type::x_type::max), yy), 0u));
 
 		for (; it != end; ++it) {
@@ -228,11 +253,63 @@ LogicalNeuron::LogicalNeuron(neuron_block_type const& block, container_type&& ch
 
 		last_row = current_row;
 	}
+
+	assign(chunks);
+}
+
+auto LogicalNeuron::pack(chunk_type const& chunk) -> packed_chunk_type
+{
+	size_t const offset =
+		chunk.first.y() * neuron_on_block_type::x_type::size + chunk.first.x();
+	return packed_chunk_type((offset << size_bits) | chunk.second);
+}
+
+auto LogicalNeuron::unpack(packed_chunk_type const chunk) -> chunk_type
+{
+	size_t const offset = chunk >> size_bits;
+	return std::make_pair(
+		neuron_on_block_type(
+			X(offset % neuron_on_block_type::x_type::size),
+			Y(offset / neuron_on_block_type::x_type::size)),
+		size_t(chunk & ((1u << size_bits) - 1)));
+}
+
+auto LogicalNeuron::chunks() const -> iterable<chunk_iterator>
+{
+	chunk_iterator const first =
+		(m_num_chunks > max_inline_chunks) ? m_chunks.data() : m_inline_chunks.data();
+	return make_iterable(first, first + m_num_chunks);
+}
+
+void LogicalNeuron::assign(container_type const& chunks)
+{
+	static_assert(
+		neuron_on_block_type::x_type::size < (1u << size_bits),
+		"chunk size does not fit into packed representation");
+	static_assert(
+		neuron_on_block_type::enum_type::size << size_bits <=
+			std::numeric_limits<packed_chunk_type>::max() + size_t(1),
+		"chunk offset does not fit into packed representation");
+
+	m_num_chunks = chunks.size();
+	m_chunks.clear();
+	if (chunks.size() > max_inline_chunks) {
+		m_chunks.reserve(chunks.size());
+		for (auto const& chunk : chunks) {
+			m_chunks.push_back(pack(chunk));
+		}
+		return;
+	}
+
+	auto it = m_inline_chunks.begin();
+	for (auto const& chunk : chunks) {
+		*it++ = pack(chunk);
+	}
 }
 
 bool LogicalNeuron::is_external() const
 {
-	return m_chunks.empty();
+	return m_num_chunks == 0;
 }
 
 auto LogicalNeuron::external_identifier() const -> external_identifier_type
@@ -269,7 +346,8 @@ auto LogicalNeuron::denmem(size_t const index) const -> neuron_type
 	}
 
 	size_t seen = 0u;
-	for (auto const& chunk : m_chunks) {
+	for (auto const packed : chunks()) {
+		auto const chunk = unpack(packed);
 		size_t const relative = index - seen;
 		if (relative < chunk.second) {
 			return neuron_on_block_type(X(chunk.first.x() + relative), Y(chunk.first.y()))
@@ -283,12 +361,12 @@ auto LogicalNeuron::denmem(size_t const index) const -> neuron_type
 
 auto LogicalNeuron::begin() const -> iterator
 {
-	return {m_block, m_chunks.begin()};
+	return {m_block, chunks().begin()};
 }
 
 auto LogicalNeuron::end() const -> iterator
 {
-	return {m_block, m_chunks.end()};
+	return {m_block, chunks().end()};
 }
 
 auto LogicalNeuron::front() const -> neuron_type
@@ -297,7 +375,7 @@ auto LogicalNeuron::front() const -> neuron_type
 		throw std::runtime_error("external neuron does not have denmems");
 	}
 
-	return m_chunks.begin()->first.toNeuronOnWafer(m_block);
+	return unpack(*chunks().begin()).first.toNeuronOnWafer(m_block);
 }
 
 auto LogicalNeuron::back() const -> neuron_type
@@ -306,7 +384,7 @@ auto LogicalNeuron::back() const -> neuron_type
 		throw std::runtime_error("external neuron does not have denmems");
 	}
 
-	auto const& chunk = *m_chunks.rbegin();
+	auto const chunk = unpack(*std::prev(chunks().end()));
 	return neuron_on_block_type(X(chunk.first.x() + chunk.second - 1), Y(chunk.first.y()))
 		.toNeuronOnWafer(m_block);
 }
@@ -317,16 +395,16 @@ bool LogicalNeuron::is_rectangular() const
 		throw std::runtime_error("external neuron does not have denmems");
 	}
 
-	if (m_chunks.size() > neuron_on_block_type::y_type::size) {
+	if (m_num_chunks > neuron_on_block_type::y_type::size) {
 		return false;
 	}
 
-	auto it = m_chunks.begin();
-	auto next = std::next(it);
-
-	for (auto end = m_chunks.end(); next != end; ++it, ++next) {
-		if (next->first.x() != it->first.x() || next->first.y() <= it->first.y() ||
-		    next->second != it->second) {
+	auto const range = chunks();
+	for (auto it = range.begin(), next = std::next(it); next != range.end(); ++it, ++next) {
+		auto const current = unpack(*it);
+		auto const following = unpack(*next);
+		if (following.first.x() != current.first.x() ||
+		    following.first.y() <= current.first.y() || following.second != current.second) {
 			return false;
 		}
 	}
@@ -344,25 +422,28 @@ bool LogicalNeuron::shares_denmems_with(LogicalNeuron const& other) const
 		return false;
 	}
 
-	auto a_it = m_chunks.begin();
-	auto b_it = other.m_chunks.begin();
-	auto const a_eit = m_chunks.end();
-	auto const b_eit = other.m_chunks.end();
+	auto a_it = chunks().begin();
+	auto b_it = other.chunks().begin();
+	auto const a_eit = chunks().end();
+	auto const b_eit = other.chunks().end();
 
 	while (a_it != a_eit && b_it != b_eit) {
-		auto const& a_nrn = a_it->first;
-		auto const& b_nrn = b_it->first;
+		auto const a_chunk = unpack(*a_it);
+		auto const b_chunk = unpack(*b_it);
+		auto const& a_nrn = a_chunk.first;
+		auto const& b_nrn = b_chunk.first;
 
 		if (a_nrn.y() == b_nrn.y()) {
 			auto* left = &a_it;
-			auto const* right = &b_it;
+			auto const* left_chunk = &a_chunk;
+			auto const* right_chunk = &b_chunk;
 
 			if (a_nrn.x() > b_nrn.x()) {
 				left = &b_it;
-				right = &a_it;
+				std::swap(left_chunk, right_chunk);
 			}
 
-			if (((*right)->first.x() - (*left)->first.x()) >= (*left)->second) {
+			if ((right_chunk->first.x() - left_chunk->first.x()) >= left_chunk->second) {
 				// right chunk has no overlap with left chunk.
 				++(*left);
 				continue;
@@ -385,12 +466,10 @@ size_t LogicalNeuron::hash() const
 	boost::hash_combine(hash, m_external_identifier);
 	boost::hash_combine(hash, m_size);
 	boost::hash_combine(hash, m_block);
-	boost::hash_combine(hash, m_chunks.size());
+	boost::hash_combine(hash, m_num_chunks);
 	// This is just a hash, so we don't bother looping over all chunks.
-	if (!m_chunks.empty()) {
-		chunk_type const& chunk = *(m_chunks.begin());
-		boost::hash_combine(hash, chunk.first);
-		boost::hash_combine(hash, chunk.second);
+	if (m_num_chunks > 0) {
+		boost::hash_combine(hash, *chunks().begin());
 	}
 	return hash;
 }
@@ -405,8 +484,8 @@ bool operator==(LogicalNeuron const& lhs, LogicalNeuron const& rhs)
 	return (
 	    lhs.m_external_identifier == rhs.m_external_identifier &&
 	    lhs.m_size == rhs.m_size && lhs.m_block == rhs.m_block &&
-	    lhs.m_chunks.size() == rhs.m_chunks.size() &&
-	    std::equal(lhs.m_chunks.begin(), lhs.m_chunks.end(), rhs.m_chunks.begin()));
+	    lhs.m_num_chunks == rhs.m_num_chunks &&
+	    std::equal(lhs.chunks().begin(), lhs.chunks().end(), rhs.chunks().begin()));
 }
 
 size_t hash_value(LogicalNeuron const& nrn)
@@ -418,12 +497,22 @@ template <typename Archiver>
 void LogicalNeuron::serialize(Archiver& ar, const unsigned int /* version */)
 {
 	using namespace boost::serialization;
+	// Chunks are serialized in unpacked form to stay compatible with existing results.
+	container_type chunks;
+	if (!Archiver::is_loading::value) {
+		for (auto const packed : this->chunks()) {
+			chunks.insert(unpack(packed));
+		}
+	}
 	// clang-format off
 	ar & make_nvp("external_index", m_external_identifier)
 	   & make_nvp("size_or_identifier", m_size)
 	   & make_nvp("block", m_block)
-	   & make_nvp("chunks", m_chunks);
+	   & make_nvp("chunks", chunks);
 	// clang-format on
+	if (Archiver::is_loading::value) {
+		assign(chunks);
+	}
 }
 
 } // namespace marocco
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <set>
 #include <utility>
+#include <vector>
 #include <boost/function.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/operators.hpp>
@@ -37,6 +40,9 @@ void check_neuron_size(size_t size);
  * identifier.
  * @invariant Denmem chunks are sorted by their offset, non-overlapping, connected and do
  *            not exceed neuron block boundaries.
+ * @note Chunks are stored in packed form.  Up to \c max_inline_chunks chunks (which
+ *       covers rectangular neurons) are stored inline, only irregularly shaped neurons
+ *       need additional heap storage.
  */
 class LogicalNeuron : boost::equality_comparable<LogicalNeuron>
 {
@@ -68,6 +74,16 @@ public:
 
 private:
 	typedef std::set<chunk_type, compare_on_first<chunk_type> > container_type;
+	/**
+	 * @brief Chunk encoded as (offset << size_bits) | size, where the offset enumerates
+	 *        denmems of the neuron block row by row.
+	 * Thus packed chunks compare like their offsets.
+	 */
+	typedef uint16_t packed_chunk_type;
+	typedef packed_chunk_type const* chunk_iterator;
+
+	static size_t const size_bits = 6;
+	static size_t const max_inline_chunks = 4;
 
 public:
 	class iterator : public boost::iterator_facade<iterator,
@@ -77,7 +93,7 @@ public:
 	                                               neuron_type>
 	{
 		typedef size_t offset_type;
-		typedef container_type::const_iterator underlying_iterator;
+		typedef chunk_iterator underlying_iterator;
 
 	public:
 		iterator(neuron_block_type const& block, underlying_iterator const& chunk_iterator);
@@ -238,7 +254,13 @@ public:
 private:
 	LogicalNeuron(external_identifier_type const external_identifier, size_t const index = 0);
 #ifndef PYPLUSPLUS
-	LogicalNeuron(neuron_block_type const& block, container_type&& chunks);
+	LogicalNeuron(neuron_block_type const& block, container_type const& chunks);
+
+	static packed_chunk_type pack(chunk_type const& chunk);
+	static chunk_type unpack(packed_chunk_type chunk);
+
+	iterable<chunk_iterator> chunks() const;
+	void assign(container_type const& chunks);
 #endif // !PYPLUSPLUS
 
 	friend std::ostream&
@@ -255,7 +277,11 @@ private:
 		size_t m_external_index;
 	};
 	neuron_block_type m_block;
-	container_type m_chunks;
+	/// Number of chunks, zero for external neurons.
+	uint8_t m_num_chunks;
+	std::array<packed_chunk_type, max_inline_chunks> m_inline_chunks;
+	/// Only used if there are more than \c max_inline_chunks chunks.
+	std::vector<packed_chunk_type> m_chunks;
 #endif // !PYPLUSPLUS
 
 	friend class boost::serialization::access;
@@ -45,7 +45,8 @@ std::ostream& operator<<(std::ostream& os, pretty_printer<LogicalNeuron> pr)
 	} else {
 		os << "::on(" << pr.what.m_block << ")";
 		std::string space(pr.indent + 2, ' ');
-		for (auto const& chunk : pr.what.m_chunks) {
+		for (auto const packed : pr.what.chunks()) {
+			auto const chunk = LogicalNeuron::unpack(packed);
 			os << "\n" << space << ".add(" << chunk.first << ", " << chunk.second << ")";
 		}
 		os << "\n" << space << ".done()";
@@ -1,5 +1,7 @@
 #include "marocco/experiment/AnalogOutputsConfigurator.h"
 
+#include <set>
+
 #include "hal/Coordinate/iter_all.h"
 
 #include "marocco/Logger.h"
@@ -17,6 +19,23 @@ AnalogOutputsConfigurator::AnalogOutputsConfigurator(
 
 void AnalogOutputsConfigurator::configure(sthal::Wafer& hardware) const
 {
+	// Analog outputs are configured for all allocated HICANNs and for those HICANNs
+	// which are referenced by analog output items.
+	std::set<HICANNOnWafer> hicanns;
+	for (auto const& hc : hardware.getAllocatedHicannCoordinates()) {
+		hicanns.insert(hc);
+	}
+	for (auto const& item : m_analog_outputs) {
+		hicanns.insert(item.hicann());
+	}
+	configure(hardware, std::vector<HICANNOnWafer>(hicanns.begin(), hicanns.end()));
+}
+
+void AnalogOutputsConfigurator::configure(
+	sthal::Wafer& hardware, std::vector<HICANNOnWafer> const& hicanns) const
+{
+	std::set<HICANNOnWafer> const selected(hicanns.begin(), hicanns.end());
+
 	HICANNOnWafer const* last_hicann = nullptr;
 	NeuronOnQuad last_multiplexer_line;
 
@@ -24,8 +43,8 @@ void AnalogOutputsConfigurator::configure(sthal::Wafer& hardware) const
 	// choosing which denmem of a logical neuron to record, as only denmems with different
 	// NeuronOnQuad coordinates can be recorded at the same time.
 
-	// First: disable all analog outputs of all allocated HICANNs
-	for (auto const& hc : hardware.getAllocatedHicannCoordinates()) {
+	// First: disable all analog outputs of all selected HICANNs
+	for (auto const& hc : selected) {
 		hardware[hc].disable_aout();
 		hardware[hc].analog.disable(AnalogOnHICANN(0));
 		hardware[hc].analog.disable(AnalogOnHICANN(1));
@@ -36,6 +55,9 @@ void AnalogOutputsConfigurator::configure(sthal::Wafer& hardware) const
 		auto const& logical_neuron = item.logical_neuron();
 		auto const& analog_output = item.analog_output();
 		auto const& hicann = item.hicann();
+		if (selected.find(hicann) == selected.end()) {
+			continue;
+		}
 
 		auto& chip = hardware[hicann];
 		chip.analog.enable(analog_output);
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <vector>
+
 #include "sthal/Wafer.h"
+#include "hal/Coordinate/HICANN.h"
 
 #include "marocco/parameter/results/AnalogOutputs.h"
 
@@ -13,6 +16,14 @@ public:
 
 	void configure(sthal::Wafer& hardware) const;
 
+	/**
+	 * @brief Only (re)configure analog outputs of the given HICANNs.
+	 * Other HICANNs keep their current configuration.
+	 */
+	void configure(
+		sthal::Wafer& hardware,
+		std::vector<HMF::Coordinate::HICANNOnWafer> const& hicanns) const;
+
 private:
 	parameter::results::AnalogOutputs const& m_analog_outputs;
 }; // AnalogOutputsConfigurator
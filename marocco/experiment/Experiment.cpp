@@ -14,6 +14,7 @@
 #include "sthal/MagicHardwareDatabase.h"
 
 #include "marocco/Logger.h"
+#include "marocco/experiment/MembraneTrace.h"
 #include "marocco/experiment/RecordSpikesVisitor.h"
 
 using namespace HMF::Coordinate;
@@ -129,38 +130,9 @@ bool Experiment::extract_membrane(PopulationPtr population, placement_item_type
 
 	auto const voltages = recorder.trace();
 	auto const times = recorder.getTimestamps();
-
-	auto& trace = population->getMembraneVoltageTrace(item.neuron_index());
-
-	static double const s_to_ms = 1e3;
-	static double const V_to_mV = 1e3;
-	double const shift_v = m_pymarocco.param_trafo.shift_v;
-	double const alpha_v = m_pymarocco.param_trafo.alpha_v;
-	double const offset_in_s = m_parameters.offset_in_s();
-	double const speedup = m_parameters.speedup();
-
-	auto v_it = voltages.begin();
-	auto const v_eit = voltages.end();
-	auto t_it = times.begin();
-	auto const t_eit = voltages.end();
-
-	trace.reserve(times.size());
-	if (m_parameters.truncate_membrane_traces()) {
-		float const exp_duration_in_ms = m_parameters.bio_duration_in_s() * s_to_ms;
-		for (; v_it != v_eit && t_it != t_eit; ++v_it, ++t_it) {
-			float time = (*t_it - offset_in_s) * speedup * s_to_ms;
-			if (time < 0 || time > exp_duration_in_ms) {
-				continue;
-			}
-			trace.push_back(std::make_pair(time, (*v_it - shift_v) * V_to_mV / alpha_v));
-		}
-	} else {
-		for (; v_it != v_eit && t_it != t_eit; ++v_it, ++t_it) {
-			trace.push_back(
-				std::make_pair(
-					(*t_it - offset_in_s) * speedup * s_to_ms, (*v_it - shift_v) * V_to_mV / alpha_v));
-		}
-	}
+	append_membrane_trace(
+		times, voltages, m_parameters, m_pymarocco.param_trafo,
+		population->getMembraneVoltageTrace(item.neuron_index()));
 
 	return true;
 }
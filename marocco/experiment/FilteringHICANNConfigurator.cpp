@@ -0,0 +1,49 @@
+#include "marocco/experiment/FilteringHICANNConfigurator.h"
+
+#include <stdexcept>
+
+#include "marocco/Logger.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace experiment {
+
+FilteringHICANNConfigurator::FilteringHICANNConfigurator(
+	sthal::HICANNConfigurator& configurator, hicanns_type hicanns)
+	: m_configurator(configurator), m_hicanns(std::move(hicanns))
+{
+}
+
+void FilteringHICANNConfigurator::config_fpga(fpga_handle_t const& f, fpga_t const& fg)
+{
+	m_configurator.config_fpga(f, fg);
+}
+
+void FilteringHICANNConfigurator::config(
+	fpga_handle_t const& f, hicann_handles_t const& handles, hicann_datas_t const& hicanns)
+{
+	if (handles.size() != hicanns.size()) {
+		throw std::invalid_argument("number of HICANN handles and configurations differ");
+	}
+
+	hicann_handles_t filtered_handles;
+	hicann_datas_t filtered_hicanns;
+	for (size_t ii = 0; ii < handles.size(); ++ii) {
+		if (m_hicanns.count(handles[ii]->coordinate().toHICANNOnWafer())) {
+			filtered_handles.push_back(handles[ii]);
+			filtered_hicanns.push_back(hicanns[ii]);
+		}
+	}
+
+	MAROCCO_DEBUG(
+		"Configuring " << filtered_handles.size() << " of " << handles.size()
+		<< " HICANN(s), others keep their configuration");
+
+	if (!filtered_handles.empty()) {
+		m_configurator.config(f, filtered_handles, filtered_hicanns);
+	}
+}
+
+} // namespace experiment
+} // namespace marocco
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <set>
+
+#include "hal/Coordinate/HICANN.h"
+#include "sthal/HICANNConfigurator.h"
+
+namespace marocco {
+namespace experiment {
+
+/**
+ * @brief Only configures the given HICANNs, using another configurator.
+ * FPGAs are configured as usual.  HICANNs that are not given keep their current
+ * configuration, e.g. when only few chips changed since the last run of an experiment,
+ * see \c IncrementalMapping::changed_hicanns().
+ * @note This is only useful with configurators that do not reset the chips.
+ */
+class FilteringHICANNConfigurator : public sthal::HICANNConfigurator
+{
+public:
+	typedef std::set<HMF::Coordinate::HICANNOnWafer> hicanns_type;
+
+	/// @note The given configurator has to outlive this object.
+	FilteringHICANNConfigurator(sthal::HICANNConfigurator& configurator, hicanns_type hicanns);
+
+	void config_fpga(fpga_handle_t const& f, fpga_t const& fg) override;
+
+	void config(
+		fpga_handle_t const& f,
+		hicann_handles_t const& handles,
+		hicann_datas_t const& hicanns) override;
+
+private:
+	sthal::HICANNConfigurator& m_configurator;
+	hicanns_type m_hicanns;
+}; // FilteringHICANNConfigurator
+
+} // namespace experiment
+} // namespace marocco
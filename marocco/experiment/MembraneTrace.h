@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include "marocco/experiment/parameters/Experiment.h"
+#include "pymarocco/ParamTrafo.h"
+
+namespace marocco {
+namespace experiment {
+
+/**
+ * @brief Convert recorded membrane samples to biological time and voltage and append
+ *        them to the given trace.
+ * Only the first \c min(times.size(), voltages.size()) samples are used.  If enabled via
+ * \c parameters::Experiment::truncate_membrane_traces(), samples outside of the
+ * experiment, i.e. before its start or after its duration, are dropped.  Samples at the
+ * boundaries are kept.
+ * @pre Timestamps are sorted.
+ * @return Number of appended samples.
+ */
+template <typename Times, typename Voltages, typename Trace>
+size_t append_membrane_trace(
+	Times const& times,
+	Voltages const& voltages,
+	parameters::Experiment const& parameters,
+	pymarocco::ParamTrafo const& param_trafo,
+	Trace& trace)
+{
+	static double const s_to_ms = 1e3;
+	static double const V_to_mV = 1e3;
+	double const shift_v = param_trafo.shift_v;
+	double const alpha_v = param_trafo.alpha_v;
+	double const offset_in_s = parameters.offset_in_s();
+	double const speedup = parameters.speedup();
+
+	auto const to_bio_time = [=](double time) -> float {
+		return (time - offset_in_s) * speedup * s_to_ms;
+	};
+	auto const to_bio_voltage = [=](double voltage) -> float {
+		return (voltage - shift_v) * V_to_mV / alpha_v;
+	};
+
+	size_t const num_samples = std::min<size_t>(voltages.size(), times.size());
+	size_t first = 0;
+	size_t last = num_samples;
+	if (parameters.truncate_membrane_traces()) {
+		// As timestamps are sorted, samples within the experiment are contiguous.
+		float const exp_duration_in_ms = parameters.bio_duration_in_s() * s_to_ms;
+		auto const begin = times.begin();
+		auto const end = begin + num_samples;
+		auto const lower = std::partition_point(
+			begin, end, [&](double time) { return to_bio_time(time) < 0; });
+		auto const upper = std::partition_point(lower, end, [&](double time) {
+			return to_bio_time(time) <= exp_duration_in_ms;
+		});
+		first = lower - begin;
+		last = upper - begin;
+	}
+
+	// Convert samples in place of the (resized) trace, chunks are processed in parallel.
+	size_t const offset = trace.size();
+	trace.resize(offset + last - first);
+	tbb::parallel_for(
+		tbb::blocked_range<size_t>(first, last, 4096),
+		[&](tbb::blocked_range<size_t> const& range) {
+			for (size_t ii = range.begin(); ii != range.end(); ++ii) {
+				trace[offset + ii - first] =
+					std::make_pair(to_bio_time(times[ii]), to_bio_voltage(voltages[ii]));
+			}
+		});
+
+	return last - first;
+}
+
+} // namespace experiment
+} // namespace marocco
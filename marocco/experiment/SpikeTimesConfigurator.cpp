@@ -1,14 +1,28 @@
 #include "marocco/experiment/SpikeTimesConfigurator.h"
 
+#include <tbb/parallel_for.h>
+
 #include "hal/Coordinate/iter_all.h"
 
 #include "marocco/Logger.h"
+#include "marocco/experiment/SpikeTrains.h"
 
 using namespace HMF::Coordinate;
 
 namespace marocco {
 namespace experiment {
 
+namespace {
+
+struct Link
+{
+	HICANNOnWafer hicann;
+	DNCMergerOnHICANN dnc_merger;
+	std::vector<SpikeTrain> trains;
+};
+
+} // namespace
+
 SpikeTimesConfigurator::SpikeTimesConfigurator(
 	placement::results::Placement const& placement,
 	parameter::results::SpikeTimes const& spike_times,
@@ -21,39 +35,63 @@ SpikeTimesConfigurator::SpikeTimesConfigurator(
 
 void SpikeTimesConfigurator::configure(sthal::Wafer& hardware, HICANNOnWafer const& hicann) const
 {
-	static double const ms_to_s = 1e-3;
-	double const speedup = m_experiment_parameters.speedup();
-	double const offset_in_s = m_experiment_parameters.offset_in_s();
-	double const bio_duration_in_ms = m_experiment_parameters.bio_duration_in_s() / ms_to_s;
-
-	for (auto const dnc_merger : iter_all<DNCMergerOnHICANN>()) {
-		std::vector<sthal::Spike> transformed_spikes;
-		for (auto const& item : m_placement.find(DNCMergerOnWafer(dnc_merger, hicann))) {
-			if (!item.logical_neuron().is_external()) {
-				continue;
-			}
-
-			auto const& address = item.address();
-			assert(address != boost::none);
-			auto const& l1_address = address->toL1Address();
+	configure(hardware, std::vector<HICANNOnWafer>{hicann});
+}
 
-			auto const& spikes = m_spike_times.get(item.bio_neuron());
-			transformed_spikes.reserve(transformed_spikes.size() + spikes.size());
-			for (auto const& bio_time_in_ms : spikes) {
-				if (bio_time_in_ms > bio_duration_in_ms) {
+void SpikeTimesConfigurator::configure(
+	sthal::Wafer& hardware, std::vector<HICANNOnWafer> const& hicanns) const
+{
+	// Collect spike trains per link, spikes after the end of the experiment are dropped.
+	std::vector<Link> links;
+	std::vector<size_t> sizes;
+	for (auto const& hicann : hicanns) {
+		for (auto const dnc_merger : iter_all<DNCMergerOnHICANN>()) {
+			Link link{hicann, dnc_merger, {}};
+			size_t size = 0;
+			for (auto const& item : m_placement.find(DNCMergerOnWafer(dnc_merger, hicann))) {
+				if (!item.logical_neuron().is_external()) {
 					continue;
 				}
-				transformed_spikes.emplace_back(
-					l1_address, offset_in_s + bio_time_in_ms * ms_to_s / speedup);
+
+				auto const& address = item.address();
+				assert(address != boost::none);
+
+				auto const train = make_spike_train(
+					address->toL1Address(), m_spike_times.get(item.bio_neuron()),
+					m_experiment_parameters);
+				if (train.size() != 0) {
+					link.trains.push_back(train);
+					size += train.size();
+				}
+			}
+			if (size != 0) {
+				links.push_back(std::move(link));
+				sizes.push_back(size);
 			}
 		}
+	}
+
+	size_t const max_buffered_spikes = experiment::max_buffered_spikes(m_experiment_parameters);
+	std::vector<std::vector<sthal::Spike> > buffers;
+	for (size_t first = 0; first < links.size();) {
+		size_t const last = end_of_batch(sizes, first, max_buffered_spikes);
+
+		buffers.resize(last - first);
+		tbb::parallel_for(first, last, [&](size_t const ii) {
+			merge_spike_trains(links[ii].trains, m_experiment_parameters, buffers[ii - first]);
+		});
 
-		if (!transformed_spikes.empty()) {
+		// Access to the hardware configuration is not thread-safe.
+		for (size_t ii = first; ii < last; ++ii) {
+			auto const& link = links[ii];
+			auto& buffer = buffers[ii - first];
 			MAROCCO_DEBUG(
-			    "Sending " << transformed_spikes.size() << " spikes to " << hicann << " via "
-			    << dnc_merger);
-			hardware[hicann].sendSpikes(GbitLinkOnHICANN(dnc_merger), transformed_spikes);
+			    "Sending " << buffer.size() << " spikes to " << link.hicann << " via "
+			    << link.dnc_merger);
+			hardware[link.hicann].sendSpikes(GbitLinkOnHICANN(link.dnc_merger), buffer);
+			std::vector<sthal::Spike>().swap(buffer);
 		}
+		first = last;
 	}
 }
 
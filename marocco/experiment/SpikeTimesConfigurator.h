@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "sthal/Wafer.h"
 #include "hal/Coordinate/HICANN.h"
 
@@ -10,6 +12,12 @@
 namespace marocco {
 namespace experiment {
 
+/**
+ * @brief Uploads the spike trains of external neurons to sthal.
+ * The (sorted) spike trains of all neurons sharing a DNC merger are merged into a single
+ * sorted stream per link.  Streams of different links are merged in parallel and handed
+ * to sthal in batches, see \c parameters::Experiment::max_buffered_spikes().
+ */
 class SpikeTimesConfigurator {
 public:
 	SpikeTimesConfigurator(
@@ -19,6 +27,10 @@ public:
 
 	void configure(sthal::Wafer& hardware, HMF::Coordinate::HICANNOnWafer const& hicann) const;
 
+	void configure(
+		sthal::Wafer& hardware,
+		std::vector<HMF::Coordinate::HICANNOnWafer> const& hicanns) const;
+
 private:
 	placement::results::Placement const& m_placement;
 	parameter::results::SpikeTimes const& m_spike_times;
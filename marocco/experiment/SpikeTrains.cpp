@@ -0,0 +1,95 @@
+#include "marocco/experiment/SpikeTrains.h"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <tbb/task_scheduler_init.h>
+
+namespace marocco {
+namespace experiment {
+
+size_t SpikeTrain::size() const
+{
+	return end - begin;
+}
+
+SpikeTrain make_spike_train(
+	HMF::HICANN::L1Address const& address,
+	parameter::results::SpikeTimes::spikes_type const& spikes,
+	parameters::Experiment const& parameters)
+{
+	static double const s_to_ms = 1e3;
+	double const bio_duration_in_ms = parameters.bio_duration_in_s() * s_to_ms;
+	return SpikeTrain{
+		address, spikes.begin(),
+		std::upper_bound(spikes.begin(), spikes.end(), bio_duration_in_ms)};
+}
+
+void merge_spike_trains(
+	std::vector<SpikeTrain> const& trains,
+	parameters::Experiment const& parameters,
+	std::vector<sthal::Spike>& result)
+{
+	static double const ms_to_s = 1e-3;
+	double const offset_in_s = parameters.offset_in_s();
+	double const speedup = parameters.speedup();
+
+	// Heads of all non-empty trains, ordered by time and then by index of the train.
+	typedef std::pair<double, size_t> head_type;
+	std::priority_queue<head_type, std::vector<head_type>, std::greater<head_type> > heads;
+	std::vector<SpikeTrain::iterator> positions;
+	positions.reserve(trains.size());
+	size_t size = 0;
+	for (size_t ii = 0; ii < trains.size(); ++ii) {
+		positions.push_back(trains[ii].begin);
+		if (trains[ii].begin != trains[ii].end) {
+			heads.emplace(*trains[ii].begin, ii);
+		}
+		size += trains[ii].size();
+	}
+
+	result.clear();
+	result.reserve(size);
+	while (!heads.empty()) {
+		auto const head = heads.top();
+		heads.pop();
+		auto const& train = trains[head.second];
+		result.emplace_back(train.address, offset_in_s + head.first * ms_to_s / speedup);
+		if (++positions[head.second] != train.end) {
+			heads.emplace(*positions[head.second], head.second);
+		}
+	}
+}
+
+size_t max_buffered_spikes(parameters::Experiment const& parameters)
+{
+	if (size_t const max = parameters.max_buffered_spikes()) {
+		return max;
+	}
+
+	// Assumed number of spikes per link, i.e. 1 MiB of sthal::Spike for each.
+	static size_t const typical_link_size = 1 << 16;
+	static size_t const links_per_thread = 2;
+	return links_per_thread * typical_link_size *
+	       size_t(std::max(1, tbb::task_scheduler_init::default_num_threads()));
+}
+
+size_t end_of_batch(std::vector<size_t> const& sizes, size_t first, size_t max_buffered_spikes)
+{
+	if (first >= sizes.size()) {
+		return sizes.size();
+	}
+
+	size_t last = first + 1;
+	for (size_t buffered = sizes[first]; last < sizes.size(); ++last) {
+		buffered += sizes[last];
+		if (buffered > max_buffered_spikes) {
+			break;
+		}
+	}
+	return last;
+}
+
+} // namespace experiment
+} // namespace marocco
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+
+#include "hal/HICANN/L1Address.h"
+#include "sthal/Spike.h"
+
+#include "marocco/experiment/parameters/Experiment.h"
+#include "marocco/parameter/results/SpikeTimes.h"
+
+namespace marocco {
+namespace experiment {
+
+/// Sorted spike train of a single external neuron, spike times are given in ms.
+struct SpikeTrain
+{
+	typedef parameter::results::SpikeTimes::spikes_type::const_iterator iterator;
+
+	HMF::HICANN::L1Address address;
+	iterator begin;
+	iterator end;
+
+	size_t size() const;
+}; // SpikeTrain
+
+/**
+ * @brief Spike train of the given spikes, restricted to spikes before or at the end of
+ *        the experiment.
+ * @pre Spikes are sorted.
+ */
+SpikeTrain make_spike_train(
+	HMF::HICANN::L1Address const& address,
+	parameter::results::SpikeTimes::spikes_type const& spikes,
+	parameters::Experiment const& parameters);
+
+/**
+ * @brief Merge sorted spike trains into a single stream sorted by time and convert the
+ *        spike times to hardware time.
+ * Spikes with equal times are ordered by the index of their spike train.
+ * @param result Is replaced by the merged stream.
+ */
+void merge_spike_trains(
+	std::vector<SpikeTrain> const& trains,
+	parameters::Experiment const& parameters,
+	std::vector<sthal::Spike>& result);
+
+/**
+ * @brief Maximum number of spikes to buffer, see
+ *        \c parameters::Experiment::max_buffered_spikes().
+ * If no limit was specified, the default is chosen s.t. all worker threads can merge
+ * links of typical size in parallel.
+ */
+size_t max_buffered_spikes(parameters::Experiment const& parameters);
+
+/**
+ * @brief Determine the end of the batch of streams starting at \c first, s.t. at most
+ *        \c max_buffered_spikes spikes are buffered.
+ * At least one stream is contained in a batch, even if it exceeds the limit.
+ * @param sizes Number of spikes of all streams.
+ * @return Index one past the last stream of the batch.
+ */
+size_t end_of_batch(std::vector<size_t> const& sizes, size_t first, size_t max_buffered_spikes);
+
+} // namespace experiment
+} // namespace marocco
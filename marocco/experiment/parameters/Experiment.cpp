@@ -13,7 +13,8 @@ Experiment::Experiment()
 	  m_offset_in_s(20e-6),
 	  m_truncate_membrane_traces(true),
 	  m_truncate_spike_times(true),
-	  m_discard_background_events(true)
+	  m_discard_background_events(true),
+	  m_max_buffered_spikes(0)
 {
 }
 
@@ -91,8 +92,18 @@ bool Experiment::discard_background_events() const
 	return m_discard_background_events;
 }
 
+void Experiment::max_buffered_spikes(size_t spikes)
+{
+	m_max_buffered_spikes = spikes;
+}
+
+size_t Experiment::max_buffered_spikes() const
+{
+	return m_max_buffered_spikes;
+}
+
 template <typename Archive>
-void Experiment::serialize(Archive& ar, unsigned int const /* version */)
+void Experiment::serialize(Archive& ar, unsigned int const version)
 {
 	using namespace boost::serialization;
 	// clang-format off
@@ -103,6 +114,11 @@ void Experiment::serialize(Archive& ar, unsigned int const /* version */)
 	   & make_nvp("truncate_spike_times", m_truncate_spike_times)
 	   & make_nvp("discard_background_events", m_discard_background_events);
 	// clang-format on
+	if (version > 0) {
+		ar & make_nvp("max_buffered_spikes", m_max_buffered_spikes);
+	} else if (Archive::is_loading::value) {
+		m_max_buffered_spikes = 0;
+	}
 }
 
 } // namespace parameters
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 
 #include "pywrap/compat/macros.hpp"
 
@@ -68,6 +70,17 @@ public:
 	void discard_background_events(bool enable);
 	bool discard_background_events() const;
 
+	/**
+	 * @brief Maximum number of external spikes to merge before handing them to sthal.
+	 * Spike streams of several links are merged in parallel and buffered until they are
+	 * uploaded.  Limiting the number of buffered spikes bounds the additional memory
+	 * needed for very long experiments, at least one link is processed at a time.
+	 * A value of zero (the default) selects a limit based on the number of worker
+	 * threads, pass \c std::numeric_limits<size_t>::max() to disable the limit.
+	 */
+	void max_buffered_spikes(size_t spikes);
+	size_t max_buffered_spikes() const;
+
 private:
 	double m_bio_duration_in_s;
 	double m_speedup;
@@ -75,10 +88,11 @@ private:
 	bool m_truncate_membrane_traces;
 	bool m_truncate_spike_times;
 	bool m_discard_background_events;
+	size_t m_max_buffered_spikes;
 
 	friend class boost::serialization::access;
 	template <typename Archive>
-	void serialize(Archive& ar, unsigned int const /* version */);
+	void serialize(Archive& ar, unsigned int const version);
 }; // Experiment
 
 } // namespace parameters
@@ -86,3 +100,4 @@ private:
 } // namespace marocco
 
 BOOST_CLASS_EXPORT_KEY(::marocco::experiment::parameters::Experiment)
+BOOST_CLASS_VERSION(::marocco::experiment::parameters::Experiment, 1)
@@ -1,10 +1,15 @@
 #include "marocco/mapping.h"
 
+#include <chrono>
 #include <cstdlib>
+#include <map>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 #include <boost/filesystem.hpp>
 #include <boost/make_shared.hpp>
+#include <tbb/parallel_for.h>
 
 #include "redman/backend/Backend.h"
 #include "redman/backend/Library.h"
@@ -25,12 +30,17 @@
 #include "sthal/VerifyConfigurator.h"
 #include "sthal/MagicHardwareDatabase.h"
 
+#include "marocco/IncrementalMapping.h"
 #include "marocco/Logger.h"
 #include "marocco/Mapper.h"
 #include "marocco/experiment/AnalogOutputsConfigurator.h"
 #include "marocco/experiment/Experiment.h"
+#include "marocco/experiment/FilteringHICANNConfigurator.h"
 #include "marocco/experiment/SpikeTimesConfigurator.h"
 #include "marocco/experiment/ReadRepeaterTestdata.h"
+#include "marocco/placement/WaferPartitioning.h"
+#include "marocco/util/stage_timer.h"
+#include "marocco/util/trace.h"
 #include "pymarocco/PyMarocco.h"
 #include "pymarocco/runtime/Runtime.h"
 
@@ -67,6 +77,62 @@ boost::shared_ptr<redman::backend::Backend> load_redman_backend(pymarocco::Defec
 	throw std::runtime_error("defects backend not implemented");
 }
 
+void inject_defects(
+	marocco::resource_manager_t& resources, Wafer const& wafer, pymarocco::Defects const& defects)
+{
+	auto res = redman::resources::WaferWithBackend(resources.backend(), wafer);
+	auto const hicanns = res.hicanns();
+
+	for (auto it = hicanns->begin_disabled(); it != hicanns->end_disabled(); ++it) {
+		LOG4CXX_TRACE(log4cxx::Logger::getLogger("marocco"), "Marked " << *it << " as defect/disabled");
+	}
+
+	size_t const n_marked_hicanns =
+	    std::distance(hicanns->begin_disabled(), hicanns->end_disabled());
+	if (n_marked_hicanns != 0) {
+		LOG4CXX_DEBUG(log4cxx::Logger::getLogger("marocco"),
+		              "Marked " << n_marked_hicanns
+		                        << " HICANN(s) as defect/disabled");
+	}
+
+	size_t n_manually_marked_hicanns = 0;
+	for (auto const& pair : defects.hicanns()) {
+		if (pair.first.toWafer() != wafer) {
+			continue;
+		}
+		if (!pair.second) {
+			LOG4CXX_TRACE(log4cxx::Logger::getLogger("marocco"),
+			              "Marked " << pair.first << " manually as defect/disabled");
+			hicanns->disable(pair.first.toHICANNOnWafer(), true);
+			++n_manually_marked_hicanns;
+		} else {
+			res.inject(pair.first.toHICANNOnWafer(), pair.second);
+		}
+	}
+	if (n_manually_marked_hicanns != 0) {
+		LOG4CXX_DEBUG(log4cxx::Logger::getLogger("marocco"),
+		              "Marked " << n_manually_marked_hicanns
+		                        << " HICANN(s) manually as defect/disabled");
+	}
+
+	resources.inject(res);
+}
+
+/**
+ * @brief Insert wafer id in front of the extension(s) of the given filename,
+ *        e.g. "results.xml.gz" becomes "results_wafer33.xml.gz".
+ */
+std::string with_wafer_suffix(std::string const& filename, Wafer const& wafer)
+{
+	namespace bfs = boost::filesystem;
+	bfs::path const path(filename);
+	std::string name = path.filename().native();
+	std::string const suffix = "_wafer" + std::to_string(wafer.value());
+	auto const pos = name.find('.', 1);
+	name.insert(pos == std::string::npos ? name.size() : pos, suffix);
+	return (path.parent_path() / name).native();
+}
+
 #ifdef HAVE_ESS
 std::string create_temporary_directory(char const* tpl) {
 	using namespace boost::filesystem;
@@ -93,6 +159,33 @@ struct DeleteRecursivelyOnScopeExit {
 	}
 };
 
+/// Records trace events while in scope, if a trace file is given.
+struct WriteTraceOnScopeExit {
+	explicit WriteTraceOnScopeExit(std::string const& filename_) : filename(filename_)
+	{
+		if (!filename.empty()) {
+			marocco::trace::start();
+		}
+	}
+
+	~WriteTraceOnScopeExit()
+	{
+		if (filename.empty()) {
+			return;
+		}
+
+		log4cxx::LoggerPtr const logger = log4cxx::Logger::getLogger("marocco");
+		try {
+			LOG4CXX_INFO(logger, "Writing trace to " << filename);
+			marocco::trace::write(filename);
+		} catch (std::exception const& err) {
+			LOG4CXX_WARN(logger, err.what());
+		}
+	}
+
+	std::string filename;
+};
+
 } // namespace
 
 namespace marocco {
@@ -111,6 +204,261 @@ std::set<Wafer> wafers_used_in(boost::shared_ptr<ObjectStore> store)
 	return wafers;
 }
 
+namespace {
+
+experiment::parameters::Experiment experiment_parameters(
+	pymarocco::PyMarocco const& mi, ObjectStore const& store)
+{
+	static const double ms_to_s = 1e-3;
+
+	experiment::parameters::Experiment exp_params = mi.experiment;
+	if (exp_params.bio_duration_in_s() != 0.) {
+		LOG4CXX_WARN(
+			log4cxx::Logger::getLogger("marocco"),
+			"Discarded experiment duration set via mapping parameters "
+			"in favor of duration specified via argument to pynn.run()");
+	}
+	exp_params.bio_duration_in_s(store.getDuration() * ms_to_s);
+	return exp_params;
+}
+
+/**
+ * @param incremental If given, only HICANNs whose analog outputs or spike input changed
+ *        since the last run are reconfigured, see \c IncrementalMapping::update_experiment().
+ */
+IncrementalMapping::ExperimentChanges configure_analog_outputs_and_spike_input(
+	sthal::Wafer& hardware,
+	results::Marocco const& results,
+	experiment::parameters::Experiment const& exp_params,
+	IncrementalMapping* incremental = nullptr)
+{
+	log4cxx::LoggerPtr const logger = log4cxx::Logger::getLogger("marocco");
+
+	IncrementalMapping::ExperimentChanges changes;
+	changes.all = true;
+	if (incremental) {
+		changes = incremental->update_experiment(results, exp_params);
+		if (!changes.all) {
+			LOG4CXX_INFO(
+				logger, "Reconfiguring analog outputs of " << changes.analog_outputs.size()
+				<< " and spike input of " << changes.spike_input.size() << " HICANN(s)");
+		}
+	}
+
+	// Configure analog outputs.
+	{
+		experiment::AnalogOutputsConfigurator analog_outputs(results.analog_outputs);
+		if (changes.all) {
+			analog_outputs.configure(hardware);
+		} else if (!changes.analog_outputs.empty()) {
+			analog_outputs.configure(
+				hardware, std::vector<HICANNOnWafer>(
+					changes.analog_outputs.begin(), changes.analog_outputs.end()));
+		}
+	}
+
+	// Configure external spike input.
+	// Spikes received during the last run are always discarded.
+	{
+		experiment::SpikeTimesConfigurator spike_times_configurator(
+		    results.placement, results.spike_times, exp_params);
+		if (changes.all) {
+			hardware.clearSpikes();
+			spike_times_configurator.configure(
+				hardware, hardware.getAllocatedHicannCoordinates());
+		} else {
+			hardware.clearSpikes(/*received=*/true, /*send=*/false);
+			std::vector<HICANNOnWafer> const hicanns(
+				changes.spike_input.begin(), changes.spike_input.end());
+			for (auto const& hicann : hicanns) {
+				hardware[hicann].clearSpikes(/*received=*/false, /*send=*/true);
+			}
+			spike_times_configurator.configure(hardware, hicanns);
+		}
+	}
+
+	return changes;
+}
+
+/**
+ * @brief Map a network that spans several wafers.
+ * The network is partitioned across the given wafers first, see \c WaferPartitioning.
+ * As there are no L1 connections between wafers, each part is then mapped independently
+ * (and in parallel) with its own resource manager, hardware configuration and results.
+ * Projections between populations on different wafers are counted as synapse loss.
+ * Results and hardware configurations are stored per wafer, with the wafer id inserted
+ * into the filenames given via \c persist and \c wafer_cfg.
+ */
+MappingResult run_multiple_wafers(
+	boost::shared_ptr<ObjectStore> store,
+	boost::shared_ptr<pymarocco::PyMarocco> mi,
+	std::set<Wafer> const& wafers)
+{
+	using pymarocco::PyMarocco;
+
+	log4cxx::LoggerPtr const logger = log4cxx::Logger::getLogger("marocco");
+
+	if (store->getMetaData<pymarocco::runtime::Runtime>("marocco_runtime")) {
+		throw std::runtime_error("marocco_runtime is only supported for a single wafer");
+	}
+
+	if (mi->skip_mapping) {
+		throw std::runtime_error("skip_mapping is only supported for a single wafer");
+	}
+
+	if (mi->backend != PyMarocco::Backend::None) {
+		throw std::runtime_error(
+			"networks spanning multiple wafers can only be mapped using Backend.None");
+	}
+
+	auto const start = std::chrono::system_clock::now();
+	StageTimer mapping_timer(mi->getStats(), "mapping");
+
+	//  ——— LOAD DEFECT DATA ———————————————————————————————————————————————————
+
+	StageTimer defects_timer(mi->getStats(), "defects");
+
+	auto const backend = load_redman_backend(mi->defects);
+
+	// Rough estimate of the number of bio neurons that can be placed on each wafer.
+	size_t const neurons_per_hicann =
+		HMF::Coordinate::NeuronOnHICANN::enum_type::size /
+		mi->neuron_placement.default_neuron_size();
+
+	std::map<Wafer, std::unique_ptr<resource_manager_t> > resources;
+	std::map<Wafer, size_t> capacities;
+	for (auto const& wafer : wafers) {
+		std::unique_ptr<resource_manager_t> mgr(new resource_manager_t{backend});
+		inject_defects(*mgr, wafer, mi->defects);
+
+		capacities[wafer] = mgr->count_present() * neurons_per_hicann;
+		resources[wafer] = std::move(mgr);
+	}
+
+	defects_timer.stop();
+
+	//  ——— PARTITION NETWORK ——————————————————————————————————————————————————
+
+	StageTimer partitioning_timer(mi->getStats(), "partitioning");
+
+	BioGraph bio_graph;
+	bio_graph.load(*store);
+
+	placement::WaferPartitioning partitioning(bio_graph, capacities);
+	partitioning.run();
+
+	partitioning_timer.stop();
+
+	size_t const lost_between_wafers = partitioning.cut();
+	if (!mi->continue_despite_synapse_loss && lost_between_wafers != 0) {
+		throw std::runtime_error("Synapses lost but synapse loss is not accepted. Set "
+		                         "PyMarocco continue_despite_synapse_loss to true to "
+		                         "continue with loss.");
+	}
+
+	//  ——— RUN MAPPING ————————————————————————————————————————————————————————
+
+	struct WaferMapping
+	{
+		Wafer wafer;
+		boost::shared_ptr<PyMarocco> pymarocco;
+		boost::shared_ptr<sthal::Wafer> hardware;
+		boost::shared_ptr<results::Marocco> results;
+	};
+
+	std::vector<WaferMapping> mappings;
+	for (auto const& wafer : partitioning.wafers()) {
+		WaferMapping mapping;
+		mapping.wafer = wafer;
+		// Each mapper records its statistics in its own copy of the parameters.
+		mapping.pymarocco = boost::make_shared<PyMarocco>(*mi);
+		mapping.pymarocco->getStats().clearStages();
+		mapping.hardware = boost::make_shared<sthal::Wafer>(wafer);
+		mapping.results = boost::make_shared<results::Marocco>();
+		mappings.push_back(mapping);
+	}
+
+	auto const exp_params = experiment_parameters(*mi, *store);
+
+	tbb::parallel_for(size_t(0), mappings.size(), [&](size_t const ii) {
+		auto& mapping = mappings[ii];
+		Wafer const wafer = mapping.wafer;
+
+		LOG4CXX_INFO(logger, "Mapping part of network assigned to " << wafer);
+
+		// Stages of all wafers are accumulated below.
+		StageTimer timer(mapping.pymarocco->getStats(), "mapping/wafers");
+
+		Mapper mapper{*mapping.hardware, *resources.at(wafer), mapping.pymarocco,
+		              mapping.results};
+		mapper.run(*store, [&partitioning, wafer](BioGraph::vertex_descriptor const& v) {
+			return partitioning.is_local(v, wafer);
+		});
+
+		configure_analog_outputs_and_spike_input(
+			*mapping.hardware, *mapping.results, exp_params);
+	});
+
+	//  ——— STORE RESULTS ——————————————————————————————————————————————————————
+
+	auto& stats = mi->getStats();
+	size_t synapses = lost_between_wafers;
+	size_t synapses_set = 0;
+	size_t synapse_loss = lost_between_wafers;
+	size_t synapse_loss_after_l1_routing = 0;
+	size_t neurons = 0;
+	double neuron_usage = 0.;
+	double synapse_usage = 0.;
+
+	for (auto const& mapping : mappings) {
+		auto const& wafer_stats = mapping.pymarocco->getStats();
+		synapses += wafer_stats.getSynapses();
+		synapses_set += wafer_stats.getSynapsesSet();
+		synapse_loss += wafer_stats.getSynapseLoss();
+		synapse_loss_after_l1_routing += wafer_stats.getSynapseLossAfterL1Routing();
+		neurons += wafer_stats.getNumNeurons();
+		neuron_usage += wafer_stats.getNeuronUsage() / mappings.size();
+		synapse_usage += wafer_stats.getSynapseUsage() / mappings.size();
+		stats.addStages(wafer_stats);
+
+		StageTimer persist_timer(stats, "persist");
+
+		if (!mi->wafer_cfg.empty()) {
+			mapping.hardware->dump(
+				with_wafer_suffix(mi->wafer_cfg, mapping.wafer).c_str(), /*overwrite=*/true);
+		}
+
+		if (!mi->persist.empty()) {
+			auto const filename = with_wafer_suffix(mi->persist, mapping.wafer);
+			LOG4CXX_INFO(logger, "Saving results for " << mapping.wafer << " to " << filename);
+			mapping.results->save(filename.c_str(), true);
+		}
+	}
+
+	stats.setSynapses(synapses);
+	stats.setSynapsesSet(synapses_set);
+	stats.setSynapseLoss(synapse_loss);
+	stats.setSynapseLossAfterL1Routing(synapse_loss_after_l1_routing);
+	stats.setNumNeurons(neurons);
+	stats.setNumPopulations(store->populations().size());
+	stats.setNumProjections(store->projections().size());
+	stats.setNeuronUsage(neuron_usage);
+	stats.setSynapseUsage(synapse_usage);
+
+	auto const end = std::chrono::system_clock::now();
+	stats.timeTotal = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
+	mapping_timer.stop();
+
+	LOG4CXX_INFO(logger, stats);
+
+	MappingResult result;
+	result.error = 0;
+	result.store = store;
+	return result;
+}
+
+} // namespace
+
 MappingResult run(boost::shared_ptr<ObjectStore> store) {
 	using pymarocco::PyMarocco;
 
@@ -119,8 +467,11 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 	auto mi = store->getMetaData<PyMarocco>("marocco");
 	auto wafers = wafers_used_in(store);
 
+	char const* const trace_file = std::getenv(trace::environment_variable);
+	WriteTraceOnScopeExit tracing{trace_file ? trace_file : mi->trace_file};
+
 	if (wafers.size() > 1) {
-		throw std::runtime_error("currently only a single wafer is supported.");
+		return run_multiple_wafers(store, mi, wafers);
 	}
 
 	// When marocco lives inside the same process as pyhmf, the user may pass in a wafer
@@ -129,6 +480,8 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 	// Yes, this is heavy frickelei.
 	auto runtime_container = store->getMetaData<pymarocco::runtime::Runtime>("marocco_runtime");
 
+	StageTimer mapping_timer(mi->getStats(), "mapping");
+
 	Wafer wafer;
 	boost::shared_ptr<sthal::Wafer> hardware;
 	boost::shared_ptr<results::Marocco> results;
@@ -157,47 +510,26 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 
 	//  ——— LOAD DEFECT DATA ———————————————————————————————————————————————————
 
+	StageTimer defects_timer(mi->getStats(), "defects");
+
 	resource_manager_t resources{load_redman_backend(mi->defects)};
 
-	{
-		auto res = redman::resources::WaferWithBackend(resources.backend(), wafer);
-		auto const hicanns = res.hicanns();
+	inject_defects(resources, wafer, mi->defects);
 
-		for (auto it = hicanns->begin_disabled(); it != hicanns->end_disabled(); ++it) {
-			LOG4CXX_TRACE(log4cxx::Logger::getLogger("marocco"), "Marked " << *it << " as defect/disabled");
-		}
+	defects_timer.stop();
 
-		size_t const n_marked_hicanns =
-		    std::distance(hicanns->begin_disabled(), hicanns->end_disabled());
-		if (n_marked_hicanns != 0) {
-			LOG4CXX_DEBUG(log4cxx::Logger::getLogger("marocco"),
-			              "Marked " << n_marked_hicanns
-			                        << " HICANN(s) as defect/disabled");
-		}
+	//  ——— RUN MAPPING ————————————————————————————————————————————————————————
 
-		size_t n_manually_marked_hicanns = 0;
-		for (auto const& pair : mi->defects.hicanns()) {
-			if (!pair.second) {
-				LOG4CXX_TRACE(log4cxx::Logger::getLogger("marocco"),
-				              "Marked " << pair.first << " manually as defect/disabled");
-				hicanns->disable(pair.first.toHICANNOnWafer(), true);
-				++n_manually_marked_hicanns;
-			} else {
-				res.inject(pair.first.toHICANNOnWafer(), pair.second);
-			}
-		}
-		if (n_manually_marked_hicanns != 0) {
-			LOG4CXX_DEBUG(log4cxx::Logger::getLogger("marocco"),
-			              "Marked " << n_manually_marked_hicanns
-			                        << " HICANN(s) manually as defect/disabled");
+	boost::shared_ptr<IncrementalMapping> incremental;
+	if (runtime_container) {
+		incremental = runtime_container->incremental_mapping();
+		if (!incremental) {
+			incremental = boost::make_shared<IncrementalMapping>();
+			runtime_container->incremental_mapping(incremental);
 		}
-
-		resources.inject(res);
 	}
 
-	//  ——— RUN MAPPING ————————————————————————————————————————————————————————
-
-	Mapper mapper{*hardware, resources, mi, results};
+	Mapper mapper{*hardware, resources, mi, results, incremental};
 
 	if (mi->skip_mapping) {
 		if (!runtime_container) {
@@ -215,25 +547,19 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 		LOG4CXX_INFO(logger, "Mapping will be skipped");
 	}
 
-	// Even when skip_mapping is true we need to setup the bio graph.
-	// (Alternatively the bio graph could be persisted to the mapping results object, too).
+	// Even when skip_mapping is true we need to setup the bio graph.  If the mapping
+	// results contain the bio graph, it is restored from there.
 	mapper.run(*store);
 	mi->setStats(mapper.getStats());
 
 	//  ——— CONFIGURE HARDWARE —————————————————————————————————————————————————
 
-	static const double ms_to_s = 1e-3;
-
-	experiment::parameters::Experiment exp_params = mi->experiment;
-	if (exp_params.bio_duration_in_s() != 0.) {
-		LOG4CXX_WARN(
-			logger, "Discarded experiment duration set via mapping parameters "
-			"in favor of duration specified via argument to pynn.run()");
-	}
-	exp_params.bio_duration_in_s(store->getDuration() * ms_to_s);
+	auto const exp_params = experiment_parameters(*mi, *store);
 
 	results = mapper.results();
 
+	StageTimer configuration_timer(mi->getStats(), "hardware_configuration");
+
 	experiment::ReadRepeaterTestdata repeater_test(*results);
 
 	if (mi->checkl1locking == PyMarocco::CheckL1Locking::Check ||
@@ -241,23 +567,25 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 		repeater_test.configure(*hardware);
 	}
 
-	// Configure analog outputs.
-	{
-		experiment::AnalogOutputsConfigurator analog_outputs(results->analog_outputs);
-		analog_outputs.configure(*hardware);
-	}
+	auto const changes = configure_analog_outputs_and_spike_input(
+		*hardware, *results, exp_params, incremental.get());
 
-	// Configure external spike input.
-	{
-		hardware->clearSpikes();
-		experiment::SpikeTimesConfigurator spike_times_configurator(
-		    results->placement, results->spike_times, exp_params);
-		for (auto const& hicann : hardware->getAllocatedHicannCoordinates()) {
-			spike_times_configurator.configure(*hardware, hicann);
-		}
+	configuration_timer.stop();
+
+	// Whether the hardware holds the configuration of the last run, apart from the
+	// HICANNs that changed since.
+	bool const was_configured = incremental && incremental->configured();
+	if (incremental) {
+		// The hardware does not hold this configuration until it has been uploaded.
+		incremental->configured(false);
+		auto const& hicanns = incremental->changed_hicanns();
+		runtime_container->changed_hicanns(
+			std::vector<HICANNOnWafer>(hicanns.begin(), hicanns.end()));
 	}
 
 	if (!runtime_container) {
+		StageTimer timer(mi->getStats(), "persist");
+
 		// Dump sthal configuration container.
 		if (!mi->wafer_cfg.empty()) {
 			hardware->dump(mi->wafer_cfg.c_str(), /*overwrite=*/true);
@@ -279,6 +607,8 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 		return result;
 	}
 
+	StageTimer experiment_timer(mi->getStats(), "experiment");
+
 	DeleteRecursivelyOnScopeExit cleanup;
 	std::unique_ptr<sthal::ExperimentRunner> runner;
 	std::unique_ptr<sthal::HardwareDatabase> hwdb;
@@ -314,6 +644,8 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 			throw std::runtime_error("unknown backend");
 	}
 
+	// Whether chips keep their configuration when they are not configured again.
+	bool resets_hicanns = true;
 	switch(mi->hicann_configurator) {
 		case PyMarocco::HICANNCfg::HICANNConfigurator:
 			configurator.reset(new sthal::HICANNConfigurator());
@@ -329,9 +661,11 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 			break;
 		case PyMarocco::HICANNCfg::NoResetNoFGConfigurator:
 			configurator.reset(new sthal::NoResetNoFGConfigurator());
+			resets_hicanns = false;
 			break;
 		case PyMarocco::HICANNCfg::OnlyNeuronNoResetNoFGConfigurator:
 			configurator.reset(new sthal::OnlyNeuronNoResetNoFGConfigurator());
+			resets_hicanns = false;
 			break;
 		case PyMarocco::HICANNCfg::ParallelHICANNv4Configurator:
 			configurator.reset(new sthal::ParallelHICANNv4Configurator());
@@ -341,6 +675,7 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 			break;
 		case PyMarocco::HICANNCfg::ParallelHICANNNoResetNoFGConfigurator:
 			configurator.reset(new sthal::ParallelHICANNNoResetNoFGConfigurator());
+			resets_hicanns = false;
 			break;
 		default:
 			throw std::runtime_error("unknown configurator");
@@ -351,8 +686,19 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 
 	hardware->commonFPGASettings()->setPLL(mi->pll_freq);
 
+	StageTimer configure_timer(mi->getStats(), "configure");
+
 	hardware->connect(*hwdb);
-	hardware->configure(*configurator);
+	if (mi->incremental_weight_update && was_configured && !changes.all && !resets_hicanns &&
+	    mi->backend == PyMarocco::Backend::Hardware) {
+		// Only reconfigure HICANNs whose configuration changed since the last run.
+		auto const& hicanns = incremental->changed_hicanns();
+		LOG4CXX_INFO(logger, "Configuring " << hicanns.size() << " changed HICANN(s)");
+		experiment::FilteringHICANNConfigurator filtering_configurator(*configurator, hicanns);
+		hardware->configure(filtering_configurator);
+	} else {
+		hardware->configure(*configurator);
+	}
 
 	if(mi->backend == PyMarocco::Backend::Hardware) {
 
@@ -417,11 +763,23 @@ MappingResult run(boost::shared_ptr<ObjectStore> store) {
 		}
 	}
 
-	experiment.run();
+	configure_timer.stop();
+
+	if (incremental && mi->backend == PyMarocco::Backend::Hardware) {
+		incremental->configured(true);
+	}
+
+	{
+		StageTimer timer(mi->getStats(), "run");
+		experiment.run();
+	}
 
 	//  ——— EXTRACT RESULTS ————————————————————————————————————————————————————
 
-	experiment.extract_results(*store);
+	{
+		StageTimer timer(mi->getStats(), "extract_results");
+		experiment.extract_results(*store);
+	}
 
 	LOG4CXX_INFO(logger, "Finished");
 	return result;
@@ -38,8 +38,7 @@ void HICANNParameters::run()
 {
 	auto const& hicann = m_chip.index();
 	bool const local_neurons = !m_neuron_placement.find(hicann).empty();
-	bool const local_synapses =
-		m_synapse_routing.has(hicann) && !m_synapse_routing[hicann].synapse_switches().empty();
+	bool const local_synapses = has_local_synapses();
 	bool const external_input_or_transit_only = !local_neurons;
 	bool const external_input = ([&]() {
 		for (auto const& dnc_merger : iter_all<DNCMergerOnHICANN>()) {
@@ -77,17 +76,7 @@ void HICANNParameters::run()
 
 			if (local_synapses) {
 				// transform synapses
-				auto synapse_row_calib = calib->atSynapseRowCollection();
-
-				// set default synapse calibration if not existing
-				if (synapse_row_calib->size() == 0) {
-					MAROCCO_WARN(
-						"No synapse calibration available on " << hicann
-						<< ". The default synapse trafo will be used instead");
-					synapse_row_calib->setDefaults();
-				}
-
-				synapses(*synapse_row_calib);
+				transform_synapses(*calib);
 			}
 		}
 	}
@@ -110,6 +99,39 @@ void HICANNParameters::run()
 	}
 }
 
+void HICANNParameters::update_synapses()
+{
+	bool const local_neurons = !m_neuron_placement.find(m_chip.index()).empty();
+	if (!local_neurons || !has_local_synapses()) {
+		return;
+	}
+
+	auto calib = getCalibrationData(/*fallback_to_defaults=*/false);
+	transform_synapses(*calib);
+}
+
+bool HICANNParameters::has_local_synapses() const
+{
+	auto const& hicann = m_chip.index();
+	return m_synapse_routing.has(hicann) &&
+	       !m_synapse_routing[hicann].synapse_switches().empty();
+}
+
+void HICANNParameters::transform_synapses(calib_type& calib)
+{
+	auto synapse_row_calib = calib.atSynapseRowCollection();
+
+	// set default synapse calibration if not existing
+	if (synapse_row_calib->size() == 0) {
+		MAROCCO_WARN(
+			"No synapse calibration available on " << m_chip.index()
+			<< ". The default synapse trafo will be used instead");
+		synapse_row_calib->setDefaults();
+	}
+
+	synapses(*synapse_row_calib);
+}
+
 void HICANNParameters::neuron_config(neuron_calib_type const& /*unused*/)
 {
 
@@ -274,8 +296,8 @@ void HICANNParameters::synapses(synapse_row_calib_type const& calib)
 			size_t const trg_neuron_in_proj_view = routing::to_relative_index(
 				proj_view.post().mask(), item.target_neuron().neuron_index());
 
-			double const bio_weight =
-				proj_view.getWeights()(src_neuron_in_proj_view, trg_neuron_in_proj_view);
+			double const bio_weight = m_bio_graph.connectivity(edge).weight(
+				src_neuron_in_proj_view, trg_neuron_in_proj_view);
 
 			double const w_scale = weight_scales[synapse->toNeuronOnHICANN()];
 			assert(w_scale > 0.); // check for inconsistency between routing and placement
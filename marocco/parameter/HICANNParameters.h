@@ -47,7 +47,18 @@ public:
 
 	void run();
 
+	/**
+	 * @brief Only transform synapse weights, e.g. if nothing but the weights of the
+	 *        network changed since \c run() was called for this HICANN.
+	 */
+	void update_synapses();
+
 private:
+	bool has_local_synapses() const;
+
+	/// Transform synapse weights, falls back to default synapse calibration if necessary.
+	void transform_synapses(calib_type& calib);
+
 	// returns mean v_reset in bio mV
 	double neurons(neuron_calib_type const& calib);
 
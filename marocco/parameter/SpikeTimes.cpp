@@ -22,7 +22,7 @@ void SpikeTimes::run(results::SpikeTimes& result)
 {
 	auto const& graph = m_bio_graph.graph();
 	for (auto const& vertex : make_iterable(boost::vertices(graph))) {
-		if (!is_source(vertex, graph)) {
+		if (!is_source(vertex, graph) || !m_bio_graph.is_local(vertex)) {
 			continue;
 		}
 
@@ -1,5 +1,6 @@
 #include "marocco/parameter/results/SpikeTimes.h"
 
+#include <algorithm>
 #include <iterator>
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/vector.hpp>
@@ -10,6 +11,17 @@ namespace marocco {
 namespace parameter {
 namespace results {
 
+namespace {
+
+void sort_spikes(SpikeTimes::spikes_type& spikes)
+{
+	if (!std::is_sorted(spikes.begin(), spikes.end())) {
+		std::sort(spikes.begin(), spikes.end());
+	}
+}
+
+} // namespace
+
 auto SpikeTimes::get(BioNeuron const& neuron) const -> spikes_type const&
 {
 	auto const it = m_spikes.find(neuron);
@@ -28,24 +40,35 @@ void SpikeTimes::clear(BioNeuron const& neuron)
 
 void SpikeTimes::set(BioNeuron const& neuron, spikes_type const& spikes)
 {
-	m_spikes[neuron] = spikes;
+	auto& existing = m_spikes[neuron];
+	existing = spikes;
+	sort_spikes(existing);
 }
 
 void SpikeTimes::set(BioNeuron const& neuron, spikes_type&& spikes)
 {
-	m_spikes[neuron] = std::move(spikes);
+	auto& existing = m_spikes[neuron];
+	existing = std::move(spikes);
+	sort_spikes(existing);
 }
 
 void SpikeTimes::add(BioNeuron const& neuron, spikes_type const& spikes)
 {
 	auto& existing = m_spikes[neuron];
-	existing.reserve(existing.size() + spikes.size());
+	auto const size = existing.size();
+	existing.reserve(size + spikes.size());
 	std::copy(spikes.begin(), spikes.end(), std::back_inserter(existing));
+	auto const middle = existing.begin() + size;
+	if (!std::is_sorted(middle, existing.end())) {
+		std::sort(middle, existing.end());
+	}
+	std::inplace_merge(existing.begin(), middle, existing.end());
 }
 
 void SpikeTimes::add(BioNeuron const& neuron, double const& time)
 {
-	m_spikes[neuron].push_back(time);
+	auto& existing = m_spikes[neuron];
+	existing.insert(std::upper_bound(existing.begin(), existing.end(), time), time);
 }
 
 bool SpikeTimes::empty() const
@@ -65,6 +88,13 @@ void SpikeTimes::serialize(Archiver& ar, const unsigned int /* version */)
 	// clang-format off
 	ar & make_nvp("spikes", m_spikes);
 	// clang-format on
+
+	// Spike trains stored by earlier versions may be unsorted.
+	if (Archiver::is_loading::value) {
+		for (auto& item : m_spikes) {
+			sort_spikes(item.second);
+		}
+	}
 }
 
 } // namespace results
@@ -25,14 +25,15 @@ namespace results {
  * intermediate data structure to enable modification of the spike times of individual
  * neurons after mapping.  E.g. access via sthal only allows spikes to be cleared on a
  * per-FPGA basis.
- * @note Spikes are stored in an unsorted fashion, as sorting will have to be performed by
- *       sthal anyways, when merging spike trains of multiple neurons.
+ * @note Spike trains are kept sorted, s.t. spike trains of multiple neurons can be merged
+ *       efficiently when uploading them to the hardware.
  */
 class SpikeTimes
 {
 public:
 	typedef std::vector<double> spikes_type;
 
+	/// Sorted spike train of the given neuron.
 	spikes_type const& get(BioNeuron const& neuron) const;
 
 	void clear(BioNeuron const& neuron);
@@ -36,7 +36,7 @@ const InputPlacement::rate_type InputPlacement::max_rate_HICANN = 1.78e7; // Hz
 const InputPlacement::rate_type InputPlacement::max_rate_FPGA = 1.25e8; // Hz
 
 InputPlacement::InputPlacement(
-	graph_t const& graph,
+	BioGraph const& bio_graph,
 	parameters::InputPlacement const& parameters,
 	parameters::ManualPlacement const& manual_placement,
 	parameters::NeuronPlacement const& neuron_placement_parameters,
@@ -45,7 +45,8 @@ InputPlacement::InputPlacement(
 	double speedup,
 	sthal::Wafer& hw,
 	resource_manager_t& mgr)
-	: mGraph(graph),
+	: m_bio_graph(bio_graph),
+	  mGraph(bio_graph.graph()),
 	  m_parameters(parameters),
 	  m_manual_placement(manual_placement),
 	  m_neuron_placement_parameters(neuron_placement_parameters),
@@ -70,7 +71,9 @@ void InputPlacement::run(
 	// calculate it.
 
 	auto const wafers = mMgr.wafers();
-	BOOST_ASSERT_MSG(wafers.size() == 1, "only single-wafer use is supported");
+	if (wafers.size() != 1) {
+		throw std::runtime_error("input placement has to be run separately for each wafer");
+	}
 
 	Neighbors<HICANNOnWafer> neighbors;
 	for (auto const& hicann : mMgr.present()) {
@@ -95,6 +98,11 @@ void InputPlacement::run(
 			continue;
 		}
 
+		if (!m_bio_graph.is_local(vertex)) {
+			// Spike source has no targets on this wafer.
+			continue;
+		}
+
 		Population const& pop = *mGraph[vertex];
 		PopulationSlice bio = PopulationSlice{vertex, pop};
 
@@ -3,6 +3,7 @@
 #include <array>
 #include <memory>
 
+#include "marocco/BioGraph.h"
 #include "marocco/assignment/PopulationSlice.h"
 #include "marocco/config.h"
 #include "marocco/graph.h"
@@ -47,12 +48,15 @@ namespace placement {
  * The implementation is valid for both Layer 2 Architectures:
  * Old: Virtex FPGA + 4 DNC for 4 reticles
  * New: Kintex FPGA for 1 reticle
+ *
+ * @note Only spike sources which are local according to \c BioGraph::is_local(), i.e.
+ *       which have targets on this wafer, are placed.
  */
 struct InputPlacement
 {
 public:
 	InputPlacement(
-		graph_t const& graph,
+		BioGraph const& bio_graph,
 		parameters::InputPlacement const& parameters,
 		parameters::ManualPlacement const& manual_placement,
 		parameters::NeuronPlacement const& neuron_placement_parameters,
@@ -89,6 +93,7 @@ private:
 		internal::L1AddressAssignment& address_assignment,
 		marocco::assignment::PopulationSlice& bio);
 
+	BioGraph const&          m_bio_graph;
 	graph_t const&           mGraph;
 	parameters::InputPlacement const& m_parameters;
 	parameters::ManualPlacement const& m_manual_placement;
@@ -4,7 +4,7 @@
 
 #include "hal/Coordinate/iter_all.h"
 #include "marocco/Logger.h"
-#include "marocco/placement/MergerTreeRouter.h"
+#include "marocco/placement/MergerTreeRouterCache.h"
 #include "marocco/placement/MergerTreeConfigurator.h"
 #include "marocco/util.h"
 #include "marocco/util/chunked.h"
@@ -36,15 +36,18 @@ void MergerRouting::run(MergerTreeGraph const& graph, HMF::Coordinate::HICANNOnW
 			// MergerTreeRouting tries to merge adjacent neuron blocks such that the
 			// overall use of SPL1 outputs is minimized.  Every unused SPL1 output can
 			// then be used for external input.
+			// As only few distinct neuron block occupancies occur in practice, results
+			// are shared via a process-wide cache.
 
 			auto const& denmem_assignment = m_denmem_assignment.at(hicann);
-			MergerTreeRouter router(graph, denmem_assignment);
-			router.run();
+			auto const result = MergerTreeRouterCache::instance().get(
+				graph, MergerTreeRouter::count_neurons(denmem_assignment),
+				m_parameters.strategy());
 
 			// If there is no entry in the merger mapping result, the corresponding neuron
 			// block has not been merged with any other blocks and thus a 1-to-1
 			// connection should be possible (only adjacent blocks are merged!).
-			for (auto const& item : router.result()) {
+			for (auto const& item : result) {
 				merger_mapping[item.first] = item.second;
 			}
 
@@ -21,15 +21,27 @@ struct UnroutableNeuronBlock {};
 
 MergerTreeRouter::MergerTreeRouter(
 	MergerTreeGraph const& graph, internal::Result::denmem_assignment_type::mapped_type const& nbm)
-	: m_graph(graph)
+	: m_graph(graph), m_neurons(count_neurons(nbm))
 {
-	// Count the number of mapped bio neurons for each neuron block.
+}
+
+MergerTreeRouter::MergerTreeRouter(
+	MergerTreeGraph const& graph, neuron_counts_type const& neurons)
+	: m_graph(graph), m_neurons(neurons)
+{
+}
+
+auto MergerTreeRouter::count_neurons(
+	internal::Result::denmem_assignment_type::mapped_type const& nbm) -> neuron_counts_type
+{
+	neuron_counts_type neurons;
 	for (auto const& nb : iter_all<NeuronBlockOnHICANN>()) {
-		m_neurons[nb] = 0u;
+		neurons[nb] = 0u;
 		for (std::shared_ptr<internal::NeuronPlacementRequest> const& pl : nbm[nb]) {
-			m_neurons[nb] += pl->population_slice().size();
+			neurons[nb] += pl->population_slice().size();
 		}
 	}
+	return neurons;
 }
 
 void MergerTreeRouter::run()
@@ -28,6 +28,8 @@ class MergerTreeRouter {
 public:
 	typedef std::map<HMF::Coordinate::NeuronBlockOnHICANN, HMF::Coordinate::DNCMergerOnHICANN>
 		result_type;
+	typedef HMF::Coordinate::typed_array<size_t, HMF::Coordinate::NeuronBlockOnHICANN>
+		neuron_counts_type;
 
 	/**
 	 * @param graph Representation of merger tree.
@@ -39,6 +41,21 @@ public:
 		MergerTreeGraph const& graph,
 		internal::Result::denmem_assignment_type::mapped_type const& nbm);
 
+	/**
+	 * @param graph Representation of merger tree.
+	 * @param neurons Number of mapped bio neurons for each neuron block.
+	 * @see count_neurons()
+	 */
+	MergerTreeRouter(MergerTreeGraph const& graph, neuron_counts_type const& neurons);
+
+	/**
+	 * @brief Count the number of mapped bio neurons for each neuron block.
+	 * As this is the only information extracted from the neuron placement, it can be
+	 * used as (part of) a key when caching routing results.
+	 */
+	static neuron_counts_type count_neurons(
+		internal::Result::denmem_assignment_type::mapped_type const& nbm);
+
 	void run();
 
 	/**
@@ -67,7 +84,7 @@ private:
 	MergerTreeGraph m_graph;
 
 	/// number of placed neurons for each NeuronBlock
-	HMF::Coordinate::typed_array<size_t, HMF::Coordinate::NeuronBlockOnHICANN> m_neurons;
+	neuron_counts_type m_neurons;
 
 	result_type m_result;
 }; // MergerTreeRouter
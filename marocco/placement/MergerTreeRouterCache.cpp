@@ -0,0 +1,114 @@
+#include "marocco/placement/MergerTreeRouterCache.h"
+
+#include <algorithm>
+
+#include <boost/functional/hash.hpp>
+
+#include "hal/Coordinate/iter_all.h"
+#include "marocco/util/iterable.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace placement {
+
+static_assert(
+	MergerTreeGraph::vertices_count() <= 32, "defect mask does not fit merger tree graph");
+
+MergerTreeRouterCache::Signature::Signature(
+	neuron_counts_type const& neurons_, MergerTreeGraph const& graph, strategy_type strategy_)
+	: neurons(neurons_), defects(0u), strategy(strategy_)
+{
+	// As defects are implemented by clearing all edges of a vertex, we can recover them
+	// from the set of vertices that are not touched by any edge.  Vertices that are only
+	// isolated because all of their neighbors are defect yield the same graph anyway.
+	uint32_t connected = 0u;
+	auto const& g = graph.graph();
+	for (auto const& edge : make_iterable(edges(g))) {
+		connected |= uint32_t(1u) << source(edge, g);
+		connected |= uint32_t(1u) << target(edge, g);
+	}
+	uint32_t const all = (uint64_t(1u) << MergerTreeGraph::vertices_count()) - 1u;
+	defects = all & ~connected;
+}
+
+bool MergerTreeRouterCache::Signature::operator==(Signature const& other) const
+{
+	return defects == other.defects && strategy == other.strategy &&
+	       std::equal(neurons.begin(), neurons.end(), other.neurons.begin());
+}
+
+size_t MergerTreeRouterCache::SignatureHash::operator()(Signature const& signature) const
+{
+	size_t hash = 0;
+	for (auto const nb : iter_all<NeuronBlockOnHICANN>()) {
+		boost::hash_combine(hash, signature.neurons[nb]);
+	}
+	boost::hash_combine(hash, signature.defects);
+	boost::hash_combine(hash, static_cast<int>(signature.strategy));
+	return hash;
+}
+
+MergerTreeRouterCache& MergerTreeRouterCache::instance()
+{
+	static MergerTreeRouterCache cache;
+	return cache;
+}
+
+MergerTreeRouterCache::MergerTreeRouterCache() : m_results(), m_hits(0), m_misses(0), m_mutex()
+{
+}
+
+auto MergerTreeRouterCache::get(
+	MergerTreeGraph const& graph, neuron_counts_type const& neurons, strategy_type strategy)
+	-> result_type
+{
+	Signature const signature(neurons, graph, strategy);
+
+	{
+		tbb::mutex::scoped_lock lock(m_mutex);
+		auto it = m_results.find(signature);
+		if (it != m_results.end()) {
+			++m_hits;
+			return it->second;
+		}
+		++m_misses;
+	}
+
+	// Routing is done without holding the lock.  If another thread computes the same
+	// result in the meantime, the first inserted one is kept (both are identical).
+	MergerTreeRouter router(graph, neurons);
+	router.run();
+
+	tbb::mutex::scoped_lock lock(m_mutex);
+	return m_results.insert(std::make_pair(signature, router.result())).first->second;
+}
+
+size_t MergerTreeRouterCache::hits() const
+{
+	tbb::mutex::scoped_lock lock(m_mutex);
+	return m_hits;
+}
+
+size_t MergerTreeRouterCache::misses() const
+{
+	tbb::mutex::scoped_lock lock(m_mutex);
+	return m_misses;
+}
+
+size_t MergerTreeRouterCache::size() const
+{
+	tbb::mutex::scoped_lock lock(m_mutex);
+	return m_results.size();
+}
+
+void MergerTreeRouterCache::clear()
+{
+	tbb::mutex::scoped_lock lock(m_mutex);
+	m_results.clear();
+	m_hits = 0;
+	m_misses = 0;
+}
+
+} // namespace placement
+} // namespace marocco
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+#include <tbb/mutex.h>
+
+#include "marocco/placement/MergerTreeGraph.h"
+#include "marocco/placement/MergerTreeRouter.h"
+#include "marocco/placement/parameters/MergerRouting.h"
+
+namespace marocco {
+namespace placement {
+
+/**
+ * @brief Process-wide memo table for results of \c MergerTreeRouter.
+ * The outcome of merger tree routing only depends on the number of bio neurons placed
+ * on each neuron block, the set of defect mergers and the routing strategy.  As only a
+ * handful of distinct combinations occur across a wafer (and across repeated mappings
+ * in the same process), results are cached keyed by a compact signature of these inputs.
+ * @note Access is synchronized, so the cache can be shared between threads.
+ */
+class MergerTreeRouterCache
+{
+public:
+	typedef MergerTreeRouter::result_type result_type;
+	typedef MergerTreeRouter::neuron_counts_type neuron_counts_type;
+	typedef parameters::MergerRouting::Strategy strategy_type;
+
+	struct Signature
+	{
+		Signature(
+			neuron_counts_type const& neurons, MergerTreeGraph const& graph,
+			strategy_type strategy);
+
+		/// Number of bio neurons for each neuron block.
+		neuron_counts_type neurons;
+		/// One bit per vertex of the merger tree graph which is not connected to any
+		/// other merger, i.e. which was marked as defect (or only had defect neighbors).
+		uint32_t defects;
+		strategy_type strategy;
+
+		bool operator==(Signature const& other) const;
+	}; // Signature
+
+	struct SignatureHash
+	{
+		size_t operator()(Signature const& signature) const;
+	}; // SignatureHash
+
+	static MergerTreeRouterCache& instance();
+
+	/**
+	 * @brief Return routing result for the given merger tree and neuron counts.
+	 * On a cache miss \c MergerTreeRouter is run and its result is stored.
+	 * @param graph Representation of merger tree, with defect mergers removed.
+	 */
+	result_type get(
+		MergerTreeGraph const& graph, neuron_counts_type const& neurons, strategy_type strategy);
+
+	size_t hits() const;
+	size_t misses() const;
+	size_t size() const;
+
+	/**
+	 * @brief Drop all cached results and reset hit counters.
+	 */
+	void clear();
+
+private:
+	MergerTreeRouterCache();
+
+	std::unordered_map<Signature, result_type, SignatureHash> m_results;
+	size_t m_hits;
+	size_t m_misses;
+	mutable tbb::mutex m_mutex;
+}; // MergerTreeRouterCache
+
+} // namespace placement
+} // namespace marocco
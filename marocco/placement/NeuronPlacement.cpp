@@ -3,15 +3,20 @@
 #include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/variant.hpp>
+#include <limits>
+#include <map>
 #include <unordered_map>
 
 #include "hal/Coordinate/iter_all.h"
 #include "hal/Coordinate/typed_array.h"
 
 #include "marocco/Logger.h"
+#include "marocco/placement/internal/ClusterEmbedding.h"
+#include "marocco/placement/internal/MultilevelPartitioning.h"
 #include "marocco/util.h"
 #include "marocco/util/chunked.h"
 #include "marocco/util/iterable.h"
+#include "marocco/util/spiral_ordering.h"
 
 using namespace HMF::Coordinate;
 using marocco::placement::internal::NeuronPlacementRequest;
@@ -61,15 +66,29 @@ public:
 	}
 };
 
+/// Absolute neuron indices of the neurons contained in a population view mask.
+template <typename Mask>
+std::vector<size_t> absolute_indices(Mask const& mask)
+{
+	std::vector<size_t> result;
+	for (size_t ii = 0; ii < mask.size(); ++ii) {
+		if (mask[ii]) {
+			result.push_back(ii);
+		}
+	}
+	return result;
+}
+
 } // anonymous
 
 NeuronPlacement::NeuronPlacement(
-	graph_t const& graph,
+	BioGraph const& bio_graph,
 	parameters::NeuronPlacement const& parameters,
 	parameters::ManualPlacement const& manual_placement,
 	results::Placement& result,
 	internal::Result& internal)
-	: m_graph(graph),
+	: m_bio_graph(bio_graph),
+	  m_graph(bio_graph.graph()),
 	  m_parameters(parameters),
 	  m_manual_placement(manual_placement),
 	  m_result(result),
@@ -178,6 +197,11 @@ std::vector<NeuronPlacementRequest> NeuronPlacement::perform_manual_placement()
 			continue;
 		}
 
+		if (!m_bio_graph.is_local(v)) {
+			// Population is mapped to a different wafer.
+			continue;
+		}
+
 		Population const& pop = *m_graph[v];
 
 		// Check for existence of manual placement:
@@ -330,6 +354,11 @@ void NeuronPlacement::run()
 		}
 	}
 
+	if (m_parameters.strategy() ==
+	    parameters::NeuronPlacement::Strategy::graph_partitioning) {
+		place_by_connectivity(auto_placements);
+	}
+
 	PlacePopulations placer(m_denmem_assignment, neuron_blocks, auto_placements);
 	auto const& result = placer.sort_and_run();
 	post_process(result);
@@ -347,6 +376,151 @@ void NeuronPlacement::run()
 	MAROCCO_INFO("Placement of populations finished");
 }
 
+void NeuronPlacement::place_by_connectivity(std::vector<NeuronPlacementRequest>& queue)
+{
+	if (queue.empty() || m_denmem_assignment.empty()) {
+		return;
+	}
+
+	// Split requests into units that fit on a single neuron block, which are the vertices
+	// of the graph to be partitioned.
+	size_t const unassigned = std::numeric_limits<size_t>::max();
+	std::vector<NeuronPlacementRequest> units;
+	std::vector<size_t> weights;
+	std::unordered_map<graph_t::vertex_descriptor, std::vector<size_t> > unit_of_neuron;
+	for (auto request : queue) {
+		auto& slice = request.population_slice();
+		auto& lookup = unit_of_neuron[slice.population()];
+		lookup.resize(m_graph[slice.population()]->size(), unassigned);
+		size_t const per_block = NeuronOnNeuronBlock::enum_type::size / request.neuron_size();
+		while (!slice.empty()) {
+			auto const unit = slice.slice_front(per_block);
+			for (size_t nrn = unit.offset(); nrn < unit.offset() + unit.size(); ++nrn) {
+				lookup[nrn] = units.size();
+			}
+			weights.push_back(unit.size() * request.neuron_size());
+			units.push_back(NeuronPlacementRequest{unit, request.neuron_size()});
+		}
+	}
+
+	// Count synapses between units.
+	std::map<std::pair<size_t, size_t>, size_t> synapses;
+	for (auto const& edge : make_iterable(boost::edges(m_graph))) {
+		auto const source_it = unit_of_neuron.find(boost::source(edge, m_graph));
+		auto const target_it = unit_of_neuron.find(boost::target(edge, m_graph));
+		if (source_it == unit_of_neuron.end() || target_it == unit_of_neuron.end()) {
+			continue;
+		}
+
+		ProjectionView const proj_view = m_graph[edge];
+		auto const pre = absolute_indices(proj_view.pre().mask());
+		auto const post = absolute_indices(proj_view.post().mask());
+		auto const& connectivity = m_bio_graph.connectivity(edge);
+		for (size_t src = 0; src < pre.size(); ++src) {
+			size_t const source_unit = source_it->second[pre[src]];
+			if (source_unit == unassigned) {
+				continue;
+			}
+			for (auto const& synapse : connectivity.targets(src)) {
+				size_t const target_unit = target_it->second[post[synapse.index]];
+				if (target_unit == unassigned || source_unit == target_unit) {
+					continue;
+				}
+				++synapses[std::minmax(source_unit, target_unit)];
+			}
+		}
+	}
+
+	// Partition units into HICANN-sized clusters.
+	size_t capacity = 0;
+	size_t total = 0;
+	for (auto const& item : m_denmem_assignment) {
+		size_t available = 0;
+		for (auto const nb : iter_all<NeuronBlockOnHICANN>()) {
+			available += item.second[nb].available();
+		}
+		capacity = std::max(capacity, available);
+	}
+	for (auto const weight : weights) {
+		total += weight;
+	}
+	if (capacity == 0) {
+		return;
+	}
+
+	std::vector<size_t> parts;
+	size_t num_clusters = (total + capacity - 1) / capacity;
+	for (; num_clusters <= m_denmem_assignment.size(); ++num_clusters) {
+		internal::MultilevelPartitioning partitioning(weights, num_clusters, capacity);
+		for (auto const& item : synapses) {
+			partitioning.add_edge(item.first.first, item.first.second, item.second);
+		}
+		try {
+			parts = partitioning.run();
+		} catch (ResourceExhaustedError const&) {
+			continue;
+		}
+		MAROCCO_INFO(
+			"Partitioned " << units.size() << " placement units into " << num_clusters
+			<< " clusters, " << partitioning.cut() << " synapses between clusters");
+		break;
+	}
+
+	if (parts.empty()) {
+		MAROCCO_WARN("Unable to partition populations, falling back to spiral placement");
+		return;
+	}
+
+	// Embed clusters onto the HICANN grid, starting at the wafer center.
+	std::vector<HICANNOnWafer> hicanns;
+	for (auto const& item : m_denmem_assignment) {
+		hicanns.push_back(item.first);
+	}
+	std::sort(hicanns.begin(), hicanns.end(), spiral_ordering<HICANNOnWafer>());
+
+	internal::ClusterEmbedding embedding(hicanns, num_clusters);
+	{
+		std::map<std::pair<size_t, size_t>, size_t> cluster_synapses;
+		for (auto const& item : synapses) {
+			size_t const source = parts[item.first.first];
+			size_t const target = parts[item.first.second];
+			if (source != target) {
+				cluster_synapses[std::minmax(source, target)] += item.second;
+			}
+		}
+		for (auto const& item : cluster_synapses) {
+			embedding.add_edge(item.first.first, item.first.second, item.second);
+		}
+	}
+	auto const cluster_hicanns = embedding.run();
+	MAROCCO_INFO("Embedded clusters with total wire length " << embedding.wire_length());
+
+	std::vector<std::vector<NeuronPlacementRequest> > cluster_queues(num_clusters);
+	// PlacePopulations processes requests from the back.
+	for (size_t ii = units.size(); ii > 0; --ii) {
+		cluster_queues[parts[ii - 1]].push_back(units[ii - 1]);
+	}
+
+	queue.clear();
+	for (size_t cluster = 0; cluster < num_clusters; ++cluster) {
+		auto& cluster_queue = cluster_queues[cluster];
+		if (cluster_queue.empty()) {
+			continue;
+		}
+
+		std::vector<NeuronBlockOnWafer> neuron_blocks;
+		for (auto const nb : iter_all<NeuronBlockOnHICANN>()) {
+			neuron_blocks.emplace_back(nb, cluster_hicanns[cluster]);
+		}
+
+		PlacePopulations placer(m_denmem_assignment, neuron_blocks, cluster_queue);
+		post_process(placer.sort_and_run());
+
+		// Remaining requests are handled by the default placement.
+		queue.insert(queue.end(), cluster_queue.begin(), cluster_queue.end());
+	}
+}
+
 void NeuronPlacement::post_process(std::vector<PlacePopulations::result_type> const& placements)
 {
 	for (auto const& primary_neuron : placements) {
@@ -6,6 +6,7 @@
 #include "hal/Coordinate/HICANN.h"
 #include "hal/Coordinate/Neuron.h"
 
+#include "marocco/BioGraph.h"
 #include "marocco/config.h"
 #include "marocco/placement/internal/NeuronPlacementRequest.h"
 #include "marocco/placement/internal/PlacePopulations.h"
@@ -20,12 +21,13 @@ namespace placement {
 /**
  * Assign bio neurons to hardware neurons.
  * @note Takes user defined population placement into account.
+ * @note Only populations which are local according to \c BioGraph::is_local() are placed.
  */
 class NeuronPlacement
 {
 public:
 	NeuronPlacement(
-		graph_t const& graph,
+		BioGraph const& bio_graph,
 		parameters::NeuronPlacement const& parameters,
 		parameters::ManualPlacement const& manual_placement,
 		results::Placement& result,
@@ -49,8 +51,17 @@ private:
 	 */
 	std::vector<internal::NeuronPlacementRequest> perform_manual_placement();
 
+	/**
+	 * @brief Place strongly connected neurons on nearby HICANNs.
+	 * @param[in,out] queue Placement requests, will contain requests that could not be
+	 *                      placed afterwards.
+	 * @see parameters::NeuronPlacement::Strategy::graph_partitioning
+	 */
+	void place_by_connectivity(std::vector<internal::NeuronPlacementRequest>& queue);
+
 	void post_process(std::vector<internal::PlacePopulations::result_type> const& placements);
 
+	BioGraph const& m_bio_graph;
 	graph_t const& m_graph;
 	parameters::NeuronPlacement const& m_parameters;
 	parameters::ManualPlacement const& m_manual_placement;
@@ -1,6 +1,7 @@
 #include "marocco/placement/Placement.h"
 
 #include <sstream>
+#include <stdexcept>
 
 #include "hal/Coordinate/iter_all.h"
 
@@ -8,7 +9,9 @@
 #include "marocco/placement/InputPlacement.h"
 #include "marocco/placement/MergerRouting.h"
 #include "marocco/placement/MergerTreeConfigurator.h"
+#include "marocco/placement/MergerTreeRouterCache.h"
 #include "marocco/placement/NeuronPlacement.h"
+#include "marocco/util/stage_timer.h"
 
 using namespace HMF::Coordinate;
 
@@ -40,10 +43,10 @@ void handle_defects(
 
 Placement::Placement(
     pymarocco::PyMarocco& pymarocco,
-    graph_t const& graph,
+    BioGraph const& bio_graph,
     sthal::Wafer& hardware,
     resource_manager_t& resource_manager)
-    : m_graph(graph),
+    : m_bio_graph(bio_graph),
       m_hardware(hardware),
       m_resource_manager(resource_manager),
       m_pymarocco(pymarocco)
@@ -54,11 +57,17 @@ auto Placement::run(results::Placement& neuron_placement) -> std::unique_ptr<res
 {
 	std::unique_ptr<Result> result(new Result(neuron_placement));
 
+	// Placement results use on-wafer coordinates, networks spanning several wafers are
+	// split beforehand, see \c WaferPartitioning.
 	auto const wafers = m_resource_manager.wafers();
-	BOOST_ASSERT_MSG(wafers.size() == 1, "only single-wafer use is supported");
+	if (wafers.size() != 1) {
+		throw std::runtime_error("placement has to be run separately for each wafer");
+	}
+
+	StageTimer neuron_placement_timer(m_pymarocco.getStats(), "neuron_placement");
 
 	NeuronPlacement nrn_placement(
-		m_graph, m_pymarocco.neuron_placement, m_pymarocco.manual_placement,
+		m_bio_graph, m_pymarocco.neuron_placement, m_pymarocco.manual_placement,
 		neuron_placement, result->internal);
 
 	for (auto const& hicann : m_resource_manager.present()) {
@@ -85,6 +94,8 @@ auto Placement::run(results::Placement& neuron_placement) -> std::unique_ptr<res
 
 	nrn_placement.run();
 
+	neuron_placement_timer.stop();
+
 	{
 		std::string const horizontal_line(NeuronOnNeuronBlock::x_type::size * 4 + 10, '-');
 		for (auto const& item : result->internal.denmem_assignment) {
@@ -98,10 +109,16 @@ auto Placement::run(results::Placement& neuron_placement) -> std::unique_ptr<res
 		}
 	}
 
+	StageTimer merger_routing_timer(m_pymarocco.getStats(), "merger_routing");
+
 	MergerRouting merger_routing(
 		m_pymarocco.merger_routing, result->internal.denmem_assignment, result->merger_routing);
 
 	for (auto const& item : result->internal.denmem_assignment) {
+		auto const hicann_start = StageTimer::clock_type::now();
+		trace::Scope trace(
+			"merger_routing", "placement", {"hicann", std::int64_t(item.first.toEnum().value())});
+
 		// Tag HICANN as 'in use' in the resource manager.
 		HICANNGlobal hicann(item.first, wafers.front());
 		if (m_resource_manager.available(hicann)) {
@@ -151,11 +168,23 @@ auto Placement::run(results::Placement& neuron_placement) -> std::unique_ptr<res
 				    logical_neuron, L1AddressOnWafer(dnc, address));
 			}
 		}
+
+		merger_routing_timer.hot_spot(item.first, StageTimer::clock_type::now() - hicann_start);
 	}
 
+	{
+		auto const& cache = MergerTreeRouterCache::instance();
+		MAROCCO_DEBUG(
+			"Merger tree router cache: " << cache.hits() << " hits, " << cache.misses()
+			<< " misses, " << cache.size() << " distinct results");
+	}
+
+	merger_routing_timer.stop();
+
 	// placement of externals, eg spike inputs
+	StageTimer input_placement_timer(m_pymarocco.getStats(), "input_placement");
 	InputPlacement input_placement(
-	    m_graph, m_pymarocco.input_placement, m_pymarocco.manual_placement,
+	    m_bio_graph, m_pymarocco.input_placement, m_pymarocco.manual_placement,
 	    m_pymarocco.neuron_placement, m_pymarocco.l1_address_assignment, result->merger_routing,
 	    m_pymarocco.experiment.speedup(), m_hardware, m_resource_manager);
 	input_placement.run(neuron_placement, result->internal.address_assignment);
@@ -2,7 +2,7 @@
 
 #include <memory>
 
-#include "marocco/graph.h"
+#include "marocco/BioGraph.h"
 #include "marocco/placement/Result.h"
 #include "pymarocco/PyMarocco.h"
 
@@ -16,14 +16,14 @@ public:
 
 	Placement(
 	    pymarocco::PyMarocco& pymarocco,
-	    graph_t const& graph,
+	    BioGraph const& bio_graph,
 	    sthal::Wafer& hardware,
 	    resource_manager_t& resource_manager);
 
 	std::unique_ptr<result_type> run(results::Placement& result);
 
 private:
-	graph_t const& m_graph;
+	BioGraph const& m_bio_graph;
 	sthal::Wafer& m_hardware;
 	resource_manager_t& m_resource_manager;
 	pymarocco::PyMarocco& m_pymarocco;
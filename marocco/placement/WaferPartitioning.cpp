@@ -0,0 +1,102 @@
+#include "marocco/placement/WaferPartitioning.h"
+
+#include <set>
+
+#include "marocco/Logger.h"
+#include "marocco/placement/internal/GraphPartitioning.h"
+#include "marocco/util/iterable.h"
+
+namespace marocco {
+namespace placement {
+
+WaferPartitioning::WaferPartitioning(
+	BioGraph const& bio_graph, std::map<wafer_type, size_t> const& capacities)
+	: m_bio_graph(bio_graph), m_wafers(), m_capacities(), m_assignment(), m_cut(0)
+{
+	for (auto const& item : capacities) {
+		m_wafers.push_back(item.first);
+		m_capacities.push_back(item.second);
+	}
+}
+
+void WaferPartitioning::run()
+{
+	auto const& graph = m_bio_graph.graph();
+
+	// Physical populations are mapped to consecutive indices.
+	std::vector<vertex_descriptor> vertices;
+	std::map<vertex_descriptor, size_t> indices;
+	std::vector<size_t> weights;
+	for (auto const& vertex : make_iterable(boost::vertices(graph))) {
+		if (!is_physical(vertex, graph)) {
+			continue;
+		}
+		indices[vertex] = vertices.size();
+		vertices.push_back(vertex);
+		weights.push_back(graph[vertex]->size());
+	}
+
+	internal::GraphPartitioning partitioning(weights, m_capacities);
+
+	for (auto const& edge : make_iterable(boost::edges(graph))) {
+		auto const source = boost::source(edge, graph);
+		auto const target = boost::target(edge, graph);
+		if (!is_physical(source, graph) || !is_physical(target, graph)) {
+			continue;
+		}
+		partitioning.add_edge(indices.at(source), indices.at(target), m_bio_graph.connectivity(edge).size());
+	}
+
+	auto const& parts = partitioning.run();
+	m_assignment.clear();
+	for (size_t ii = 0; ii < vertices.size(); ++ii) {
+		m_assignment[vertices[ii]] = parts[ii];
+	}
+	m_cut = partitioning.cut();
+
+	auto const& usage = partitioning.usage();
+	for (size_t ii = 0; ii < m_wafers.size(); ++ii) {
+		MAROCCO_INFO(
+			usage[ii] << " of " << m_capacities[ii] << " neurons assigned to " << m_wafers[ii]);
+	}
+	MAROCCO_INFO(m_cut << " synapses between populations on different wafers");
+}
+
+auto WaferPartitioning::wafers() const -> std::vector<wafer_type>
+{
+	std::set<size_t> used;
+	for (auto const& item : m_assignment) {
+		used.insert(item.second);
+	}
+
+	std::vector<wafer_type> result;
+	for (size_t const index : used) {
+		result.push_back(m_wafers[index]);
+	}
+	return result;
+}
+
+bool WaferPartitioning::is_local(vertex_descriptor const& vertex, wafer_type const& wafer) const
+{
+	auto const& graph = m_bio_graph.graph();
+
+	if (is_physical(vertex, graph)) {
+		return m_wafers.at(m_assignment.at(vertex)) == wafer;
+	}
+
+	for (auto const& edge : make_iterable(boost::out_edges(vertex, graph))) {
+		auto const target = boost::target(edge, graph);
+		if (is_physical(target, graph) && m_wafers.at(m_assignment.at(target)) == wafer) {
+			return true;
+		}
+	}
+	return false;
+}
+
+size_t WaferPartitioning::cut() const
+{
+	return m_cut;
+}
+
+} // namespace placement
+} // namespace marocco
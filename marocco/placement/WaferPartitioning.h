@@ -0,0 +1,55 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+#include "hal/Coordinate/HMFGeometry.h"
+
+#include "marocco/BioGraph.h"
+
+namespace marocco {
+namespace placement {
+
+/**
+ * @brief Distribution of the biological network across several wafers.
+ * Physical populations are assigned as a whole to one of the given wafers, such that the
+ * number of synapses between populations on different wafers is kept small.  As there
+ * are no inter-wafer L1 connections, these synapses can not be realized.
+ * Spike sources are not partitioned: they are considered local to every wafer that
+ * holds at least one of their target populations.
+ */
+class WaferPartitioning
+{
+public:
+	typedef HMF::Coordinate::Wafer wafer_type;
+	typedef BioGraph::vertex_descriptor vertex_descriptor;
+
+	/**
+	 * @param capacities Number of bio neurons that can be placed on each wafer.
+	 */
+	WaferPartitioning(BioGraph const& bio_graph, std::map<wafer_type, size_t> const& capacities);
+
+	/**
+	 * @throw ResourceExhaustedError If the network does not fit onto the given wafers.
+	 */
+	void run();
+
+	/// Wafers which have at least one population assigned to them.
+	std::vector<wafer_type> wafers() const;
+
+	bool is_local(vertex_descriptor const& vertex, wafer_type const& wafer) const;
+
+	/// Number of synapses between populations on different wafers.
+	size_t cut() const;
+
+private:
+	BioGraph const& m_bio_graph;
+	std::vector<wafer_type> m_wafers;
+	std::vector<size_t> m_capacities;
+	/// Wafer index for each physical population.
+	std::map<vertex_descriptor, size_t> m_assignment;
+	size_t m_cut;
+}; // WaferPartitioning
+
+} // namespace placement
+} // namespace marocco
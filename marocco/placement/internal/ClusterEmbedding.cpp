@@ -0,0 +1,212 @@
+#include "marocco/placement/internal/ClusterEmbedding.h"
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "marocco/util.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+namespace {
+
+/// Upper bound on the number of improvement passes.
+size_t const max_improvement_passes = 8;
+
+size_t manhattan_distance(HICANNOnWafer const& a, HICANNOnWafer const& b)
+{
+	return std::abs(int(a.x()) - int(b.x())) + std::abs(int(a.y()) - int(b.y()));
+}
+
+} // namespace
+
+ClusterEmbedding::ClusterEmbedding(std::vector<HICANNOnWafer> const& hicanns, size_t num_clusters)
+	: m_hicanns(hicanns), m_adjacency(num_clusters), m_position(), m_occupant()
+{
+}
+
+void ClusterEmbedding::add_edge(cluster_type source, cluster_type target, weight_type weight)
+{
+	if (source >= m_adjacency.size() || target >= m_adjacency.size()) {
+		throw std::out_of_range("edge references unknown cluster");
+	}
+
+	if (source == target || weight == 0) {
+		return;
+	}
+
+	m_adjacency[source].push_back(Neighbor{target, weight});
+	m_adjacency[target].push_back(Neighbor{source, weight});
+}
+
+auto ClusterEmbedding::cost(cluster_type cluster, size_t hicann) const -> weight_type
+{
+	size_t const unplaced = m_hicanns.size();
+	weight_type result = 0;
+	for (auto const& neighbor : m_adjacency[cluster]) {
+		size_t const position = m_position[neighbor.cluster];
+		if (position == unplaced) {
+			continue;
+		}
+		result += neighbor.weight * manhattan_distance(m_hicanns[hicann], m_hicanns[position]);
+	}
+	return result;
+}
+
+std::vector<HICANNOnWafer> ClusterEmbedding::run()
+{
+	size_t const num_clusters = m_adjacency.size();
+	if (num_clusters > m_hicanns.size()) {
+		throw ResourceExhaustedError("more clusters than HICANNs");
+	}
+
+	initial_embedding();
+
+	for (size_t pass = 0; pass < max_improvement_passes; ++pass) {
+		if (!improve()) {
+			break;
+		}
+	}
+
+	std::vector<HICANNOnWafer> result;
+	result.reserve(num_clusters);
+	for (auto const position : m_position) {
+		result.push_back(m_hicanns[position]);
+	}
+	return result;
+}
+
+void ClusterEmbedding::initial_embedding()
+{
+	size_t const num_clusters = m_adjacency.size();
+	size_t const unplaced = m_hicanns.size();
+
+	m_position.assign(num_clusters, unplaced);
+	m_occupant.assign(m_hicanns.size(), num_clusters);
+
+	// Accumulated edge weight to already placed clusters and in total.
+	std::vector<weight_type> attraction(num_clusters, 0);
+	std::vector<weight_type> degree(num_clusters, 0);
+	for (cluster_type cluster = 0; cluster < num_clusters; ++cluster) {
+		for (auto const& neighbor : m_adjacency[cluster]) {
+			degree[cluster] += neighbor.weight;
+		}
+	}
+
+	for (size_t ii = 0; ii < num_clusters; ++ii) {
+		// Hubs are placed first, so that they end up on the preferred HICANNs and their
+		// neighbors can be arranged around them.
+		cluster_type cluster = num_clusters;
+		for (cluster_type candidate = 0; candidate < num_clusters; ++candidate) {
+			if (m_position[candidate] != unplaced) {
+				continue;
+			}
+			if (cluster == num_clusters || attraction[candidate] > attraction[cluster] ||
+			    (attraction[candidate] == attraction[cluster] &&
+			     degree[candidate] > degree[cluster])) {
+				cluster = candidate;
+			}
+		}
+
+		// Choose the free HICANN closest to the already placed neighbors.  Ties are
+		// resolved in favor of the preferred HICANNs.
+		size_t best = unplaced;
+		weight_type best_cost = 0;
+		for (size_t hicann = 0; hicann < m_hicanns.size(); ++hicann) {
+			if (m_occupant[hicann] != num_clusters) {
+				continue;
+			}
+			weight_type const current = cost(cluster, hicann);
+			if (best == unplaced || current < best_cost) {
+				best = hicann;
+				best_cost = current;
+			}
+		}
+
+		m_position[cluster] = best;
+		m_occupant[best] = cluster;
+
+		for (auto const& neighbor : m_adjacency[cluster]) {
+			attraction[neighbor.cluster] += neighbor.weight;
+		}
+	}
+}
+
+bool ClusterEmbedding::improve()
+{
+	size_t const num_clusters = m_adjacency.size();
+	bool changed = false;
+
+	for (cluster_type cluster = 0; cluster < num_clusters; ++cluster) {
+		size_t const from = m_position[cluster];
+		weight_type const current = cost(cluster, from);
+		if (current == 0) {
+			continue;
+		}
+
+		size_t best = from;
+		weight_type best_gain = 0;
+
+		for (size_t hicann = 0; hicann < m_hicanns.size(); ++hicann) {
+			if (hicann == from) {
+				continue;
+			}
+
+			cluster_type const other = m_occupant[hicann];
+			if (other == num_clusters) {
+				weight_type const moved = cost(cluster, hicann);
+				if (moved < current && current - moved > best_gain) {
+					best = hicann;
+					best_gain = current - moved;
+				}
+				continue;
+			}
+
+			// Swap both clusters.  The connection between them (if any) is counted twice
+			// before and after, so the difference is the change of total wire length.
+			weight_type const before = current + cost(other, hicann);
+			m_position[cluster] = hicann;
+			m_position[other] = from;
+			weight_type const after = cost(cluster, hicann) + cost(other, from);
+			m_position[cluster] = from;
+			m_position[other] = hicann;
+
+			if (after < before && before - after > best_gain) {
+				best = hicann;
+				best_gain = before - after;
+			}
+		}
+
+		if (best == from) {
+			continue;
+		}
+
+		cluster_type const other = m_occupant[best];
+		if (other != num_clusters) {
+			m_position[other] = from;
+		}
+		m_occupant[from] = other;
+		m_position[cluster] = best;
+		m_occupant[best] = cluster;
+		changed = true;
+	}
+
+	return changed;
+}
+
+auto ClusterEmbedding::wire_length() const -> weight_type
+{
+	weight_type result = 0;
+	for (cluster_type cluster = 0; cluster < m_adjacency.size(); ++cluster) {
+		result += cost(cluster, m_position[cluster]);
+	}
+	// Each edge has been counted twice.
+	return result / 2;
+}
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "hal/Coordinate/HICANN.h"
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+/**
+ * @brief Assign clusters of populations to distinct HICANNs such that the total wire
+ *        length, i.e. the sum of connection weights times the manhattan distance between
+ *        the respective HICANNs, is small.
+ * Clusters are placed greedily, strongly connected clusters first, and then improved by
+ * pairwise swaps and moves to unused HICANNs.
+ */
+class ClusterEmbedding
+{
+public:
+	typedef size_t cluster_type;
+	typedef size_t weight_type;
+
+	/**
+	 * @param hicanns Candidate HICANNs in order of preference, which is used to break
+	 *        ties, e.g. to start at the center of the wafer.
+	 */
+	ClusterEmbedding(std::vector<HMF::Coordinate::HICANNOnWafer> const& hicanns, size_t num_clusters);
+
+	void add_edge(cluster_type source, cluster_type target, weight_type weight);
+
+	/**
+	 * @brief Return HICANN for each cluster.
+	 * @throw ResourceExhaustedError If there are more clusters than HICANNs.
+	 */
+	std::vector<HMF::Coordinate::HICANNOnWafer> run();
+
+	/// Accumulated wire length of the last result.
+	weight_type wire_length() const;
+
+private:
+	struct Neighbor
+	{
+		cluster_type cluster;
+		weight_type weight;
+	};
+
+	/**
+	 * @brief Wire length of all connections of the given cluster, if it is located on
+	 *        the specified HICANN.  Unplaced neighbors are ignored.
+	 */
+	weight_type cost(cluster_type cluster, size_t hicann) const;
+
+	void initial_embedding();
+	bool improve();
+
+	std::vector<HMF::Coordinate::HICANNOnWafer> m_hicanns;
+	std::vector<std::vector<Neighbor> > m_adjacency;
+	/// Index into \c m_hicanns for each cluster.
+	std::vector<size_t> m_position;
+	/// Cluster located on each HICANN (or the number of clusters, if unused).
+	std::vector<cluster_type> m_occupant;
+}; // ClusterEmbedding
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
@@ -0,0 +1,200 @@
+#include "marocco/placement/internal/GraphPartitioning.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "marocco/util.h"
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+namespace {
+
+/// Upper bound on the number of refinement passes.
+size_t const max_refinement_passes = 32;
+
+} // namespace
+
+GraphPartitioning::GraphPartitioning(
+	std::vector<weight_type> const& vertex_weights, std::vector<weight_type> const& capacities)
+	: m_vertex_weights(vertex_weights),
+	  m_capacities(capacities),
+	  m_adjacency(vertex_weights.size()),
+	  m_usage(),
+	  m_result()
+{
+}
+
+void GraphPartitioning::add_edge(vertex_type source, vertex_type target, weight_type weight)
+{
+	if (source >= m_adjacency.size() || target >= m_adjacency.size()) {
+		throw std::out_of_range("edge references unknown vertex");
+	}
+
+	// Self-loops never contribute to the cut.
+	if (source == target || weight == 0) {
+		return;
+	}
+
+	m_adjacency[source].push_back(Neighbor{target, weight});
+	m_adjacency[target].push_back(Neighbor{source, weight});
+}
+
+auto GraphPartitioning::run() -> std::vector<part_type> const&
+{
+	initial_assignment();
+	refine_until_stable();
+	return m_result;
+}
+
+auto GraphPartitioning::run(std::vector<part_type> const& initial)
+	-> std::vector<part_type> const&
+{
+	if (initial.size() != m_vertex_weights.size()) {
+		throw std::invalid_argument("initial assignment does not match number of vertices");
+	}
+
+	m_usage.assign(m_capacities.size(), 0);
+	for (vertex_type vertex = 0; vertex < initial.size(); ++vertex) {
+		if (initial[vertex] >= m_capacities.size()) {
+			throw std::invalid_argument("initial assignment contains invalid part");
+		}
+		m_usage[initial[vertex]] += m_vertex_weights[vertex];
+	}
+	m_result = initial;
+
+	refine_until_stable();
+	return m_result;
+}
+
+void GraphPartitioning::refine_until_stable()
+{
+	for (size_t pass = 0; pass < max_refinement_passes; ++pass) {
+		if (!refine()) {
+			break;
+		}
+	}
+}
+
+auto GraphPartitioning::cut() const -> weight_type
+{
+	weight_type result = 0;
+	for (vertex_type vertex = 0; vertex < m_adjacency.size(); ++vertex) {
+		for (auto const& neighbor : m_adjacency[vertex]) {
+			if (vertex < neighbor.vertex && m_result[vertex] != m_result[neighbor.vertex]) {
+				result += neighbor.weight;
+			}
+		}
+	}
+	return result;
+}
+
+auto GraphPartitioning::usage() const -> std::vector<weight_type> const&
+{
+	return m_usage;
+}
+
+std::vector<GraphPartitioning::weight_type> GraphPartitioning::connectivity(
+	vertex_type vertex) const
+{
+	std::vector<weight_type> result(m_capacities.size(), 0);
+	for (auto const& neighbor : m_adjacency[vertex]) {
+		part_type const part = m_result[neighbor.vertex];
+		// Unassigned vertices are marked by an invalid part index.
+		if (part < result.size()) {
+			result[part] += neighbor.weight;
+		}
+	}
+	return result;
+}
+
+void GraphPartitioning::initial_assignment()
+{
+	size_t const num_vertices = m_vertex_weights.size();
+	part_type const unassigned = m_capacities.size();
+
+	m_usage.assign(m_capacities.size(), 0);
+	m_result.assign(num_vertices, unassigned);
+
+	// Accumulated edge weight to already assigned vertices.
+	std::vector<weight_type> attraction(num_vertices, 0);
+
+	for (size_t ii = 0; ii < num_vertices; ++ii) {
+		// Pick the unassigned vertex that is connected most strongly to the assigned
+		// ones.  This grows connected components in one piece.  If there are no such
+		// connections, e.g. at the start of a new component, larger vertices go first.
+		vertex_type vertex = num_vertices;
+		for (vertex_type candidate = 0; candidate < num_vertices; ++candidate) {
+			if (m_result[candidate] != unassigned) {
+				continue;
+			}
+			if (vertex == num_vertices || attraction[candidate] > attraction[vertex] ||
+			    (attraction[candidate] == attraction[vertex] &&
+			     m_vertex_weights[candidate] > m_vertex_weights[vertex])) {
+				vertex = candidate;
+			}
+		}
+
+		auto const conn = connectivity(vertex);
+		weight_type const weight = m_vertex_weights[vertex];
+
+		// Choose the part with the strongest connection that still has room.  Ties are
+		// resolved in favor of lower indices, so that parts are filled one after another.
+		part_type best = unassigned;
+		for (part_type part = 0; part < m_capacities.size(); ++part) {
+			if (m_usage[part] + weight > m_capacities[part]) {
+				continue;
+			}
+			if (best == unassigned || conn[part] > conn[best]) {
+				best = part;
+			}
+		}
+
+		if (best == unassigned) {
+			throw ResourceExhaustedError("graph does not fit into available partitions");
+		}
+
+		m_result[vertex] = best;
+		m_usage[best] += weight;
+
+		for (auto const& neighbor : m_adjacency[vertex]) {
+			attraction[neighbor.vertex] += neighbor.weight;
+		}
+	}
+}
+
+bool GraphPartitioning::refine()
+{
+	bool changed = false;
+
+	for (vertex_type vertex = 0; vertex < m_vertex_weights.size(); ++vertex) {
+		auto const conn = connectivity(vertex);
+		weight_type const weight = m_vertex_weights[vertex];
+		part_type const from = m_result[vertex];
+
+		// Only strictly positive gains are accepted, which guarantees termination.
+		part_type best = from;
+		for (part_type part = 0; part < m_capacities.size(); ++part) {
+			if (part == from || m_usage[part] + weight > m_capacities[part]) {
+				continue;
+			}
+			if (conn[part] > conn[best]) {
+				best = part;
+			}
+		}
+
+		if (best != from) {
+			m_result[vertex] = best;
+			m_usage[from] -= weight;
+			m_usage[best] += weight;
+			changed = true;
+		}
+	}
+
+	return changed;
+}
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+/**
+ * @brief Split a weighted graph into capacity-bounded parts while keeping the weight of
+ *        edges between different parts small.
+ * Vertices are identified by consecutive indices, edges are undirected and parallel
+ * edges accumulate their weights.  An initial assignment is grown greedily by always
+ * picking the unassigned vertex with the strongest connection to already assigned ones,
+ * which is then refined by moving single vertices between parts as long as this reduces
+ * the cut (in the spirit of Kernighan-Lin / Fiduccia-Mattheyses).
+ */
+class GraphPartitioning
+{
+public:
+	typedef size_t vertex_type;
+	typedef size_t part_type;
+	typedef size_t weight_type;
+
+	/**
+	 * @param vertex_weights Weight (i.e. resource usage) of each vertex.
+	 * @param capacities Maximum accumulated vertex weight of each part.
+	 */
+	GraphPartitioning(
+		std::vector<weight_type> const& vertex_weights, std::vector<weight_type> const& capacities);
+
+	void add_edge(vertex_type source, vertex_type target, weight_type weight);
+
+	/**
+	 * @brief Return part index for each vertex.
+	 * @throw ResourceExhaustedError If vertices do not fit into the available parts.
+	 */
+	std::vector<part_type> const& run();
+
+	/**
+	 * @brief Refine the given assignment instead of growing an initial one.
+	 * Parts whose capacity is already exceeded by \c initial do not accept further
+	 * vertices.
+	 * @throw std::invalid_argument If \c initial does not contain a valid part index
+	 *        for each vertex.
+	 */
+	std::vector<part_type> const& run(std::vector<part_type> const& initial);
+
+	/// Accumulated weight of edges between different parts.
+	weight_type cut() const;
+
+	/// Accumulated vertex weight of each part.
+	std::vector<weight_type> const& usage() const;
+
+private:
+	void initial_assignment();
+	bool refine();
+	void refine_until_stable();
+
+	/**
+	 * @brief Accumulated edge weight between vertex and the vertices in each part.
+	 */
+	std::vector<weight_type> connectivity(vertex_type vertex) const;
+
+	struct Neighbor
+	{
+		vertex_type vertex;
+		weight_type weight;
+	};
+
+	std::vector<weight_type> m_vertex_weights;
+	std::vector<weight_type> m_capacities;
+	std::vector<std::vector<Neighbor> > m_adjacency;
+	std::vector<weight_type> m_usage;
+	std::vector<part_type> m_result;
+}; // GraphPartitioning
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
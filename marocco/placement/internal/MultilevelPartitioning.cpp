@@ -0,0 +1,197 @@
+#include "marocco/placement/internal/MultilevelPartitioning.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+#include "marocco/placement/internal/GraphPartitioning.h"
+#include "marocco/util.h"
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+namespace {
+
+/// Coarsening stops if this many vertices per part are left.
+size_t const coarsest_vertices_per_part = 4;
+
+} // namespace
+
+MultilevelPartitioning::MultilevelPartitioning(
+	std::vector<weight_type> const& vertex_weights, size_t num_parts, weight_type capacity)
+	: m_num_parts(num_parts), m_capacity(capacity), m_levels(1), m_result()
+{
+	auto& level = m_levels.front();
+	level.weights = vertex_weights;
+	level.adjacency.resize(vertex_weights.size());
+}
+
+void MultilevelPartitioning::add_edge(vertex_type source, vertex_type target, weight_type weight)
+{
+	auto& adjacency = m_levels.front().adjacency;
+	if (source >= adjacency.size() || target >= adjacency.size()) {
+		throw std::out_of_range("edge references unknown vertex");
+	}
+
+	if (source == target || weight == 0) {
+		return;
+	}
+
+	adjacency[source][target] += weight;
+	adjacency[target][source] += weight;
+}
+
+bool MultilevelPartitioning::coarsen()
+{
+	Level& fine = m_levels.back();
+	size_t const num_vertices = fine.weights.size();
+
+	// Visit light vertices first, so that they get a chance to be merged before their
+	// neighbors grow too heavy.
+	std::vector<vertex_type> order(num_vertices);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&fine](vertex_type a, vertex_type b) {
+		return fine.weights[a] < fine.weights[b];
+	});
+
+	vertex_type const unmatched = num_vertices;
+	std::vector<vertex_type> match(num_vertices, unmatched);
+	for (auto const vertex : order) {
+		if (match[vertex] != unmatched) {
+			continue;
+		}
+
+		// Heavy-edge matching: contract the strongest edge to an unmatched neighbor.
+		// Merged vertices are limited to half of the capacity, so that the coarse graph
+		// can still be packed into the available parts.
+		vertex_type best = unmatched;
+		weight_type best_weight = 0;
+		for (auto const& item : fine.adjacency[vertex]) {
+			auto const neighbor = item.first;
+			if (match[neighbor] != unmatched ||
+			    2 * (fine.weights[vertex] + fine.weights[neighbor]) > m_capacity) {
+				continue;
+			}
+			if (item.second > best_weight) {
+				best = neighbor;
+				best_weight = item.second;
+			}
+		}
+
+		match[vertex] = vertex;
+		if (best != unmatched) {
+			match[vertex] = best;
+			match[best] = vertex;
+		}
+	}
+
+	fine.coarse.assign(num_vertices, 0);
+	Level coarse;
+	for (vertex_type vertex = 0; vertex < num_vertices; ++vertex) {
+		if (match[vertex] < vertex) {
+			fine.coarse[vertex] = fine.coarse[match[vertex]];
+			coarse.weights[fine.coarse[vertex]] += fine.weights[vertex];
+			continue;
+		}
+		fine.coarse[vertex] = coarse.weights.size();
+		coarse.weights.push_back(fine.weights[vertex]);
+	}
+
+	// Only continue if the graph shrinks noticeably.
+	if (coarse.weights.size() * 20 > num_vertices * 19) {
+		fine.coarse.clear();
+		return false;
+	}
+
+	coarse.adjacency.resize(coarse.weights.size());
+	for (vertex_type vertex = 0; vertex < num_vertices; ++vertex) {
+		for (auto const& item : fine.adjacency[vertex]) {
+			auto const source = fine.coarse[vertex];
+			auto const target = fine.coarse[item.first];
+			if (source != target) {
+				coarse.adjacency[source][target] += item.second;
+			}
+		}
+	}
+
+	m_levels.push_back(std::move(coarse));
+	return true;
+}
+
+auto MultilevelPartitioning::partition(Level const& level, std::vector<part_type> const* initial)
+	-> std::vector<part_type>
+{
+	GraphPartitioning partitioning(
+		level.weights, std::vector<weight_type>(m_num_parts, m_capacity));
+	for (vertex_type vertex = 0; vertex < level.adjacency.size(); ++vertex) {
+		for (auto const& item : level.adjacency[vertex]) {
+			// Adjacency is symmetric, thus only add each edge once.
+			if (vertex < item.first) {
+				partitioning.add_edge(vertex, item.first, item.second);
+			}
+		}
+	}
+	return initial ? partitioning.run(*initial) : partitioning.run();
+}
+
+auto MultilevelPartitioning::run() -> std::vector<part_type> const&
+{
+	m_levels.resize(1);
+	m_levels.front().coarse.clear();
+
+	size_t const coarsest_size = m_num_parts * coarsest_vertices_per_part;
+	while (m_levels.back().weights.size() > coarsest_size && coarsen()) {
+		continue;
+	}
+
+	// Greedy packing of the coarse vertices may fail although the original graph would
+	// fit.  In this case, fall back to the next finer level.
+	std::vector<part_type> parts;
+	while (true) {
+		try {
+			parts = partition(m_levels.back(), nullptr);
+			break;
+		} catch (ResourceExhaustedError const&) {
+			if (m_levels.size() == 1) {
+				throw;
+			}
+			m_levels.pop_back();
+		}
+	}
+
+	for (size_t ii = m_levels.size() - 1; ii > 0; --ii) {
+		Level const& fine = m_levels[ii - 1];
+		std::vector<part_type> projected(fine.weights.size());
+		for (vertex_type vertex = 0; vertex < projected.size(); ++vertex) {
+			projected[vertex] = parts[fine.coarse[vertex]];
+		}
+		parts = partition(fine, &projected);
+	}
+
+	m_result = std::move(parts);
+	return m_result;
+}
+
+auto MultilevelPartitioning::cut() const -> weight_type
+{
+	auto const& adjacency = m_levels.front().adjacency;
+	weight_type result = 0;
+	for (vertex_type vertex = 0; vertex < adjacency.size(); ++vertex) {
+		for (auto const& item : adjacency[vertex]) {
+			if (vertex < item.first && m_result[vertex] != m_result[item.first]) {
+				result += item.second;
+			}
+		}
+	}
+	return result;
+}
+
+size_t MultilevelPartitioning::num_levels() const
+{
+	return m_levels.size();
+}
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
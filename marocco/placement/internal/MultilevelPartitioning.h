@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+/**
+ * @brief Multilevel variant of \c GraphPartitioning for a large number of small vertices.
+ * The graph is coarsened by repeatedly contracting heavy edges (as long as the merged
+ * vertices still fit into a single part), the coarsest graph is partitioned and the
+ * result is then projected back level by level, refining it on each level.
+ * All parts share the same capacity.
+ */
+class MultilevelPartitioning
+{
+public:
+	typedef size_t vertex_type;
+	typedef size_t part_type;
+	typedef size_t weight_type;
+
+	MultilevelPartitioning(
+		std::vector<weight_type> const& vertex_weights, size_t num_parts, weight_type capacity);
+
+	void add_edge(vertex_type source, vertex_type target, weight_type weight);
+
+	/**
+	 * @brief Return part index for each vertex.
+	 * @throw ResourceExhaustedError If vertices do not fit into the available parts.
+	 */
+	std::vector<part_type> const& run();
+
+	/// Accumulated weight of edges between different parts.
+	weight_type cut() const;
+
+	/// Number of levels used during the last run, including the original graph.
+	size_t num_levels() const;
+
+private:
+	struct Level
+	{
+		std::vector<weight_type> weights;
+		/// Symmetric adjacency with accumulated edge weights.
+		std::vector<std::map<vertex_type, weight_type> > adjacency;
+		/// Index of the vertex on the next coarser level each vertex is contracted to.
+		std::vector<vertex_type> coarse;
+	};
+
+	/**
+	 * @brief Contract heavy edges of the last level.
+	 * @return False if the graph could not be reduced significantly.
+	 */
+	bool coarsen();
+
+	std::vector<part_type> partition(Level const& level, std::vector<part_type> const* initial);
+
+	size_t m_num_parts;
+	weight_type m_capacity;
+	std::vector<Level> m_levels;
+	std::vector<part_type> m_result;
+}; // MultilevelPartitioning
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
@@ -10,13 +10,24 @@ namespace placement {
 namespace parameters {
 
 NeuronPlacement::NeuronPlacement()
-	: m_default_neuron_size(4),
+	: m_strategy(Strategy::spiral),
+	  m_default_neuron_size(4),
 	  m_restrict_rightmost_neuron_blocks(false),
 	  m_minimize_number_of_sending_repeaters(false),
 	  m_skip_hicanns_without_neuron_blacklisting(true)
 {
 }
 
+void NeuronPlacement::strategy(Strategy value)
+{
+	m_strategy = value;
+}
+
+auto NeuronPlacement::strategy() const -> Strategy
+{
+	return m_strategy;
+}
+
 void NeuronPlacement::default_neuron_size(size_type size)
 {
 	check_neuron_size(size);
@@ -66,7 +77,8 @@ void NeuronPlacement::serialize(Archive& ar, unsigned int const /* version */)
 	ar & make_nvp("default_neuron_size", m_default_neuron_size)
 	   & make_nvp("restrict_rightmost_neuron_blocks", m_restrict_rightmost_neuron_blocks)
 	   & make_nvp("minimize_number_of_sending_repeaters", m_minimize_number_of_sending_repeaters)
-	   & make_nvp("skip_hicanns_without_neuron_blacklisting", m_skip_hicanns_without_neuron_blacklisting);
+	   & make_nvp("skip_hicanns_without_neuron_blacklisting", m_skip_hicanns_without_neuron_blacklisting)
+	   & make_nvp("strategy", m_strategy);
 	// clang-format on
 }
 
@@ -2,6 +2,8 @@
 
 #include <boost/serialization/export.hpp>
 
+#include "pywrap/compat/macros.hpp"
+
 namespace boost {
 namespace serialization {
 class access;
@@ -16,8 +18,26 @@ class NeuronPlacement {
 public:
 	typedef size_t size_type;
 
+	PYPP_CLASS_ENUM(Strategy)
+	{
+		/**
+		 * @brief Fill neuron blocks by available space, starting at the wafer center.
+		 */
+		spiral,
+		/**
+		 * @brief Partition populations into HICANN-sized clusters of strongly connected
+		 *        neurons (weighted by synapse counts), which are then embedded onto the
+		 *        HICANN grid such that the total wire length is small.
+		 * Neurons which could not be placed this way fall back to \c spiral placement.
+		 */
+		graph_partitioning
+	};
+
 	NeuronPlacement();
 
+	void strategy(Strategy value);
+	Strategy strategy() const;
+
 	/**
 	 * @brief Default size of a logical neuron.
 	 * @throw std::invalid_argument If given neuron size is invalid.
@@ -55,6 +75,7 @@ public:
 	bool skip_hicanns_without_neuron_blacklisting() const;
 
 private:
+	Strategy m_strategy;
 	size_type m_default_neuron_size;
 	bool m_restrict_rightmost_neuron_blocks;
 	bool m_minimize_number_of_sending_repeaters;
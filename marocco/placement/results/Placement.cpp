@@ -6,6 +6,9 @@
 // definition of `hash_value(boost::optional<T> const&)` from lib-boost-patches (c/1573)
 #include "boost/optional/hash_value.tcc"
 
+#include "marocco/results/Revision.h"
+#include "marocco/util/pack_records.h"
+
 using namespace HMF::Coordinate;
 using boost::multi_index::get;
 
@@ -76,11 +79,16 @@ void Placement::item_type::set_address(L1AddressOnWafer const& address)
 	m_address = address;
 }
 
+Placement::Placement() : m_container(), m_revision(::marocco::results::next_revision())
+{
+}
+
 void Placement::add(BioNeuron const& bio_neuron, LogicalNeuron const& logical_neuron)
 {
 	if (!m_container.insert(item_type(bio_neuron, logical_neuron)).second) {
 		throw std::runtime_error("conflict when adding neuron placement result");
 	}
+	m_revision = ::marocco::results::next_revision();
 }
 
 auto Placement::find(BioNeuron const& bio_neuron) const
@@ -168,6 +176,39 @@ void Placement::set_address(
 	if (!by_neuron.modify(it, [&address](item_type& item) { item.set_address(address); })) {
 		throw std::runtime_error("could not store L1 address of neuron");
 	}
+	m_revision = ::marocco::results::next_revision();
+}
+
+auto Placement::records() const -> std::vector<record_type>
+{
+	static_assert(sizeof(record_type) == 24, "record_type has to be packed");
+
+	std::vector<record_type> result;
+	result.reserve(m_container.size());
+	for (auto const& item : m_container) {
+		record_type record{item.population(), item.neuron_index(), -1, -1, -1, -1};
+		if (auto const& neuron_block = item.neuron_block()) {
+			record.hicann = neuron_block->toHICANNOnWafer().toEnum().value();
+			record.neuron_block = neuron_block->toNeuronBlockOnHICANN().value();
+		}
+		if (auto const& address = item.address()) {
+			record.hicann = address->toHICANNOnWafer().toEnum().value();
+			record.dnc_merger = address->toDNCMergerOnHICANN().value();
+			record.l1_address = address->toL1Address().value();
+		}
+		result.push_back(record);
+	}
+	return result;
+}
+
+std::string Placement::packed_records() const
+{
+	return pack_records(records());
+}
+
+size_t Placement::revision() const
+{
+	return m_revision;
 }
 
 template <typename Archiver>
@@ -189,6 +230,9 @@ void Placement::serialize(Archiver& ar, const unsigned int /* version */)
 	// clang-format off
 	ar & make_nvp("container", m_container);
 	// clang-format on
+	if (Archiver::is_loading::value) {
+		m_revision = ::marocco::results::next_revision();
+	}
 }
 
 } // namespace results
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index/ordered_index.hpp>
@@ -96,6 +99,22 @@ public:
 	typedef container_type::iterator iterator;
 	typedef container_type::iterator const_iterator;
 
+	/**
+	 * @brief Flat representation of a single placement, see \c records().
+	 * Coordinates are stored as enum values relative to the HICANN, missing values are
+	 * represented by -1.  For external neurons, \c hicann is the HICANN of the DNC merger.
+	 */
+	struct record_type {
+		uint64_t population;
+		uint64_t neuron_index;
+		int16_t hicann;
+		int16_t neuron_block;
+		int16_t dnc_merger;
+		int16_t l1_address;
+	};
+
+	Placement();
+
 	void add(BioNeuron const& bio_neuron, LogicalNeuron const& logical_neuron);
 
 	iterable<by_bio_neuron_type::iterator> find(BioNeuron const& bio_neuron) const;
@@ -141,8 +160,28 @@ public:
 	 */
 	void set_address(LogicalNeuron const& logical_neuron, L1AddressOnWafer const& address);
 
+#ifndef PYPLUSPLUS
+	/// All placements in iteration order.
+	std::vector<record_type> records() const;
+#endif // !PYPLUSPLUS
+
+	/**
+	 * @brief Raw bytes of \c records(), for bulk export to NumPy.
+	 * @see \c pymarocco.results for conversion to a structured array.
+	 */
+	std::string packed_records() const;
+
+	/**
+	 * @brief Revision of the last modification, see \c marocco::results::next_revision().
+	 * Can be used to invalidate data derived from this placement result.  Copies share the
+	 * revision of their source.
+	 * @note This counter is not serialized.
+	 */
+	size_t revision() const;
+
 private:
 	container_type m_container;
+	size_t m_revision;
 
 	friend class boost::serialization::access;
 	template <typename Archiver>
@@ -1,6 +1,4 @@
-#include <tuple>
 #include <stdexcept>
-#include <tuple>
 #include <utility>
 
 #include "marocco/resource/HICANNManager.h"
@@ -20,61 +18,81 @@ HICANNManager::HICANNManager(
 }
 
 void HICANNManager::reload() {
-	std::set<wafer_type> wafers;
+	std::vector<wafer_state_type> states;
+	states.swap(mWafers);
+	mWaferIndex.clear();
 
-	for (auto const& pair : mWafers) {
-		wafers.insert(pair.first);
-	}
-
-	mWafers.clear();
-
-	for (auto const& wafer : wafers) {
-		load(wafer);
+	for (auto const& state : states) {
+		add(manager_type(mBackend, state.manager.id()), state.masked, state.allocated);
 	}
+	update_enabled();
 }
 
 void HICANNManager::load(wafer_type const& wafer) {
-	auto it = mWafers.find(wafer);
-
-	if (it != mWafers.end())
+	if (mWaferIndex.find(wafer) != mWaferIndex.end())
 		throw std::runtime_error("Wafer has already been loaded.");
 
-	mWafers.insert(
-	    std::make_pair(wafer, manager_type(mBackend, wafer)));
+	add(manager_type(mBackend, wafer), bitset_type(), bitset_type());
+	update_enabled();
 }
 
 void HICANNManager::inject(manager_type const& wafer) {
-	auto pair = mWafers.insert(std::make_pair(wafer.id(), wafer));
-	if (!pair.second)
+	if (mWaferIndex.find(wafer.id()) != mWaferIndex.end())
 		throw std::runtime_error("Wafer has already been loaded.");
+
+	add(wafer, bitset_type(), bitset_type());
+	update_enabled();
+}
+
+void HICANNManager::add(
+	manager_type const& wafer, bitset_type const& masked, bitset_type const& allocated) {
+	wafer_state_type state{wafer, bitset_type(), masked, allocated};
+	auto const hicanns = wafer.hicanns();
+	for (auto it = hicanns->begin(); it != hicanns->end(); ++it) {
+		Co::HICANNOnWafer const hicann = *it;
+		state.enabled.set(hicann.toEnum().value());
+	}
+
+	mWaferIndex[wafer.id()] = mWafers.size();
+	mWafers.push_back(std::move(state));
+}
+
+void HICANNManager::update_enabled() {
+	mEnabled.clear();
+	for (auto const& pair : mWaferIndex) {
+		auto const& enabled = mWafers[pair.second].enabled;
+		for (size_t id = 0; id < enabled.size(); ++id) {
+			if (enabled.test(id)) {
+				mEnabled.push_back(entry_type{
+					resource_type(Co::HICANNOnWafer(Co::Enum(id)), pair.first), pair.second});
+			}
+		}
+	}
 }
 
 auto HICANNManager::wafers() const -> std::vector<wafer_type> {
 	std::vector<wafer_type> ws;
-	ws.reserve(mWafers.size());
-	for (auto const& pair : mWafers) {
+	ws.reserve(mWaferIndex.size());
+	for (auto const& pair : mWaferIndex) {
 		ws.push_back(pair.first);
 	}
 	return ws;
 }
 
 bool HICANNManager::has(resource_type const& r) const {
-	return (wafer_for(r) != mWafers.end()
-	        && mMasked.find(r) == mMasked.end());
+	size_t const index = wafer_for(r);
+	return (index != mWafers.size()
+	        && !mWafers[index].masked.test(r.toHICANNOnWafer().toEnum().value()));
 }
 
-auto HICANNManager::wafer_for(resource_type const& r) const
-    -> wafer_map_type::const_iterator {
-	Co::Wafer wafer;
-	Co::HICANNOnWafer hicann;
-	std::tie(wafer, hicann) = r.split();
-
-	auto it = mWafers.find(wafer);
+size_t HICANNManager::wafer_for(resource_type const& r) const {
+	auto it = mWaferIndex.find(r.toWafer());
 
-	if (it != mWafers.end() && it->second.has(hicann))
-		return it;
+	if (it != mWaferIndex.end() &&
+	    mWafers[it->second].enabled.test(r.toHICANNOnWafer().toEnum().value()))
+		return it->second;
 
-	return mWafers.end();
+	return mWafers.size();
 }
 
 boost::shared_ptr<const redman::resources::Hicann>
@@ -82,126 +100,126 @@ HICANNManager::get(resource_type const& r) const {
 	if (!has(r))
 		throw std::runtime_error("HICANN not present.");
 
-	auto it = wafer_for(r);
-	return it->second.get(r.toHICANNOnWafer());
+	return mWafers[wafer_for(r)].manager.get(r.toHICANNOnWafer());
 }
 
 void HICANNManager::mask(resource_type const& r) {
-	if (wafer_for(r) == mWafers.end())
+	size_t const index = wafer_for(r);
+	if (index == mWafers.size())
 		throw std::runtime_error("HICANN not present.");
 
-	auto it = mMasked.insert(r);
-	if (!it.second)
+	auto&& bit = mWafers[index].masked[r.toHICANNOnWafer().toEnum().value()];
+	if (bit)
 		throw std::runtime_error("HICANN has already been masked.");
+	bit = true;
 }
 
 void HICANNManager::unmask(resource_type const& r) {
-	if (wafer_for(r) == mWafers.end())
+	size_t const index = wafer_for(r);
+	if (index == mWafers.size())
 		throw std::runtime_error("HICANN not present.");
 
-	auto it = mMasked.find(r);
-	if (it == mMasked.end())
+	auto&& bit = mWafers[index].masked[r.toHICANNOnWafer().toEnum().value()];
+	if (!bit)
 		throw std::runtime_error("HICANN has not been masked yet.");
-
-	mMasked.erase(it);
+	bit = false;
 }
 
 bool HICANNManager::masked(resource_type const& r) const {
-	return mMasked.find(r) != mMasked.end();
+	auto it = mWaferIndex.find(r.toWafer());
+	return (it != mWaferIndex.end()
+	        && mWafers[it->second].masked.test(r.toHICANNOnWafer().toEnum().value()));
 }
 
 void HICANNManager::allocate(resource_type const& r) {
 	if (!has(r))
 		throw std::runtime_error("HICANN not present.");
 
-	auto it = mAllocated.insert(r);
-	if (!it.second)
+	auto&& bit = mWafers[wafer_for(r)].allocated[r.toHICANNOnWafer().toEnum().value()];
+	if (bit)
 		throw std::runtime_error("HICANN has already been allocated.");
+	bit = true;
 }
 
 void HICANNManager::release(resource_type const& r) {
 	if (!has(r))
 		throw std::runtime_error("HICANN not present.");
 
-	auto it = mAllocated.find(r);
-	if (it == mAllocated.end())
+	auto&& bit = mWafers[wafer_for(r)].allocated[r.toHICANNOnWafer().toEnum().value()];
+	if (!bit)
 		throw std::runtime_error("HICANN has not been allocated yet.");
-
-	mAllocated.erase(it);
+	bit = false;
 }
 
 bool HICANNManager::available(resource_type const& r) const {
-	return (has(r) && mAllocated.find(r) == mAllocated.end());
+	return (has(r)
+	        && !mWafers[wafer_for(r)].allocated.test(r.toHICANNOnWafer().toEnum().value()));
 }
 
 size_t HICANNManager::count_present() const {
-	size_t available = 0;
-	for (auto const& pair : mWafers) {
-		available += pair.second.hicanns()->available();
+	size_t present = 0;
+	for (auto const& state : mWafers) {
+		present += (state.enabled & ~state.masked).count();
 	}
-	return available - mMasked.size();
+	return present;
 }
 
 size_t HICANNManager::count_available() const {
-	return count_present() - mAllocated.size();
+	size_t available = 0;
+	for (auto const& state : mWafers) {
+		available += (state.enabled & ~state.masked & ~state.allocated).count();
+	}
+	return available;
 }
 
 size_t HICANNManager::count_allocated() const {
-	return mAllocated.size();
+	size_t allocated = 0;
+	for (auto const& state : mWafers) {
+		allocated += state.allocated.count();
+	}
+	return allocated;
 }
 
 auto HICANNManager::begin(iterator_type::mode_type mode) const -> iterator_type {
-	iterator_type::queue_type queue;
-
-	for (auto it = mWafers.cbegin(); it != mWafers.cend(); ++it) {
-		queue.push(it);
-	}
-
-	return iterator_type{mMasked, mAllocated, std::move(queue), mode};
+	return iterator_type{*this, 0, mode};
 }
 
 auto HICANNManager::end(iterator_type::mode_type mode) const -> iterator_type {
-	return iterator_type{mMasked, mAllocated, iterator_type::queue_type{}, mode};
+	return iterator_type{*this, mEnabled.size(), mode};
 }
 
 HICANNManager::iterator_type::iterator_type(
-	allocation_type const& mask,
-	allocation_type const& alloc,
-	queue_type&& q,
+	HICANNManager const& manager,
+	size_t index,
 	mode_type mode)
-    : mMode(mode),
-      mMasked(mask),
-      mAllocated(alloc),
-      mWafer(),
-      mCurrent(),
-      mIter(),
-      mQueue(q) {
-	pop();
+    : mManager(&manager),
+      mIndex(index),
+      mMode(mode) {
 	check_maybe_increment();
 }
 
+bool HICANNManager::iterator_type::at_end() const {
+	return mIndex >= mManager->mEnabled.size();
+}
+
 bool HICANNManager::iterator_type::equal(iterator_type const& other) const {
-	return mMode == other.mMode
-		&& mWafer == other.mWafer
-		&& mCurrent == other.mCurrent
-		&& mIter == other.mIter
-		&& mQueue == other.mQueue;
+	return mManager == other.mManager
+		&& mMode == other.mMode
+		&& (at_end() ? other.at_end() : mIndex == other.mIndex);
 }
 
 void HICANNManager::iterator_type::increment() {
-	++mIter;
-
-	if (mIter == mCurrent->end())
-		pop();
-
+	++mIndex;
 	check_maybe_increment();
 }
 
 void HICANNManager::iterator_type::check_maybe_increment() {
-	while (mCurrent && mIter != mCurrent->end()) {
-		auto hicann = dereference();
-		auto masked = (mMasked.find(hicann) != mMasked.end());
-		auto allocated = (mAllocated.find(hicann) != mAllocated.end());
+	for (; !at_end(); ++mIndex) {
+		auto const& entry = mManager->mEnabled[mIndex];
+		auto const& state = mManager->mWafers[entry.wafer];
+		size_t const id = entry.hicann.toHICANNOnWafer().toEnum().value();
+		auto masked = state.masked.test(id);
+		auto allocated = state.allocated.test(id);
 
 		switch (mMode) {
 			case PRESENT:
@@ -217,33 +235,11 @@ void HICANNManager::iterator_type::check_maybe_increment() {
 					return;
 				break;
 		}
-
-		++mIter;
-
-		if (mIter == mCurrent->end())
-			pop();
 	}
 }
 
 auto HICANNManager::iterator_type::dereference() const -> resource_type {
-	// if (!mCurrent)
-	// 	throw std::runtime_error("Dereferencing end iterator.");
-	return Co::HICANNGlobal(*mIter, mWafer);
-}
-
-void HICANNManager::iterator_type::pop() {
-	if (mQueue.empty()) {
-		mWafer = Co::Wafer{};
-		mCurrent.reset();
-		mIter = underlying_iterator_type{};
-		return;
-	}
-
-	auto pair = *mQueue.front();
-	mWafer = pair.first;
-	mCurrent = pair.second.hicanns();
-	mIter = mCurrent->begin();
-	mQueue.pop();
+	return mManager->mEnabled[mIndex].hicann;
 }
 
 } // namespace resource
@@ -1,10 +1,9 @@
 #pragma once
 
-#include <queue>
+#include <bitset>
 #include <map>
 #include <set>
-#include <unordered_set>
-#include <unordered_map>
+#include <vector>
 
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/iterator/iterator_facade.hpp>
@@ -22,7 +21,12 @@ class Backend;
 
 namespace marocco {
 namespace resource {
-/** Overlay that can be used to track allocated HICANNs at runtime. */
+/** Overlay that can be used to track allocated HICANNs at runtime.
+ * The state of each wafer is kept in bitsets indexed by `HICANNOnWafer`, s.t. checking
+ * and changing the state of a HICANN are single bit operations.  Iteration runs over a
+ * dense list of all HICANNs enabled in the resource management, which is only rebuilt
+ * when wafer data is (re)loaded.
+ */
 class HICANNManager {
 public:
 	typedef HMF::Coordinate::HICANNGlobal resource_type;
@@ -30,8 +34,22 @@ public:
 private:
 	typedef HMF::Coordinate::Wafer wafer_type;
 	typedef redman::resources::WaferWithBackend manager_type;
-	typedef std::map<wafer_type, const manager_type> wafer_map_type;
-	typedef std::unordered_set<resource_type> allocation_type;
+	typedef std::bitset<HMF::Coordinate::HICANNOnWafer::enum_type::size> bitset_type;
+
+	struct wafer_state_type {
+		manager_type manager;
+		/// HICANNs enabled in the resource management.
+		bitset_type enabled;
+		bitset_type masked;
+		bitset_type allocated;
+	};
+
+	/// HICANN enabled in the resource management, see `mEnabled`.
+	struct entry_type {
+		resource_type hicann;
+		/// Index into `mWafers`.
+		size_t wafer;
+	};
 
 public:
 	HICANNManager(
@@ -125,55 +143,49 @@ protected:
 	void reload();
 
 private:
-	/** Returns an iterator to the wafer map entry belonging to the given
-	 * HICANN if the checks outlined in the description of `has()` succeed.
-	 * Else a past-the-end iterator is returned.
+	/** Returns the index of the wafer state belonging to the given HICANN
+	 * if it is enabled in the resource management.  Masking and allocation
+	 * are not taken into account.  Else the number of wafers is returned.
 	 */
-	wafer_map_type::const_iterator wafer_for(resource_type const& hicann) const;
+	size_t wafer_for(resource_type const& hicann) const;
+
+	/// Add state of the given wafer, keeping masked and allocated HICANNs.
+	void add(manager_type const& wafer, bitset_type const& masked, bitset_type const& allocated);
+
+	/// Rebuild the dense list of enabled HICANNs after wafer data changed.
+	void update_enabled();
 
 	boost::shared_ptr<redman::backend::Backend> mBackend;
-	wafer_map_type mWafers;
-	allocation_type mMasked;
-	allocation_type mAllocated;
+	std::vector<wafer_state_type> mWafers;
+	/// Index into `mWafers` for each loaded wafer.
+	std::map<wafer_type, size_t> mWaferIndex;
+	/// Enabled HICANNs of all wafers, ordered by wafer and HICANN.
+	std::vector<entry_type> mEnabled;
 
 	class iterator_type
 		: public boost::iterator_facade<
 			iterator_type, resource_type, boost::forward_traversal_tag,
 			// Return copy instead of reference:
 			resource_type> {
-		typedef size_t index_value_type;
-		typedef redman::resources::components::Hicanns manager_type;
-		typedef manager_type::iterator_type underlying_iterator_type;
-
 	public:
-		typedef std::queue<wafer_map_type::const_iterator> queue_type;
 		enum mode_type {
 			PRESENT, AVAILABLE, ALLOCATED
 		};
 
-		iterator_type(
-			allocation_type const& masked,
-			allocation_type const& allocated,
-			queue_type&& queue,
-			mode_type mode);
+		iterator_type(HICANNManager const& manager, size_t index, mode_type mode);
 
 	private:
 		friend class boost::iterator_core_access;
 
+		bool at_end() const;
 		bool equal(iterator_type const& other) const;
 		void increment();
 		void check_maybe_increment();
 		resource_type dereference() const;
 
-		void pop();
-
-		const mode_type mMode;
-		allocation_type const& mMasked;
-		allocation_type const& mAllocated;
-		wafer_type mWafer;
-		boost::shared_ptr<const manager_type> mCurrent;
-		underlying_iterator_type mIter;
-		queue_type mQueue;
+		HICANNManager const* mManager;
+		size_t mIndex;
+		mode_type mMode;
 	};
 
 	iterator_type begin(iterator_type::mode_type mode) const;
@@ -0,0 +1,98 @@
+#include "marocco/results/BioGraph.h"
+
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace marocco {
+namespace results {
+
+BioGraph::BioGraph() : m_vertices(), m_edges()
+{
+}
+
+bool BioGraph::empty() const
+{
+	return m_vertices.empty();
+}
+
+void BioGraph::clear()
+{
+	m_vertices.clear();
+	m_edges.clear();
+}
+
+size_t BioGraph::num_vertices() const
+{
+	return m_vertices.size();
+}
+
+size_t BioGraph::num_edges() const
+{
+	return m_edges.size();
+}
+
+void BioGraph::add(Vertex const& vertex)
+{
+	m_vertices.push_back(vertex);
+}
+
+void BioGraph::add(Edge&& edge)
+{
+	m_edges.push_back(std::move(edge));
+}
+
+auto BioGraph::vertices() const -> vertices_type const&
+{
+	return m_vertices;
+}
+
+auto BioGraph::edges() const -> edges_type const&
+{
+	return m_edges;
+}
+
+template <typename Archiver>
+void BioGraph::Vertex::serialize(Archiver& ar, const unsigned int /* version */)
+{
+	using namespace boost::serialization;
+	// clang-format off
+	ar & make_nvp("population", population)
+	   & make_nvp("size", size)
+	   & make_nvp("is_local", is_local);
+	// clang-format on
+}
+
+template <typename Archiver>
+void BioGraph::Edge::serialize(Archiver& ar, const unsigned int /* version */)
+{
+	using namespace boost::serialization;
+	// clang-format off
+	ar & make_nvp("source", source)
+	   & make_nvp("target", target)
+	   & make_nvp("projection", projection)
+	   & make_nvp("view", view)
+	   & make_nvp("num_sources", num_sources)
+	   & make_nvp("num_targets", num_targets)
+	   & make_nvp("row_offsets", row_offsets)
+	   & make_nvp("targets", targets)
+	   & make_nvp("weights", weights);
+	// clang-format on
+}
+
+template <typename Archiver>
+void BioGraph::serialize(Archiver& ar, const unsigned int /* version */)
+{
+	using namespace boost::serialization;
+	// clang-format off
+	ar & make_nvp("vertices", m_vertices)
+	   & make_nvp("edges", m_edges);
+	// clang-format on
+}
+
+} // namespace results
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_IMPLEMENT(::marocco::results::BioGraph)
+
+#include "boost/serialization/serialization_helper.tcc"
+EXPLICIT_INSTANTIATE_BOOST_SERIALIZE(::marocco::results::BioGraph)
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <boost/serialization/export.hpp>
+
+namespace boost {
+namespace serialization {
+class access;
+} // namespace serialization
+} // namespace boost
+
+namespace marocco {
+namespace results {
+
+/**
+ * @brief Compact representation of the bio graph used for a mapping run.
+ * Stores the topology, the assignment of edge ids and the synapses of all projection
+ * views, so that runs reusing old mapping results (see \c PyMarocco::skip_mapping) can
+ * restore the bio graph without evaluating the dense weight matrices of all projections.
+ * Populations and projections are only referenced by their euter ids.
+ */
+class BioGraph
+{
+public:
+#ifndef PYPLUSPLUS
+	struct Vertex
+	{
+		/// Euter id of the population, which coincides with the vertex descriptor.
+		size_t population;
+		size_t size;
+		bool is_local;
+
+		template <typename Archiver>
+		void serialize(Archiver& ar, const unsigned int /* version */);
+	}; // Vertex
+
+	/// Projection view in order of its edge id.
+	struct Edge
+	{
+		size_t source;
+		size_t target;
+		/// Euter id of the projection.
+		size_t projection;
+		/// Index of the projection view in the flattened projection.
+		size_t view;
+		size_t num_sources;
+		size_t num_targets;
+		/// Synapses in CSR form, see \c SparseConnectivity.
+		std::vector<size_t> row_offsets;
+		std::vector<size_t> targets;
+		std::vector<double> weights;
+
+		template <typename Archiver>
+		void serialize(Archiver& ar, const unsigned int /* version */);
+	}; // Edge
+
+	typedef std::vector<Vertex> vertices_type;
+	typedef std::vector<Edge> edges_type;
+#endif // !PYPLUSPLUS
+
+	BioGraph();
+
+	bool empty() const;
+	void clear();
+
+	size_t num_vertices() const;
+	size_t num_edges() const;
+
+#ifndef PYPLUSPLUS
+	void add(Vertex const& vertex);
+	void add(Edge&& edge);
+
+	vertices_type const& vertices() const;
+	edges_type const& edges() const;
+
+private:
+	vertices_type m_vertices;
+	edges_type m_edges;
+#endif // !PYPLUSPLUS
+
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void serialize(Archiver& ar, const unsigned int /* version */);
+}; // BioGraph
+
+} // namespace results
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_KEY(::marocco::results::BioGraph)
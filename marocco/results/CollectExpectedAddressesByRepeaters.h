@@ -56,29 +56,34 @@ struct CollectExpectedAddressesByRepeaters : public boost::static_visitor<>
 				source_addresses_of_current_route.push_back(address->toL1Address());
 			}
 
-			auto const& route = route_item.route();
+			auto const route = route_item.segments();
 			apply(route.begin(), route.end());
 		}
 	}
 
-	void apply(marocco::L1Route::iterator it, marocco::L1Route::iterator const end)
+	template <typename Iterator>
+	void apply(Iterator it, Iterator const end)
 	{
 		auto next = std::next(it);
+		// Segments may be decoded on access, thus a window of copies is kept.
+		marocco::L1Route::segment_type current = *it;
 
 		while (next != end) {
-			if (auto const* hicann = boost::get<HMF::Coordinate::HICANNOnWafer>(&*it)) {
+			if (auto const* hicann = boost::get<HMF::Coordinate::HICANNOnWafer>(&current)) {
 				current_hicann = *hicann;
 			}
 
-			boost::apply_visitor(*this, *it, *next);
+			marocco::L1Route::segment_type const following = *next;
+			boost::apply_visitor(*this, current, following);
 
 			auto next_next = std::next(next);
 			if (next_next == end)
 				break;
 
-			boost::apply_visitor(*this, *it, *next, *next_next);
+			marocco::L1Route::segment_type const after_next = *next_next;
+			boost::apply_visitor(*this, current, following, after_next);
 
-			it = next;
+			current = following;
 			next = next_next;
 		}
 	}
@@ -1,6 +1,7 @@
 #include "marocco/results/Marocco.h"
 
-#include <unordered_set>
+#include <bitset>
+#include <tuple>
 
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/archive/binary_oarchive.hpp>
@@ -20,6 +21,101 @@ using namespace halco::hicann::v2;
 namespace marocco {
 namespace results {
 
+/**
+ * @brief Summary of placement and routing results for all HICANNs on the wafer.
+ */
+class HICANNOnWaferPropertiesIndex
+{
+public:
+	typedef std::tuple<size_t, size_t, size_t> revision_type;
+
+	explicit HICANNOnWaferPropertiesIndex(Marocco const& results);
+
+	revision_type const& revision() const;
+
+	HICANNOnWaferProperties properties(HICANNOnWafer const& hicann) const;
+
+	static revision_type revision_of(Marocco const& results);
+
+private:
+	struct Entry
+	{
+		Entry() : num_neurons(0), num_inputs(0), horizontal_buses(), vertical_buses() {}
+
+		size_t num_neurons;
+		/// Number of external inputs, i.e. addressed items without a neuron block.
+		size_t num_inputs;
+		std::bitset<HLineOnHICANN::size> horizontal_buses;
+		std::bitset<VLineOnHICANN::size> vertical_buses;
+	}; // Entry
+
+	revision_type m_revision;
+	typed_array<Entry, HICANNOnWafer> m_entries;
+}; // HICANNOnWaferPropertiesIndex
+
+HICANNOnWaferPropertiesIndex::HICANNOnWaferPropertiesIndex(Marocco const& results)
+	: m_revision(revision_of(results)), m_entries()
+{
+	for (auto const& item : results.placement) {
+		if (auto const& nb = item.neuron_block()) {
+			m_entries[nb->toHICANNOnWafer()].num_neurons += 1;
+		} else if (auto const& address = item.address()) {
+			m_entries[address->toDNCMergerOnWafer().toHICANNOnWafer()].num_inputs += 1;
+		}
+	}
+
+	// Record used buses for all HICANNs
+	for (auto const& item : results.l1_routing) {
+		Entry* current = nullptr;
+		for (auto const& segment : item.segments()) {
+			if (auto const* next_hicann = boost::get<HICANNOnWafer>(&segment)) {
+				current = &m_entries[*next_hicann];
+				continue;
+			}
+			if (current == nullptr) {
+				continue;
+			}
+
+			if (auto const* hline = boost::get<HLineOnHICANN>(&segment)) {
+				current->horizontal_buses.set(hline->toEnum());
+				continue;
+			}
+
+			if (auto const* vline = boost::get<VLineOnHICANN>(&segment)) {
+				current->vertical_buses.set(vline->toEnum());
+			}
+		}
+	}
+}
+
+auto HICANNOnWaferPropertiesIndex::revision_of(Marocco const& results) -> revision_type
+{
+	return revision_type{results.resources.revision(), results.placement.revision(),
+	                     results.l1_routing.revision()};
+}
+
+auto HICANNOnWaferPropertiesIndex::revision() const -> revision_type const&
+{
+	return m_revision;
+}
+
+HICANNOnWaferProperties HICANNOnWaferPropertiesIndex::properties(
+	HICANNOnWafer const& hicann) const
+{
+	auto const& entry = m_entries[hicann];
+
+	typed_array<size_t, SideHorizontal> num_vertical_buses{{0, 0}};
+	for (auto const vline : iter_all<VLineOnHICANN>()) {
+		if (entry.vertical_buses.test(vline.toEnum())) {
+			num_vertical_buses[vline.toSideHorizontal()] += 1;
+		}
+	}
+
+	return {entry.num_neurons, entry.num_inputs,
+	        entry.horizontal_buses.count(), num_vertical_buses[left],
+	        num_vertical_buses[right]};
+}
+
 Marocco Marocco::from_file(std::string const& filename)
 {
 	Marocco result;
@@ -77,7 +173,7 @@ void Marocco::save(std::string const& filename_, bool overwrite) const
 }
 
 template <typename Archiver>
-void Marocco::serialize(Archiver& ar, const unsigned int /* version */)
+void Marocco::serialize(Archiver& ar, const unsigned int version)
 {
 	using namespace boost::serialization;
 	// clang-format off
@@ -88,59 +184,28 @@ void Marocco::serialize(Archiver& ar, const unsigned int /* version */)
 	   & make_nvp("l1_routing", l1_routing)
 	   & make_nvp("synapse_routing", synapse_routing);
 	// clang-format on
+	if (version > 0) {
+		ar & make_nvp("bio_graph", bio_graph);
+	} else if (Archiver::is_loading::value) {
+		bio_graph.clear();
+	}
+	if (Archiver::is_loading::value) {
+		m_properties_index.reset();
+	}
 }
 
 HICANNOnWaferProperties Marocco::properties(halco::hicann::v2::HICANNOnWafer const& hicann) const
 {
-	// The current implementation is rather expensive... (rapid-prototyping)
-
 	if (!resources.has(hicann)) {
 		return {};
 	}
 
-	auto it = placement.find(hicann);
-	size_t const num_neurons = std::distance(it.begin(), it.end());
-
-	size_t num_injections = 0;
-	for (auto const dnc : iter_all<DNCMergerOnHICANN>()) {
-		auto it_ = placement.find(DNCMergerOnWafer(dnc, hicann));
-		num_injections += std::distance(it_.begin(), it_.end());
-	}
-
-	size_t const num_inputs = num_injections - num_neurons;
-
-	std::unordered_set<HLineOnHICANN> horizontal_buses;
-	std::unordered_set<VLineOnHICANN> vertical_buses;
-	typed_array<size_t, SideHorizontal> num_vertical_buses{{0, 0}};
-
-	// Record used buses on this HICANN
-	for (auto const& item : l1_routing) {
-		auto const& route = item.route();
-		HICANNOnWafer current_hicann;
-		for (auto const& segment : route) {
-			if (auto const* next_hicann = boost::get<HICANNOnWafer>(&segment)) {
-				current_hicann = *next_hicann;
-				continue;
-			}
-			if (current_hicann != hicann) {
-				continue;
-			}
-
-			if (auto const* hline = boost::get<HLineOnHICANN>(&segment)) {
-				horizontal_buses.insert(*hline);
-				continue;
-			}
-
-			if (auto const* vline = boost::get<VLineOnHICANN>(&segment)) {
-				if (vertical_buses.insert(*vline).second) {
-					num_vertical_buses[vline->toSideHorizontal()] += 1;
-				}
-			}
-		}
+	if (!m_properties_index ||
+	    m_properties_index->revision() != HICANNOnWaferPropertiesIndex::revision_of(*this)) {
+		m_properties_index = std::make_shared<HICANNOnWaferPropertiesIndex const>(*this);
 	}
 
-	return {num_neurons, num_inputs, horizontal_buses.size(), num_vertical_buses[left],
-			num_vertical_buses[right]};
+	return m_properties_index->properties(hicann);
 }
 
 HICANNOnWaferProperties::HICANNOnWaferProperties()
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <memory>
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 
 #include "halco/hicann/v2/hicann.h"
 #include "halco/common/relations.h"
@@ -9,6 +11,7 @@
 #include "marocco/parameter/results/AnalogOutputs.h"
 #include "marocco/parameter/results/SpikeTimes.h"
 #include "marocco/placement/results/Placement.h"
+#include "marocco/results/BioGraph.h"
 #include "marocco/results/Resources.h"
 #include "marocco/routing/results/L1Routing.h"
 #include "marocco/routing/results/SynapseRouting.h"
@@ -23,6 +26,9 @@ namespace marocco {
 namespace results {
 
 class HICANNOnWaferProperties;
+#ifndef PYPLUSPLUS
+class HICANNOnWaferPropertiesIndex;
+#endif // !PYPLUSPLUS
 
 /**
  * @brief Container used to store mapping results.
@@ -61,16 +67,33 @@ public:
 	routing::results::L1Routing l1_routing;
 	routing::results::SynapseRouting synapse_routing;
 
+	/**
+	 * @brief Bio graph of the mapped network, used to skip rebuilding it when mapping
+	 *        results are reused.
+	 * @note Empty for results written by older versions.
+	 */
+	BioGraph bio_graph;
+
 	/**
 	 * @brief Create an object representing overview properties of a single HICANN.
 	 * @param h Coordinate of the HICANN
+	 * @note On first use (and after every modification of the placement, routing or
+	 *       resources results) a summary of all HICANNs is built in a single pass over
+	 *       the results, subsequent calls are cheap lookups.
+	 *       Concurrent calls on the same object are not supported.
 	 */
 	HICANNOnWaferProperties properties(halco::hicann::v2::HICANNOnWafer const& hicann) const;
 
 private:
+#ifndef PYPLUSPLUS
+	/// Lazily built per-HICANN summary used by #properties().
+	/// Immutable once built, thus it can be shared between copies.
+	mutable std::shared_ptr<HICANNOnWaferPropertiesIndex const> m_properties_index;
+#endif // !PYPLUSPLUS
+
 	friend class boost::serialization::access;
 	template <typename Archiver>
-	void serialize(Archiver& ar, const unsigned int /* version */);
+	void serialize(Archiver& ar, const unsigned int version);
 }; // Marocco
 
 class HICANNOnWaferProperties
@@ -107,3 +130,4 @@ private:
 } // namespace marocco
 
 BOOST_CLASS_EXPORT_KEY(::marocco::results::Marocco)
+BOOST_CLASS_VERSION(::marocco::results::Marocco, 1)
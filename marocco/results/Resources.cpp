@@ -7,12 +7,20 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/set.hpp>
 
+#include "marocco/results/Revision.h"
+
 namespace marocco {
 namespace results {
 
+Resources::Resources() : m_available_hicanns(), m_revision(next_revision())
+{
+}
+
 void Resources::add(hicann_type const& hicann)
 {
-	m_available_hicanns.insert(hicann);
+	if (m_available_hicanns.insert(hicann).second) {
+		m_revision = next_revision();
+	}
 }
 
 bool Resources::has(hicann_type const& hicann) const
@@ -20,6 +28,11 @@ bool Resources::has(hicann_type const& hicann) const
 	return m_available_hicanns.find(hicann) != m_available_hicanns.end();
 }
 
+size_t Resources::revision() const
+{
+	return m_revision;
+}
+
 template <typename Archiver>
 void Resources::serialize(Archiver& ar, const unsigned int /* version */)
 {
@@ -27,6 +40,9 @@ void Resources::serialize(Archiver& ar, const unsigned int /* version */)
 	// clang-format off
 	ar & make_nvp("available_hicanns", m_available_hicanns);
 	// clang-format on
+	if (Archiver::is_loading::value) {
+		m_revision = next_revision();
+	}
 }
 
 } // namespace results
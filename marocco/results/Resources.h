@@ -23,11 +23,20 @@ class Resources
 	typedef halco::hicann::v2::HICANNOnWafer hicann_type;
 
 public:
+	Resources();
+
 	void add(hicann_type const& hicann);
 	bool has(hicann_type const& hicann) const;
 
+	/**
+	 * @brief Revision of the last modification, see \c next_revision().
+	 * @note This counter is not serialized.
+	 */
+	size_t revision() const;
+
 private:
 	std::set<hicann_type> m_available_hicanns;
+	size_t m_revision;
 
 	friend class boost::serialization::access;
 	template <typename Archiver>
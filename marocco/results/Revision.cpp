@@ -0,0 +1,15 @@
+#include "marocco/results/Revision.h"
+
+#include <atomic>
+
+namespace marocco {
+namespace results {
+
+size_t next_revision()
+{
+	static std::atomic<size_t> revision{0};
+	return ++revision;
+}
+
+} // namespace results
+} // namespace marocco
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+namespace marocco {
+namespace results {
+
+/**
+ * @brief Return a new revision number, unique within this process.
+ * Result containers store the revision of their last modification, so that data derived
+ * from them can be invalidated.  As revisions are never reused, this also detects
+ * containers being replaced by assignment.
+ */
+size_t next_revision();
+
+} // namespace results
+} // namespace marocco
@@ -2,39 +2,66 @@
 
 #include <sstream>
 #include <boost/variant/static_visitor.hpp>
+#include <tbb/parallel_for.h>
+
+#include "hal/Coordinate/iter_all.h"
 
 using marocco::L1Route;
+using marocco::routing::ConfigurationChanges;
 using namespace HMF::Coordinate;
 
 class ConfigureL1RouteVisitor : public boost::static_visitor<>
 {
-	sthal::Wafer& m_hardware;
+	ConfigurationChanges& m_changes;
 	HICANNOnWafer m_current_hicann;
 	bool m_enable_test_data_output;
 
-	sthal::HICANN& chip()
+	void output(
+		HICANNOnWafer const& hicann,
+		HRepeaterOnHICANN const& repeater,
+		SideHorizontal const& direction)
 	{
-		return m_hardware[m_current_hicann];
+		m_changes[hicann].horizontal_repeaters.push_back({repeater, direction, false});
 	}
 
-	sthal::HICANN& chip(HICANNOnWafer const& hicann)
+	void output(
+		HICANNOnWafer const& hicann,
+		VRepeaterOnHICANN const& repeater,
+		SideVertical const& direction)
 	{
-		return m_hardware[hicann];
+		m_changes[hicann].vertical_repeaters.push_back({repeater, direction, false});
+	}
+
+	void forward(
+		HICANNOnWafer const& hicann,
+		HRepeaterOnHICANN const& repeater,
+		SideHorizontal const& direction)
+	{
+		m_changes[hicann].horizontal_repeaters.push_back({repeater, direction, true});
+	}
+
+	void forward(
+		HICANNOnWafer const& hicann,
+		VRepeaterOnHICANN const& repeater,
+		SideVertical const& direction)
+	{
+		m_changes[hicann].vertical_repeaters.push_back({repeater, direction, true});
 	}
 
 public:
-	ConfigureL1RouteVisitor(sthal::Wafer& hw, HICANNOnWafer hicann)
-		: m_hardware(hw),
+	ConfigureL1RouteVisitor(ConfigurationChanges& changes, HICANNOnWafer hicann)
+		: m_changes(changes),
 		  m_current_hicann(std::move(hicann)),
 		  m_enable_test_data_output(false)
 	{
 	}
 
-	void apply(L1Route::iterator it, L1Route::iterator const end)
+	template <typename Iterator>
+	void apply(Iterator it, Iterator const end)
 	{
 		auto next = std::next(it);
 		for (; next != end; ++it, ++next) {
-			boost::apply_visitor(*this, *it, *next);
+			apply(*it, *next);
 		}
 	}
 
@@ -47,27 +74,25 @@ public:
 
 	void operator()(VLineOnHICANN const& current, HLineOnHICANN const& next)
 	{
-		chip().crossbar_switches.set(current, next, true);
+		m_changes[m_current_hicann].crossbar_switches.emplace_back(current, next);
 
 		if (m_enable_test_data_output) {
 			m_enable_test_data_output = false;
 			auto repeater = current.toVRepeaterOnHICANN();
 			auto direction = (repeater.toSideVertical() == top) ? bottom : top;
-			auto& repeater_config = chip(m_current_hicann).repeater[repeater];
-			repeater_config.setOutput(direction);
+			output(m_current_hicann, repeater, direction);
 		}
 	}
 
 	void operator()(HLineOnHICANN const& current, VLineOnHICANN const& next)
 	{
-		chip().crossbar_switches.set(next, current, true);
+		m_changes[m_current_hicann].crossbar_switches.emplace_back(next, current);
 
 		if (m_enable_test_data_output) {
 			m_enable_test_data_output = false;
 			auto repeater = current.toHRepeaterOnHICANN();
 			auto direction = (repeater.toSideHorizontal() == left) ? right : left;
-			auto& repeater_config = chip(m_current_hicann).repeater[repeater];
-			repeater_config.setOutput(direction);
+			output(m_current_hicann, repeater, direction);
 		}
 	}
 
@@ -75,14 +100,14 @@ public:
 
 	void operator()(DNCMergerOnHICANN const& current, HLineOnHICANN const& /*next*/)
 	{
-		chip().repeater[current.toSendingRepeaterOnHICANN().toHRepeaterOnHICANN()].setOutput(
-		    right, true);
+		auto repeater = current.toSendingRepeaterOnHICANN().toHRepeaterOnHICANN();
+		output(m_current_hicann, repeater, right);
 	}
 
 	void operator()(DNCMergerOnHICANN const& current, HICANNOnWafer const& next)
 	{
-		chip().repeater[current.toSendingRepeaterOnHICANN().toHRepeaterOnHICANN()].setOutput(
-		    left, true);
+		auto repeater = current.toSendingRepeaterOnHICANN().toHRepeaterOnHICANN();
+		output(m_current_hicann, repeater, left);
 
 		m_current_hicann = next;
 	}
@@ -113,12 +138,12 @@ public:
 			repeater = (direction == right ? current.east() : current.west()).toHRepeaterOnHICANN();
 		}
 
-		chip(hicann).repeater[repeater].setForwarding(direction);
+		forward(hicann, repeater, direction);
 
 		// Enable test output to current bus
 		if (m_enable_test_data_output) {
 			m_enable_test_data_output = false;
-			chip(m_current_hicann).repeater[current.toHRepeaterOnHICANN()].setOutput(direction);
+			output(m_current_hicann, current.toHRepeaterOnHICANN(), direction);
 		}
 
 		m_current_hicann = next;
@@ -136,12 +161,12 @@ public:
 			repeater = (direction == top ? current.north() : current.south()).toVRepeaterOnHICANN();
 		}
 
-		chip(hicann).repeater[repeater].setForwarding(direction);
+		forward(hicann, repeater, direction);
 
 		// Enable test output to current bus
 		if (m_enable_test_data_output) {
 			m_enable_test_data_output = false;
-			chip(m_current_hicann).repeater[current.toVRepeaterOnHICANN()].setOutput(direction);
+			output(m_current_hicann, current.toVRepeaterOnHICANN(), direction);
 		}
 
 		m_current_hicann = next;
@@ -168,13 +193,180 @@ public:
 namespace marocco {
 namespace routing {
 
+namespace {
+
+void configure_synapse_drivers(
+	sthal::HICANN& chip,
+	results::ConnectedSynapseDrivers const& connected_drivers,
+	results::SynapseRouting::HICANN const& result)
+{
+	auto const& drivers = connected_drivers.drivers();
+	if (drivers.empty()) {
+		return;
+	}
+
+	auto const& primary = connected_drivers.primary_driver();
+	auto end_piece = primary.isTop() ? *drivers.begin() : *drivers.rbegin();
+
+	// Set all drivers except for end piece to mirror mode.
+	// On the upper (lower) half of the HICANN, analog propagation of the L1 events between adjacent
+	// drivers is implemented via a `topin` (`bottomin`, because of mirroring) bit.  Thus all except
+	// the uppermost (lowermost) driver (“end piece”) have to be set to `mirror`.
+	// The `end_piece` driver is set to `listen`, as it should not have a connection to the next neighbor.
+	for (auto const& driver : drivers) {
+		chip.synapses[driver].set_mirror();
+	}
+	// This reverses the effect of `set_mirror()`.
+	chip.synapses[end_piece].set_listen();
+
+	// The driver receiving the L1 input needs an additional flag.
+	if (primary == end_piece) {
+		chip.synapses[primary].set_l1();
+	} else {
+		chip.synapses[primary].set_l1_mirror();
+	}
+
+	for (auto const& driver : drivers) {
+		auto& driver_config = chip.synapses[driver];
+		for (auto const row_on_driver : iter_all<RowOnSynapseDriver>()) {
+			auto const row = SynapseRowOnHICANN(driver, row_on_driver);
+			auto& row_config = driver_config[row_on_driver];
+
+			if (!result.has(row)) {
+				continue;
+			}
+
+			// make sure only one synaptic input is connected at a time.
+			row_config.set_syn_in(left, false);
+			row_config.set_syn_in(right, false);
+			row_config.set_syn_in(SideHorizontal(result[row].synaptic_input()), true);
+
+			// “decoder[0] is for left (even) synapses”
+			row_config.set_decoder(top, result[row].address(Parity::even));
+			row_config.set_decoder(bottom, result[row].address(Parity::odd));
+		}
+
+		if (!result.has(driver)) {
+			continue;
+		}
+
+		switch (result[driver].stp_mode()) {
+			case STPMode::off:
+				driver_config.disable_stp();
+				break;
+			case STPMode::depression:
+				driver_config.set_std();
+				break;
+			case STPMode::facilitation:
+				driver_config.set_stf();
+				break;
+		}
+	}
+}
+
+} // namespace
+
+size_t const ConfigurationChanges::npos;
+
+ConfigurationChanges::ConfigurationChanges() : m_hicanns(), m_changes(), m_index()
+{
+	m_index.fill(npos);
+}
+
+auto ConfigurationChanges::operator[](HICANNOnWafer const& hicann) -> HICANN&
+{
+	auto& index = m_index[hicann];
+	if (index == npos) {
+		index = m_changes.size();
+		m_hicanns.push_back(hicann);
+		m_changes.emplace_back();
+	}
+	return m_changes[index];
+}
+
+void ConfigurationChanges::apply(sthal::Wafer& hw) const
+{
+	// Accessing HICANNs of the wafer container may allocate them, which is not
+	// thread-safe.  Thus all affected chips are looked up beforehand.
+	std::vector<sthal::HICANN*> chips;
+	chips.reserve(m_hicanns.size());
+	for (auto const& hicann : m_hicanns) {
+		chips.push_back(&hw[hicann]);
+	}
+
+	tbb::parallel_for(size_t(0), m_hicanns.size(), [&](size_t const ii) {
+		auto& chip = *chips[ii];
+		auto const& changes = m_changes[ii];
+
+		for (auto const& item : changes.crossbar_switches) {
+			chip.crossbar_switches.set(item.first, item.second, true);
+		}
+
+		for (auto const& item : changes.horizontal_repeaters) {
+			if (item.forwarding) {
+				chip.repeater[item.repeater].setForwarding(item.direction);
+			} else {
+				chip.repeater[item.repeater].setOutput(item.direction);
+			}
+		}
+
+		for (auto const& item : changes.vertical_repeaters) {
+			if (item.forwarding) {
+				chip.repeater[item.repeater].setForwarding(item.direction);
+			} else {
+				chip.repeater[item.repeater].setOutput(item.direction);
+			}
+		}
+
+		for (auto const& item : changes.synapse_switches) {
+			chip.synapse_switches.set(
+				item.vline, item.driver.toSynapseSwitchRowOnHICANN().line(), true);
+		}
+
+		for (auto const& item : changes.synapse_drivers) {
+			configure_synapse_drivers(chip, *item.connected_drivers, *item.result);
+		}
+	});
+}
+
+std::vector<HICANNOnWafer> const& ConfigurationChanges::hicanns() const
+{
+	return m_hicanns;
+}
+
+bool ConfigurationChanges::empty() const
+{
+	return m_hicanns.empty();
+}
+
+void ConfigurationChanges::clear()
+{
+	m_hicanns.clear();
+	m_changes.clear();
+	m_index.fill(npos);
+}
+
 void configure(sthal::Wafer& hw, L1Route const& route)
 {
-	ConfigureL1RouteVisitor visitor(hw, route.source_hicann());
+	ConfigurationChanges changes;
+	configure(changes, route);
+	changes.apply(hw);
+}
+
+void configure(ConfigurationChanges& changes, L1Route const& route)
+{
+	ConfigureL1RouteVisitor visitor(changes, route.source_hicann());
+	visitor.apply(route.begin(), route.end());
+}
+
+void configure(
+	ConfigurationChanges& changes, results::L1RouteStore::segments_type const& route)
+{
+	ConfigureL1RouteVisitor visitor(changes, route.source_hicann());
 	visitor.apply(route.begin(), route.end());
 }
 
-void configure(sthal::Wafer& hw, L1RouteTree const& tree, ConfigureL1RouteVisitor& visitor)
+void configure(L1RouteTree const& tree, ConfigureL1RouteVisitor& visitor)
 {
 	auto const& route = tree.head();
 	visitor.apply(route.begin(), route.end());
@@ -189,14 +381,21 @@ void configure(sthal::Wafer& hw, L1RouteTree const& tree, ConfigureL1RouteVisito
 			++it;
 		}
 		copy.apply(route.back(), *it);
-		configure(hw, tail, copy);
+		configure(tail, copy);
 	}
 }
 
 void configure(sthal::Wafer& hw, L1RouteTree const& tree)
 {
-	ConfigureL1RouteVisitor visitor(hw, tree.head().source_hicann());
-	configure(hw, tree, visitor);
+	ConfigurationChanges changes;
+	configure(changes, tree);
+	changes.apply(hw);
+}
+
+void configure(ConfigurationChanges& changes, L1RouteTree const& tree)
+{
+	ConfigureL1RouteVisitor visitor(changes, tree.head().source_hicann());
+	configure(tree, visitor);
 }
 
 } // namespace routing
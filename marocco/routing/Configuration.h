@@ -1,12 +1,98 @@
 #pragma once
 
+#include <utility>
+#include <vector>
+
+#include "hal/Coordinate/typed_array.h"
 #include "sthal/Wafer.h"
 #include "marocco/coordinates/L1Route.h"
 #include "marocco/coordinates/L1RouteTree.h"
+#include "marocco/routing/results/L1RouteStore.h"
+#include "marocco/routing/results/SynapseRouting.h"
 
 namespace marocco {
 namespace routing {
 
+/**
+ * @brief Changes to the configuration of individual HICANNs, grouped by chip.
+ * Changes are recorded serially and later applied to a sthal container, where each HICANN
+ * is configured by a separate task.  Changes of the same kind to the same HICANN are
+ * applied in the order they were recorded.  Different kinds of changes modify disjoint
+ * parts of the chip configuration, so the result is the same as applying all changes in
+ * order.
+ */
+class ConfigurationChanges
+{
+public:
+	struct HorizontalRepeater
+	{
+		HMF::Coordinate::HRepeaterOnHICANN repeater;
+		HMF::Coordinate::SideHorizontal direction;
+		/// Forward events to the adjacent HICANN, else output events to the local bus.
+		bool forwarding;
+	}; // HorizontalRepeater
+
+	struct VerticalRepeater
+	{
+		HMF::Coordinate::VRepeaterOnHICANN repeater;
+		HMF::Coordinate::SideVertical direction;
+		/// Forward events to the adjacent HICANN, else output events to the local bus.
+		bool forwarding;
+	}; // VerticalRepeater
+
+	struct SynapseSwitch
+	{
+		HMF::Coordinate::VLineOnHICANN vline;
+		HMF::Coordinate::SynapseDriverOnHICANN driver;
+	}; // SynapseSwitch
+
+	/**
+	 * @brief Connection of adjacent synapse drivers and configuration of their rows.
+	 * @note The referenced results have to be kept alive until the changes are applied.
+	 */
+	struct SynapseDrivers
+	{
+		results::ConnectedSynapseDrivers const* connected_drivers;
+		results::SynapseRouting::HICANN const* result;
+	}; // SynapseDrivers
+
+	/// Changes to a single HICANN.
+	struct HICANN
+	{
+		std::vector<std::pair<HMF::Coordinate::VLineOnHICANN, HMF::Coordinate::HLineOnHICANN> >
+			crossbar_switches;
+		std::vector<HorizontalRepeater> horizontal_repeaters;
+		std::vector<VerticalRepeater> vertical_repeaters;
+		std::vector<SynapseSwitch> synapse_switches;
+		std::vector<SynapseDrivers> synapse_drivers;
+	}; // HICANN
+
+	ConfigurationChanges();
+
+	/// Return the changes to the given HICANN, which is added on first access.
+	HICANN& operator[](HMF::Coordinate::HICANNOnWafer const& hicann);
+
+	/**
+	 * @brief Apply all recorded changes, configuring different HICANNs in parallel.
+	 * HICANNs are allocated in the order of their first recorded change.
+	 */
+	void apply(sthal::Wafer& hw) const;
+
+	/// HICANNs with recorded changes, in order of their first change.
+	std::vector<HMF::Coordinate::HICANNOnWafer> const& hicanns() const;
+
+	bool empty() const;
+	void clear();
+
+private:
+	static size_t const npos = -1;
+
+	std::vector<HMF::Coordinate::HICANNOnWafer> m_hicanns;
+	std::vector<HICANN> m_changes;
+	/// Index into \c m_changes for each HICANN or \c npos.
+	HMF::Coordinate::typed_array<size_t, HMF::Coordinate::HICANNOnWafer> m_index;
+}; // ConfigurationChanges
+
 /**
  * @brief Configure sthal container to implement a given L1 route.
  * @note This does not check for configuration conflicts.
@@ -14,6 +100,19 @@ namespace routing {
  */
 void configure(sthal::Wafer& hw, L1Route const& route);
 
+/**
+ * @brief Record changes needed to implement a given L1 route.
+ * @see configure(sthal::Wafer&, L1Route const&)
+ */
+void configure(ConfigurationChanges& changes, L1Route const& route);
+
+/**
+ * @brief Record changes needed to implement a stored L1 route.
+ * @see configure(sthal::Wafer&, L1Route const&)
+ */
+void configure(
+	ConfigurationChanges& changes, results::L1RouteStore::segments_type const& route);
+
 /**
  * @brief Configure sthal container to implement the given L1 routes.
  * @note This does not check for configuration conflicts.
@@ -21,5 +120,11 @@ void configure(sthal::Wafer& hw, L1Route const& route);
  */
 void configure(sthal::Wafer& hw, L1RouteTree const& tree);
 
+/**
+ * @brief Record changes needed to implement the given L1 routes.
+ * @see configure(sthal::Wafer&, L1RouteTree const&)
+ */
+void configure(ConfigurationChanges& changes, L1RouteTree const& tree);
+
 } // namespace routing
 } // namespace marocco
@@ -1,6 +1,7 @@
 #include "marocco/routing/HICANNRouting.h"
 
 #include "marocco/routing/SynapseRouting.h"
+#include "marocco/util/trace.h"
 
 using namespace HMF::Coordinate;
 
@@ -41,6 +42,10 @@ void HICANNRouting::run(
 		return;
 	}
 
+	trace::Scope trace(
+		"synapse_routing", "routing",
+		{"hicann", std::int64_t(hicann.toHICANNOnWafer().toEnum().value())});
+
 	// synapse routing has to be run no matter there are routes ending at this
 	// chip or not, because we need the synapse target mapping for param trafo
 	SynapseRouting synapse_routing(
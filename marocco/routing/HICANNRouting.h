@@ -32,9 +32,11 @@ public:
 
 	void run(results::SynapseRouting& result);
 
-private:
+	/// Run synapse routing for a single HICANN.
 	void run(HMF::Coordinate::HICANNGlobal const& hicann, results::SynapseRouting& result);
 
+private:
+
 	BioGraph const& m_bio_graph;
 	hardware_type& m_hardware;
 	resource_manager_t& m_resource_manager;
@@ -1,5 +1,7 @@
 #include "marocco/routing/HandleSynapseLoss.h"
 
+#include <vector>
+
 #include "marocco/routing/SynapseLoss.h"
 #include "marocco/routing/util.h"
 
@@ -39,11 +41,13 @@ void HandleSynapseLoss::operator()(
 	auto const source = boost::source(projection, m_bio_graph.graph());
 	auto const target = boost::target(projection, m_bio_graph.graph());
 	auto const& proj_view = m_bio_graph.graph()[projection];
-	Connector::const_matrix_view_type const bio_weights = proj_view.getWeights();
+	auto const& connectivity = m_bio_graph.connectivity(projection);
 
 	SynapseLossProxy syn_loss_proxy =
 		m_synapse_loss->getProxy(projection, source_hicann, target_hicann);
 
+	// Relative indices of neurons of the target population placed to the current hicann.
+	std::vector<bool> on_target_hicann(connectivity.num_targets(), false);
 	for (auto const& target_item : m_neuron_placement.find(target)) {
 		auto neuron_block = target_item.neuron_block();
 		if (neuron_block == boost::none || neuron_block->toHICANNOnWafer() != target_hicann) {
@@ -56,33 +60,31 @@ void HandleSynapseLoss::operator()(
 			continue;
 		}
 
-		size_t const trg_neuron_in_proj_view = to_relative_index(
-			proj_view.post().mask(), target_item.neuron_index());
-
-		for (auto const& source_item : m_neuron_placement.find(source)) {
-			auto const& address = source_item.address();
-			// Only process source neuron placements matching current route.
-			if (address == boost::none ||
-				address->toDNCMergerOnWafer() != source_merger) {
-				continue;
-			}
+		on_target_hicann[to_relative_index(
+			proj_view.post().mask(), target_item.neuron_index())] = true;
+	}
 
-			if (!proj_view.pre().mask()[source_item.neuron_index()]) {
-				continue;
-			}
+	for (auto const& source_item : m_neuron_placement.find(source)) {
+		auto const& address = source_item.address();
+		// Only process source neuron placements matching current route.
+		if (address == boost::none ||
+			address->toDNCMergerOnWafer() != source_merger) {
+			continue;
+		}
 
-			size_t const src_neuron_in_proj_view = to_relative_index(
-				proj_view.pre().mask(), source_item.neuron_index());
+		if (!proj_view.pre().mask()[source_item.neuron_index()]) {
+			continue;
+		}
 
-			double const weight =
-				bio_weights(src_neuron_in_proj_view, trg_neuron_in_proj_view);
+		size_t const src_neuron_in_proj_view = to_relative_index(
+			proj_view.pre().mask(), source_item.neuron_index());
 
-			// Only record loss for synapses that were non-null to start with.
-			if (std::isnan(weight) || weight <= 0.) {
-				continue;
+		// Only record loss for synapses that were non-null to start with, which are
+		// exactly the ones contained in the sparse connectivity.
+		for (auto const& synapse : connectivity.targets(src_neuron_in_proj_view)) {
+			if (on_target_hicann[synapse.index]) {
+				syn_loss_proxy.addLoss(src_neuron_in_proj_view, synapse.index);
 			}
-
-			syn_loss_proxy.addLoss(src_neuron_in_proj_view, trg_neuron_in_proj_view);
 		}
 	}
 }
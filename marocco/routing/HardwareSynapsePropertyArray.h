@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "hal/Coordinate/HMFGeometry.h"
+#include "hal/HICANN/L1Address.h"
+#include "marocco/routing/STPMode.h"
+
+namespace marocco {
+namespace routing {
+
+typedef std::tuple<HMF::Coordinate::Side,
+                   HMF::Coordinate::Parity,
+                   HMF::HICANN::DriverDecoder,
+                   STPMode>
+	Side_Parity_Decoder_STP;
+
+/**
+ * @brief Fixed-size storage of one value per hardware synapse property.
+ * There are only 2 sides × 2 parities × 4 driver decoders × 3 STP modes = 48 hardware
+ * synapse properties.  They are enumerated in the lexicographic order of
+ * \c Side_Parity_Decoder_STP, so iteration visits them in the same order as for a
+ * \c std::map with this key type.  Unlike for the map, all properties are always
+ * present, i.e. default-constructed values take the role of missing entries.
+ */
+template <typename T>
+class HardwareSynapsePropertyArray
+{
+public:
+	typedef Side_Parity_Decoder_STP key_type;
+	typedef T mapped_type;
+	typedef std::pair<key_type, T const&> value_type;
+
+	static size_t const num_sides = 2;
+	static size_t const num_parities = 2;
+	static size_t const num_decoders = 4;
+	static size_t const num_stp_modes = 3;
+	static size_t const size = num_sides * num_parities * num_decoders * num_stp_modes;
+
+	static constexpr size_t to_index(size_t side, size_t parity, size_t decoder, size_t stp)
+	{
+		return ((side * num_parities + parity) * num_decoders + decoder) * num_stp_modes + stp;
+	}
+
+	static size_t to_index(key_type const& key)
+	{
+		return to_index(
+			std::get<0>(key).value(), std::get<1>(key).value(), std::get<2>(key).value(),
+			static_cast<size_t>(std::get<3>(key)));
+	}
+
+	static key_type to_key(size_t index)
+	{
+		if (index >= size) {
+			throw std::out_of_range("hardware synapse property index out of range");
+		}
+		size_t const stp = index % num_stp_modes;
+		index /= num_stp_modes;
+		size_t const decoder = index % num_decoders;
+		index /= num_decoders;
+		size_t const parity = index % num_parities;
+		size_t const side = index / num_parities;
+		return key_type(
+			HMF::Coordinate::Side(side), HMF::Coordinate::Parity(parity),
+			HMF::HICANN::DriverDecoder(decoder), static_cast<STPMode>(stp));
+	}
+
+	class const_iterator
+	{
+	public:
+		typedef std::forward_iterator_tag iterator_category;
+		typedef HardwareSynapsePropertyArray::value_type value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef void pointer;
+		typedef value_type reference;
+
+		const_iterator(HardwareSynapsePropertyArray const& array, size_t index)
+			: m_array(&array), m_index(index)
+		{
+		}
+
+		reference operator*() const
+		{
+			return value_type(to_key(m_index), m_array->m_values[m_index]);
+		}
+
+		const_iterator& operator++()
+		{
+			++m_index;
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator tmp(*this);
+			++m_index;
+			return tmp;
+		}
+
+		bool operator==(const_iterator const& other) const
+		{
+			return m_array == other.m_array && m_index == other.m_index;
+		}
+
+		bool operator!=(const_iterator const& other) const
+		{
+			return !(*this == other);
+		}
+
+	private:
+		HardwareSynapsePropertyArray const* m_array;
+		size_t m_index;
+	}; // const_iterator
+
+	HardwareSynapsePropertyArray() : m_values()
+	{
+	}
+
+	T& operator[](key_type const& key)
+	{
+		return m_values[to_index(key)];
+	}
+
+	T const& operator[](key_type const& key) const
+	{
+		return m_values[to_index(key)];
+	}
+
+	T const& at(key_type const& key) const
+	{
+		return m_values[to_index(key)];
+	}
+
+	T& at(size_t index)
+	{
+		return m_values.at(index);
+	}
+
+	T const& at(size_t index) const
+	{
+		return m_values.at(index);
+	}
+
+	/// Reset all values to their default.
+	void clear()
+	{
+		m_values.fill(T());
+	}
+
+	const_iterator begin() const
+	{
+		return const_iterator(*this, 0);
+	}
+
+	const_iterator end() const
+	{
+		return const_iterator(*this, size);
+	}
+
+private:
+	std::array<T, size> m_values;
+}; // HardwareSynapsePropertyArray
+
+template <typename T>
+size_t const HardwareSynapsePropertyArray<T>::num_sides;
+template <typename T>
+size_t const HardwareSynapsePropertyArray<T>::num_parities;
+template <typename T>
+size_t const HardwareSynapsePropertyArray<T>::num_decoders;
+template <typename T>
+size_t const HardwareSynapsePropertyArray<T>::num_stp_modes;
+template <typename T>
+size_t const HardwareSynapsePropertyArray<T>::size;
+
+/// Number of synapses or half synapse rows per hardware synapse property.
+typedef HardwareSynapsePropertyArray<size_t> SynapseHistogram;
+
+} // namespace routing
+} // namespace marocco
@@ -3,6 +3,7 @@
 #include "hal/Coordinate/geometry.h"
 #include "hal/Coordinate/iter_all.h"
 #include "marocco/util/iterable.h"
+#include "marocco/util/wafer_topology.h"
 
 using namespace HMF::Coordinate;
 
@@ -44,19 +45,15 @@ bool L1GraphWalker::step(vertex_descriptor& vertex, Direction const& direction)
 			"orientation of vertex does not allow specified direction");
 	}
 
-	HICANNOnWafer destination;
-	try {
-		destination = m_graph[vertex].toHICANNOnWafer().move(direction);
-	} catch (std::overflow_error const&) {
-		// reached bound of wafer, other HICANN does not exist
-		return false;
-	} catch (std::domain_error const&) {
-		// invalid combination of X and Y (can happen because wafer is round)
+	auto const destination =
+		wafer_topology::neighbor(m_graph[vertex].toHICANNOnWafer(), direction);
+	if (!destination) {
+		// reached border of wafer, other HICANN does not exist
 		return false;
 	}
 
 	for (auto other : make_iterable(boost::adjacent_vertices(vertex, m_graph))) {
-		if (m_graph[other].toHICANNOnWafer() != destination) {
+		if (m_graph[other].toHICANNOnWafer() != *destination) {
 			continue;
 		}
 
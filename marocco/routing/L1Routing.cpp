@@ -10,6 +10,8 @@
 #include "marocco/routing/internal/SynapseTargetMapping.h"
 #include "marocco/routing/results/SynapticInputs.h"
 #include "marocco/util/algorithm.h"
+#include "marocco/util/trace.h"
+#include "marocco/util/wafer_topology.h"
 
 using namespace HMF::Coordinate;
 
@@ -38,10 +40,18 @@ L1Routing::L1Routing(
 	  m_bio_graph(bio_graph),
 	  m_parameters(parameters),
 	  m_neuron_placement(neuron_placement),
-	  m_result(result)
+	  m_result(result),
+	  m_failed(),
+	  m_deadline(),
+	  m_skipped(0)
 {
 }
 
+void L1Routing::deadline(std::chrono::steady_clock::time_point value)
+{
+	m_deadline = value;
+}
+
 std::vector<DNCMergerOnWafer> L1Routing::sources_sorted_by_priority() const
 {
 	typedef parameters::L1Routing::projection_type projection_type;
@@ -129,7 +139,7 @@ L1Routing::targets_for_source(DNCMergerOnWafer const& merger) const
 		results::SynapticInputs synaptic_inputs;
 		internal::SynapseTargetMapping::simple_mapping(it->first, m_neuron_placement, graph, synaptic_inputs);
 		SynapseDriverRequirements requirements(it->first, m_neuron_placement, synaptic_inputs);
-		auto const num = requirements.calc(merger, graph);
+		auto const num = requirements.calc(merger, m_bio_graph);
 
 		if (num.first == 0u) {
 			it = result.erase(it);
@@ -153,6 +163,12 @@ void L1Routing::run()
 		default:
 			throw std::runtime_error("unknown routing algorithm");
 	}
+
+	if (m_skipped != 0) {
+		MAROCCO_WARN(
+			"L1 routing deadline passed, routes from " << m_skipped
+			<< " DNC merger(s) were not considered");
+	}
 }
 
 void L1Routing::run_backbone_router()
@@ -198,6 +214,9 @@ void L1Routing::run_backbone_router()
 		auto const source = m_l1_graph[merger.toHICANNOnWafer()]
 		                              [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
 		auto const targets = targets_for_source(merger);
+		if (skip_after_deadline(merger, targets)) {
+			continue;
+		}
 
 		MAROCCO_TRACE("routing from " << merger << " to " << targets.size() << " targets");
 
@@ -241,9 +260,17 @@ void L1Routing::run_dijkstra_router()
 		auto const source = m_l1_graph[merger.toHICANNOnWafer()]
 		                              [merger.toSendingRepeaterOnHICANN().toHLineOnHICANN()];
 		auto const targets = targets_for_source(merger);
+		if (skip_after_deadline(merger, targets)) {
+			continue;
+		}
 
 		MAROCCO_TRACE("routing from " << merger << " to " << targets.size() << " targets");
 
+		trace::Scope trace(
+			"dijkstra", "routing",
+			{"hicann", std::int64_t(merger.toHICANNOnWafer().toEnum().value())},
+			{"merger", std::int64_t(merger.toDNCMergerOnHICANN().value())});
+
 		L1DijkstraRouter dijkstra(weights, source);
 
 		for (auto const& target : targets) {
@@ -271,6 +298,20 @@ void L1Routing::run_dijkstra_router()
 	}
 }
 
+bool L1Routing::skip_after_deadline(
+	DNCMergerOnWafer const& merger, targets_type const& targets)
+{
+	if (!m_deadline || std::chrono::steady_clock::now() < *m_deadline) {
+		return false;
+	}
+
+	for (auto const& target : targets) {
+		m_failed.push_back(request_type{merger, target.first, target.second});
+	}
+	++m_skipped;
+	return true;
+}
+
 bool L1Routing::store_result(
 	request_type const& request,
     L1RoutingGraph::vertex_descriptor const source,
@@ -357,15 +398,10 @@ L1Route with_dnc_merger_prefix(L1Route const& route, DNCMergerOnWafer const& mer
 	auto it = result.begin();
 	std::advance(it, 2);
 	if (auto const* next_hicann = boost::get<HICANNOnWafer>(&*it)) {
-		try {
-			if (*next_hicann == hicann.west()) {
-				// Strip the leading [HICANNOnWafer, HLineOnWafer] segments.
-				result = result.split(it).second;
-			}
-		} catch (std::overflow_error const&) {
-			// reached bound of wafer, other HICANN does not exist
-		} catch (std::domain_error const&) {
-			// invalid combination of X and Y (can happen because wafer is round)
+		auto const left = wafer_topology::neighbor(hicann, west);
+		if (left && *next_hicann == *left) {
+			// Strip the leading [HICANNOnWafer, HLineOnWafer] segments.
+			result = result.split(it).second;
 		}
 	}
 
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <chrono>
 #include <set>
 #include <unordered_map>
 #include <vector>
+#include <boost/optional.hpp>
 
 #include "hal/Coordinate/L1.h"
 
@@ -37,6 +39,12 @@ public:
 		placement::results::Placement const& neuron_placement,
 		results::L1Routing& result);
 
+	/**
+	 * @brief Stop routing from further DNC mergers after the given point in time.
+	 * Routes from mergers that were not considered are reported as failed.
+	 */
+	void deadline(std::chrono::steady_clock::time_point value);
+
 	/**
 	 * @brief Run routing algorithm.
 	 * @note This modifies the L1 graph.
@@ -64,12 +72,21 @@ private:
 	    L1RoutingGraph::vertex_descriptor const source,
 	    PathBundle::path_type const& path);
 
+	/**
+	 * @brief Checks whether the deadline has passed and marks all routes to the given
+	 *        targets as failed if this is the case.
+	 */
+	bool skip_after_deadline(
+		HMF::Coordinate::DNCMergerOnWafer const& merger, targets_type const& targets);
+
 	L1RoutingGraph& m_l1_graph;
 	BioGraph const& m_bio_graph;
 	parameters::L1Routing const& m_parameters;
 	placement::results::Placement const& m_neuron_placement;
 	results::L1Routing& m_result;
 	std::vector<request_type> m_failed;
+	boost::optional<std::chrono::steady_clock::time_point> m_deadline;
+	size_t m_skipped;
 }; // L1Routing
 
 /**
@@ -4,6 +4,7 @@
 #include "hal/Coordinate/iter_all.h"
 #include "hal/HICANN/Crossbar.h"
 #include "marocco/routing/PathBundle.h"
+#include "marocco/util/wafer_topology.h"
 
 namespace marocco {
 namespace routing {
@@ -99,28 +100,28 @@ auto L1RoutingGraph::operator[](value_type bus) const -> vertex_descriptor
 template <typename LineT>
 bool L1RoutingGraph::connect(
 	HICANNOnWafer const& hicann,
-	HICANNOnWafer (HICANNOnWafer::*conv)() const,
+	Direction const& direction,
 	LineT (LineT::*line_conv)() const)
 {
-	try {
-		HICANN const& current = m_hicanns.at(hicann);
-		HICANN const& other = m_hicanns.at((hicann.*conv)());
-
-		for (auto line : iter_all<LineT>()) {
-			auto other_line = (line.*line_conv)();
-			add_edge(current[line], other[other_line], m_graph);
-		}
+	auto const other_hicann = wafer_topology::neighbor(hicann, direction);
+	if (!other_hicann) {
+		// reached border of wafer, other HICANN does not exist
+		return false;
+	}
 
-		return true;
-	} catch (std::out_of_range const&) {
+	auto const current = m_hicanns.find(hicann);
+	auto const other = m_hicanns.find(*other_hicann);
+	if (current == m_hicanns.end() || other == m_hicanns.end()) {
 		// HICANN not present in L1RoutingGraph
-	} catch (std::overflow_error const&) {
-		// reached bound of wafer, other HICANN does not exist
-	} catch (std::domain_error const&) {
-		// invalid combination of X and Y (can happen because wafer is round)
+		return false;
 	}
 
-	return false;
+	for (auto line : iter_all<LineT>()) {
+		auto other_line = (line.*line_conv)();
+		add_edge(current->second[line], other->second[other_line], m_graph);
+	}
+
+	return true;
 }
 
 void L1RoutingGraph::add(HICANNOnWafer const& hicann, bool const shuffle_switches)
@@ -135,10 +136,10 @@ void L1RoutingGraph::add(HICANNOnWafer const& hicann, bool const shuffle_switche
 	}
 
 	// Try to connect this HICANN to surrounding HICANNs.
-	connect(hicann, &HICANNOnWafer::north, &VLineOnHICANN::north);
-	connect(hicann, &HICANNOnWafer::east, &HLineOnHICANN::east);
-	connect(hicann, &HICANNOnWafer::south, &VLineOnHICANN::south);
-	connect(hicann, &HICANNOnWafer::west, &HLineOnHICANN::west);
+	connect(hicann, north, &VLineOnHICANN::north);
+	connect(hicann, east, &HLineOnHICANN::east);
+	connect(hicann, south, &VLineOnHICANN::south);
+	connect(hicann, west, &HLineOnHICANN::west);
 }
 
 void L1RoutingGraph::remove(PathBundle const& bundle)
@@ -171,12 +172,16 @@ void L1RoutingGraph::remove(
 {
 	auto hline = hrep.toHLineOnHICANN();
 	auto side = hrep.toSideHorizontal();
-	auto other_hicann = side == right ? hicann.east() : hicann.west();
+	auto other_hicann = wafer_topology::neighbor(hicann, side == right ? east : west);
 	auto other_hline = side == right ? hline.east() : hline.west();
 
 	auto vertex = operator[](hicann)[hline];
 
-	auto it = m_hicanns.find(other_hicann);
+	if (!other_hicann) {
+		return;
+	}
+
+	auto it = m_hicanns.find(*other_hicann);
 	if (it == m_hicanns.end()) {
 		return;
 	}
@@ -190,12 +195,16 @@ void L1RoutingGraph::remove(
 {
 	auto vline = vrep.toVLineOnHICANN();
 	auto side = vrep.toSideVertical();
-	auto other_hicann = side == top ? hicann.north() : hicann.south();
+	auto other_hicann = wafer_topology::neighbor(hicann, side == top ? north : south);
 	auto other_vline = side == top ? vline.north() : vline.south();
 
 	auto vertex = operator[](hicann)[vline];
 
-	auto it = m_hicanns.find(other_hicann);
+	if (!other_hicann) {
+		return;
+	}
+
+	auto it = m_hicanns.find(*other_hicann);
 	if (it == m_hicanns.end()) {
 		return;
 	}
@@ -7,6 +7,7 @@
 #include <unordered_map>
 
 #include "hal/Coordinate/HICANN.h"
+#include "hal/Coordinate/geometry.h"
 #include "hal/Coordinate/L1.h"
 #include "hal/Coordinate/typed_array.h"
 #include "marocco/routing/L1BusOnWafer.h"
@@ -86,7 +87,7 @@ private:
 	template <typename LineT>
 	bool connect(
 		HMF::Coordinate::HICANNOnWafer const& hicann,
-		HMF::Coordinate::HICANNOnWafer (HMF::Coordinate::HICANNOnWafer::*conv)() const,
+		HMF::Coordinate::Direction const& direction,
 		LineT (LineT::*line_conv)() const);
 
 	graph_type m_graph;
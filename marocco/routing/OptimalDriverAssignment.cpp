@@ -0,0 +1,390 @@
+#include "marocco/routing/OptimalDriverAssignment.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+#include "hal/Coordinate/Quadrant.h"
+#include "marocco/Logger.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+size_t const drivers_per_quadrant = SynapseDriverOnQuadrant::size;
+size_t const drivers_per_side = drivers_per_quadrant * SideVertical::end;
+
+int const free_driver = -1;
+int const defect_driver = -2;
+
+double const epsilon = 1e-9;
+
+size_t to_index(SynapseDriverOnHICANN const& driver)
+{
+	return driver.toSideVertical().value() * drivers_per_quadrant +
+	       driver.toSynapseDriverOnQuadrant().value();
+}
+
+struct Route
+{
+	VLineOnHICANN line;
+	double synapses;
+	/// Number of drivers needed to realize all synapses.
+	double requested;
+	/// Maximum number of drivers that may be assigned.
+	size_t max_drivers;
+	/// Reachable drivers, see \c to_index().
+	std::vector<size_t> primaries;
+
+	double value(size_t drivers) const
+	{
+		return synapses * drivers / requested;
+	}
+
+	double density() const
+	{
+		return synapses / requested;
+	}
+};
+
+/// Chain of drivers [begin, end) around a primary driver, see \c to_index().
+struct Chain
+{
+	size_t primary;
+	size_t begin;
+	size_t end;
+	/// Number of free drivers surrounding the primary driver.
+	size_t gap;
+
+	size_t size() const
+	{
+		return end - begin;
+	}
+};
+
+class Search
+{
+public:
+	typedef std::chrono::steady_clock clock_type;
+
+	Search(
+		std::vector<Route> const& routes,
+		std::array<int, drivers_per_side> const& drivers,
+		clock_type::time_point deadline)
+		: m_routes(routes),
+		  m_drivers(drivers),
+		  m_free(std::count(drivers.begin(), drivers.end(), free_driver)),
+		  m_deadline(deadline),
+		  m_aborted(false),
+		  m_nodes(0),
+		  m_current(routes.size()),
+		  m_best(),
+		  m_best_value(0.)
+	{
+		for (size_t ii = 0; ii < m_routes.size(); ++ii) {
+			m_by_density.push_back(ii);
+		}
+		std::stable_sort(
+			m_by_density.begin(), m_by_density.end(), [this](size_t lhs, size_t rhs) {
+				return m_routes[lhs].density() > m_routes[rhs].density();
+			});
+	}
+
+	/// Upper bound on the value achievable for routes starting at \c index.
+	double bound(size_t index) const
+	{
+		double result = 0.;
+		size_t capacity = m_free;
+		for (auto const ii : m_by_density) {
+			if (capacity == 0) {
+				break;
+			}
+			if (ii < index) {
+				continue;
+			}
+			size_t const take = std::min(m_routes[ii].max_drivers, capacity);
+			result += m_routes[ii].density() * take;
+			capacity -= take;
+		}
+		return result;
+	}
+
+	/**
+	 * @brief Search for an assignment better than the given value.
+	 * @return Whether a better assignment was found.
+	 */
+	bool run(double incumbent)
+	{
+		m_best_value = incumbent;
+		m_best.clear();
+		visit(0, 0.);
+		return !m_best.empty();
+	}
+
+	bool aborted() const
+	{
+		return m_aborted;
+	}
+
+	double best_value() const
+	{
+		return m_best_value;
+	}
+
+	/// Chains of the best assignment, chains of size zero denote rejected routes.
+	std::vector<Chain> const& best() const
+	{
+		return m_best;
+	}
+
+private:
+	void visit(size_t const index, double const value)
+	{
+		if (m_aborted) {
+			return;
+		}
+
+		if ((++m_nodes & 0x3ff) == 0 && clock_type::now() > m_deadline) {
+			m_aborted = true;
+			return;
+		}
+
+		if (index == m_routes.size()) {
+			if (value > m_best_value + epsilon) {
+				m_best_value = value;
+				m_best = m_current;
+			}
+			return;
+		}
+
+		if (value + bound(index) <= m_best_value + epsilon) {
+			return;
+		}
+
+		auto const& route = m_routes[index];
+		for (auto const& chain : options(route)) {
+			std::fill(m_drivers.begin() + chain.begin, m_drivers.begin() + chain.end, int(index));
+			m_free -= chain.size();
+			m_current[index] = chain;
+
+			visit(index + 1, value + route.value(chain.size()));
+
+			std::fill(m_drivers.begin() + chain.begin, m_drivers.begin() + chain.end, free_driver);
+			m_free += chain.size();
+		}
+
+		// Reject route.
+		m_current[index] = Chain{0, 0, 0, 0};
+		visit(index + 1, value);
+	}
+
+	/// Possible chains for the given route, most promising first.
+	std::vector<Chain> options(Route const& route) const
+	{
+		std::vector<Chain> result;
+		for (auto const primary : route.primaries) {
+			if (m_drivers[primary] != free_driver) {
+				continue;
+			}
+
+			size_t const quadrant_begin = primary - primary % drivers_per_quadrant;
+			size_t const quadrant_end = quadrant_begin + drivers_per_quadrant;
+			size_t gap_begin = primary;
+			while (gap_begin > quadrant_begin && m_drivers[gap_begin - 1] == free_driver) {
+				--gap_begin;
+			}
+			size_t gap_end = primary + 1;
+			while (gap_end < quadrant_end && m_drivers[gap_end] == free_driver) {
+				++gap_end;
+			}
+			size_t const gap = gap_end - gap_begin;
+
+			for (size_t length = 1; length <= std::min(route.max_drivers, gap); ++length) {
+				// Chain ending at the primary driver or starting at the gap.
+				size_t const first = std::max(gap_begin, primary + 1 - length);
+				// Chain starting at the primary driver or ending at the gap.
+				size_t const last = std::min(primary, gap_end - length);
+				for (auto const begin : {first, last}) {
+					auto const end = begin + length;
+					bool const duplicate =
+						std::any_of(result.begin(), result.end(), [=](Chain const& chain) {
+							return chain.begin == begin && chain.end == end;
+						});
+					if (!duplicate) {
+						result.push_back(Chain{primary, begin, end, gap});
+					}
+				}
+			}
+		}
+
+		// Prefer long chains in small gaps.
+		std::sort(result.begin(), result.end(), [](Chain const& lhs, Chain const& rhs) {
+			if (lhs.size() != rhs.size()) {
+				return lhs.size() > rhs.size();
+			} else if (lhs.gap != rhs.gap) {
+				return lhs.gap < rhs.gap;
+			}
+			return lhs.begin < rhs.begin;
+		});
+		return result;
+	}
+
+	std::vector<Route> const& m_routes;
+	std::array<int, drivers_per_side> m_drivers;
+	size_t m_free;
+	clock_type::time_point const m_deadline;
+	bool m_aborted;
+	size_t m_nodes;
+
+	/// Indices of routes in order of decreasing synapses per requested driver.
+	std::vector<size_t> m_by_density;
+
+	std::vector<Chain> m_current;
+	std::vector<Chain> m_best;
+	double m_best_value;
+}; // Search
+
+} // namespace
+
+OptimalDriverAssignment::OptimalDriverAssignment(
+	IntervalList const& list,
+	HMF::Coordinate::Side const& side,
+	size_t const max_chain_length,
+	std::vector<SynapseDriverOnHICANN> const& defects,
+	std::chrono::duration<double> const time_budget)
+	: mResult(), mRejected(), mRealizedSynapses(0.), mUpperBound(0.), mOptimal(false)
+{
+	auto const deadline =
+		Search::clock_type::now() +
+		std::chrono::duration_cast<Search::clock_type::duration>(time_budget);
+	SideHorizontal const side_horizontal = side;
+
+	// The heuristic solution serves as initial lower bound.
+	{
+		Fieres fieres(list, side, max_chain_length, defects);
+		mResult = fieres.result();
+		mRejected = fieres.rejected();
+		mRealizedSynapses = realized_synapses(list, mResult);
+	}
+
+	std::array<int, drivers_per_side> drivers;
+	drivers.fill(free_driver);
+	for (auto const& driver : defects) {
+		if (driver.toSideHorizontal() == side_horizontal) {
+			drivers[to_index(driver)] = defect_driver;
+		}
+	}
+
+	std::vector<Route> routes;
+	for (auto const& entry : list) {
+		Route route;
+		route.line = entry.line;
+		route.synapses = entry.synapses;
+		route.requested = entry.driver;
+		route.max_drivers = std::min(max_chain_length, entry.driver);
+		for (auto const& driver : entry.line.toSynapseDriverOnHICANN(side_horizontal)) {
+			route.primaries.push_back(to_index(driver));
+		}
+		if (route.requested == 0 || route.max_drivers == 0) {
+			throw std::runtime_error("assignment error");
+		}
+		routes.push_back(route);
+	}
+
+	// Decide on routes with many synapses first, sort by VLine to have a deterministic result.
+	std::sort(routes.begin(), routes.end(), [](Route const& lhs, Route const& rhs) {
+		if (lhs.synapses != rhs.synapses) {
+			return lhs.synapses > rhs.synapses;
+		}
+		return lhs.line < rhs.line;
+	});
+
+	Search search(routes, drivers, deadline);
+	mUpperBound = search.bound(0);
+
+	if (search.run(mRealizedSynapses)) {
+		mResult.clear();
+		mRejected.clear();
+		mRealizedSynapses = search.best_value();
+
+		auto const& chains = search.best();
+		for (size_t ii = 0; ii < routes.size(); ++ii) {
+			auto const& chain = chains[ii];
+			if (chain.size() == 0) {
+				mRejected.push_back(routes[ii].line);
+				continue;
+			}
+
+			QuadrantOnHICANN const quadrant{
+				SideVertical(chain.primary / drivers_per_quadrant), side_horizontal};
+			results::ConnectedSynapseDrivers connected(
+				SynapseDriverOnQuadrant(chain.primary % drivers_per_quadrant)
+					.toSynapseDriverOnHICANN(quadrant));
+			connected.connect(SynapseDriverOnQuadrant(chain.begin % drivers_per_quadrant));
+			connected.connect(SynapseDriverOnQuadrant((chain.end - 1) % drivers_per_quadrant));
+			mResult[routes[ii].line].push_back(connected);
+		}
+	}
+
+	mOptimal = !search.aborted();
+
+	MAROCCO_DEBUG(
+		"Synapse driver assignment on " << side_horizontal << " realizes " << mRealizedSynapses
+		<< " of at most " << mUpperBound << " synapses"
+		<< (mOptimal ? "" : ", time budget exhausted"));
+}
+
+auto OptimalDriverAssignment::result() const -> Result
+{
+	return mResult;
+}
+
+auto OptimalDriverAssignment::rejected() const -> Rejected
+{
+	return mRejected;
+}
+
+double OptimalDriverAssignment::realized_synapses() const
+{
+	return mRealizedSynapses;
+}
+
+double OptimalDriverAssignment::upper_bound() const
+{
+	return mUpperBound;
+}
+
+bool OptimalDriverAssignment::optimal() const
+{
+	return mOptimal;
+}
+
+double OptimalDriverAssignment::realized_synapses(IntervalList const& list, Result const& result)
+{
+	std::unordered_map<VLineOnHICANN, DriverInterval const*> requests;
+	for (auto const& entry : list) {
+		requests[entry.line] = &entry;
+	}
+
+	double realized = 0.;
+	for (auto const& item : result) {
+		auto it = requests.find(item.first);
+		if (it == requests.end() || it->second->driver == 0) {
+			continue;
+		}
+
+		size_t assigned = 0;
+		for (auto const& connected : item.second) {
+			assigned += connected.size();
+		}
+		auto const& request = *it->second;
+		realized += double(request.synapses) * std::min(assigned, request.driver) / request.driver;
+	}
+	return realized;
+}
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "marocco/routing/Fieres.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Synapse driver assignment maximizing the number of realized synapses.
+ * Incoming routes are assigned chains of adjacent synapse drivers around one of the
+ * drivers reachable from their vertical bus, honoring the maximum chain length and
+ * defect drivers.  The number of realized synapses of a route is estimated to be
+ * proportional to the fraction of requested drivers it is assigned.
+ *
+ * A depth-first branch and bound search over the possible chains of each route is
+ * performed, starting from the assignment found by \c Fieres as the initial solution.
+ * Chains are either aligned to the primary driver or to the border of the surrounding
+ * gap of free drivers.  The search is bounded by a fractional knapsack relaxation over
+ * the number of free drivers.  If the time budget is exhausted, the best assignment found
+ * so far is returned.
+ */
+class OptimalDriverAssignment
+{
+public:
+	typedef Fieres::IntervalList IntervalList;
+	typedef Fieres::Result Result;
+	typedef Fieres::Rejected Rejected;
+
+	OptimalDriverAssignment(
+		IntervalList const& list,
+		HMF::Coordinate::Side const& side,
+		size_t max_chain_length,
+		std::vector<HMF::Coordinate::SynapseDriverOnHICANN> const& defect,
+		std::chrono::duration<double> time_budget);
+
+	Result result() const;
+	Rejected rejected() const;
+
+	/// Estimated number of synapses realized by the returned assignment.
+	double realized_synapses() const;
+
+	/// Upper bound on the number of synapses that can be realized, ignoring topology.
+	double upper_bound() const;
+
+	/// Whether the search finished within the time budget.
+	bool optimal() const;
+
+	/**
+	 * @brief Estimated number of synapses realized by the given assignment.
+	 * Can be used to compare the results of different assignment algorithms.
+	 */
+	static double realized_synapses(IntervalList const& list, Result const& result);
+
+private:
+	Result mResult;
+	Rejected mRejected;
+	double mRealizedSynapses;
+	double mUpperBound;
+	bool mOptimal;
+}; // OptimalDriverAssignment
+
+} // namespace routing
+} // namespace marocco
@@ -11,6 +11,7 @@
 #include "marocco/routing/L1Routing.h"
 #include "marocco/routing/SynapseLoss.h"
 #include "marocco/routing/SynapseRoutingConfigurator.h"
+#include "marocco/util/stage_timer.h"
 
 #include <boost/make_shared.hpp>
 
@@ -29,18 +30,27 @@ Routing::Routing(
 	  m_hardware(hardware),
 	  m_resource_manager(resource_manager),
 	  m_pymarocco(pymarocco),
-	  m_neuron_placement(neuron_placement)
+	  m_neuron_placement(neuron_placement),
+	  m_synapse_loss(),
+	  m_deadline()
 {
 }
 
+void Routing::deadline(std::chrono::steady_clock::time_point value)
+{
+	m_deadline = value;
+}
+
 void Routing::run(results::L1Routing& l1_routing_result, results::SynapseRouting& synapse_routing_result)
 {
-	m_synapse_loss = boost::make_shared<SynapseLoss>(m_graph.graph());
+	m_synapse_loss = boost::make_shared<SynapseLoss>(m_graph);
 
 	{
+		StageTimer timer(m_pymarocco.getStats(), "l1_routing");
 		L1RoutingGraph l1_graph;
 
 		MAROCCO_INFO("Setting up L1 routing graph");
+		StageTimer graph_timer(m_pymarocco.getStats(), "graph");
 		bool const shuffle_switches = m_pymarocco.l1_routing.shuffle_switches();
 		for (auto const& hicann : m_resource_manager.present()) {
 			l1_graph.add(hicann, shuffle_switches);
@@ -77,8 +87,13 @@ void Routing::run(results::L1Routing& l1_routing_result, results::SynapseRouting
 			}
 		}
 
+		graph_timer.stop();
+
 		L1Routing l1_routing(
 		    l1_graph, m_graph, m_pymarocco.l1_routing, m_neuron_placement, l1_routing_result);
+		if (m_deadline) {
+			l1_routing.deadline(*m_deadline);
+		}
 		l1_routing.run();
 		MAROCCO_INFO("L1 routing finished with " << l1_routing_result.size() << " routes");
 
@@ -100,17 +115,33 @@ void Routing::run(results::L1Routing& l1_routing_result, results::SynapseRouting
 	}
 
 	MAROCCO_INFO("Configuring L1 routes");
+	StageTimer l1_configuration_timer(m_pymarocco.getStats(), "l1_configuration");
 	auto& wafer_config = m_hardware;
-	for (auto const& item : l1_routing_result) {
-		configure(wafer_config, item.route());
+	{
+		// Changes are grouped by HICANN, so that chips can be configured in parallel.
+		ConfigurationChanges changes;
+		for (auto const& item : l1_routing_result) {
+			configure(changes, item.segments());
+		}
+		changes.apply(wafer_config);
 	}
+	l1_configuration_timer.stop();
 
+	StageTimer synapse_routing_timer(m_pymarocco.getStats(), "synapse_routing");
 	HICANNRouting local_router(
 		m_graph, wafer_config, m_resource_manager, m_pymarocco, m_neuron_placement,
 		l1_routing_result, m_synapse_loss);
-	local_router.run(synapse_routing_result);
+	for (auto const& hicann : m_resource_manager.allocated()) {
+		auto const hicann_start = StageTimer::clock_type::now();
+		local_router.run(hicann, synapse_routing_result);
+		synapse_routing_timer.hot_spot(
+			hicann.toHICANNOnWafer(), StageTimer::clock_type::now() - hicann_start);
+	}
+	synapse_routing_timer.stop();
 
-	SynapseRoutingConfigurator configurator(wafer_config);
+	StageTimer synapse_configuration_timer(m_pymarocco.getStats(), "synapse_configuration");
+	ConfigurationChanges synapse_changes;
+	SynapseRoutingConfigurator configurator(synapse_changes);
 
 	for (auto const& hicann : m_resource_manager.allocated()) {
 		if (!synapse_routing_result.has(hicann)) {
@@ -123,15 +154,15 @@ void Routing::run(results::L1Routing& l1_routing_result, results::SynapseRouting
 
 		configurator.run(hicann, synapse_routing_result[hicann]);
 	}
+	synapse_changes.apply(wafer_config);
+	synapse_configuration_timer.stop();
 
 	// Allocate all HICANNs used in L1 routes s.t. shared parameters will be configured later.
 	for (auto const& item : l1_routing_result) {
-		for (auto const& segment : item.route().segments()) {
-			if (auto const* hicann = boost::get<HICANNOnWafer>(&segment)) {
-				HICANNGlobal const resource(*hicann, m_hardware.index());
-				if (m_resource_manager.available(resource)) {
-					m_resource_manager.allocate(resource);
-				}
+		for (auto const& hicann : item.hicanns()) {
+			HICANNGlobal const resource(hicann, m_hardware.index());
+			if (m_resource_manager.available(resource)) {
+				m_resource_manager.allocate(resource);
 			}
 		}
 	}
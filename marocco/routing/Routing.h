@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "marocco/BioGraph.h"
@@ -23,6 +25,12 @@ public:
 		pymarocco::PyMarocco& pymarocco,
 		placement::results::Placement const& neuron_placement);
 
+	/**
+	 * @brief Stop L1 routing from further DNC mergers after the given point in time.
+	 * @see L1Routing::deadline()
+	 */
+	void deadline(std::chrono::steady_clock::time_point value);
+
 	void run(
 	    results::L1Routing& l1_routing_result, results::SynapseRouting& synapse_routing_result);
 	boost::shared_ptr<SynapseLoss> getSynapseLoss() const;
@@ -34,6 +42,7 @@ private:
 	pymarocco::PyMarocco& m_pymarocco;
 	placement::results::Placement const& m_neuron_placement;
 	boost::shared_ptr<SynapseLoss> m_synapse_loss;
+	boost::optional<std::chrono::steady_clock::time_point> m_deadline;
 };
 
 } // namespace routing
@@ -0,0 +1,175 @@
+#include "marocco/routing/RoutingPortfolio.h"
+
+#include <chrono>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include <tbb/parallel_for.h>
+
+#include "marocco/Logger.h"
+#include "marocco/routing/Routing.h"
+#include "marocco/util/stage_timer.h"
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+struct Candidate
+{
+	Candidate(
+		sthal::Wafer const& hardware,
+		resource_manager_t const& resource_manager,
+		pymarocco::PyMarocco const& pymarocco)
+		: hardware(hardware.index()),
+		  resource_manager(resource_manager),
+		  pymarocco(new pymarocco::PyMarocco(pymarocco)),
+		  l1_routing(),
+		  synapse_routing(),
+		  synapse_loss(),
+		  error(),
+		  wall_time(0.)
+	{
+		// Only record the stages of this candidate, see RoutingPortfolio::run().
+		this->pymarocco->getStats().clearStages();
+	}
+
+	sthal::Wafer hardware;
+	resource_manager_t resource_manager;
+	boost::shared_ptr<pymarocco::PyMarocco> pymarocco;
+	results::L1Routing l1_routing;
+	results::SynapseRouting synapse_routing;
+	boost::shared_ptr<SynapseLoss> synapse_loss;
+	std::exception_ptr error;
+	double wall_time;
+}; // Candidate
+
+} // namespace
+
+RoutingPortfolio::RoutingPortfolio(
+	BioGraph const& graph,
+	sthal::Wafer& hardware,
+	resource_manager_t& resource_manager,
+	pymarocco::PyMarocco& pymarocco,
+	placement::results::Placement const& neuron_placement)
+	: m_graph(graph),
+	  m_hardware(hardware),
+	  m_resource_manager(resource_manager),
+	  m_pymarocco(pymarocco),
+	  m_neuron_placement(neuron_placement),
+	  m_synapse_loss(),
+	  m_winner(0)
+{
+}
+
+void RoutingPortfolio::run(
+	results::L1Routing& l1_routing_result, results::SynapseRouting& synapse_routing_result)
+{
+	auto const& portfolio = m_pymarocco.routing_portfolio;
+	if (portfolio.empty()) {
+		throw std::invalid_argument("routing portfolio does not contain any candidates");
+	}
+
+	MAROCCO_INFO("Routing " << portfolio.size() << " candidate configurations");
+
+	// Fork the state after placement.  This is done serially, as accessing HICANNs
+	// of the wafer container is not thread-safe.
+	auto const hicanns = m_hardware.getAllocatedHicannCoordinates();
+	std::vector<std::unique_ptr<Candidate> > candidates;
+	for (size_t ii = 0; ii < portfolio.size(); ++ii) {
+		candidates.emplace_back(new Candidate(m_hardware, m_resource_manager, m_pymarocco));
+		auto& candidate = *candidates.back();
+		candidate.pymarocco->l1_routing = portfolio.get(ii);
+		for (auto const& hicann : hicanns) {
+			candidate.hardware[hicann] = m_hardware[hicann];
+		}
+	}
+
+	auto const deadline = std::chrono::duration<double>(portfolio.deadline());
+	tbb::parallel_for(size_t(0), candidates.size(), [&](size_t const ii) {
+		auto& candidate = *candidates[ii];
+		auto const start = std::chrono::steady_clock::now();
+		try {
+			Routing routing(
+				m_graph, candidate.hardware, candidate.resource_manager, *candidate.pymarocco,
+				m_neuron_placement);
+			if (deadline.count() > 0.) {
+				routing.deadline(
+					start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+					            deadline));
+			}
+			routing.run(candidate.l1_routing, candidate.synapse_routing);
+			candidate.synapse_loss = routing.getSynapseLoss();
+		} catch (...) {
+			candidate.error = std::current_exception();
+		}
+		candidate.wall_time =
+			std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	});
+
+	// Pick the candidate with the least synapse loss.
+	Candidate* winner = nullptr;
+	size_t winner_loss = std::numeric_limits<size_t>::max();
+	for (size_t ii = 0; ii < candidates.size(); ++ii) {
+		auto& candidate = *candidates[ii];
+		if (candidate.error || !candidate.synapse_loss) {
+			MAROCCO_WARN("Routing candidate " << ii << " failed");
+			continue;
+		}
+
+		size_t const loss = candidate.synapse_loss->getTotalLoss();
+		MAROCCO_INFO(
+			"Routing candidate " << ii << " lost " << loss << " synapses in "
+			<< candidate.wall_time << " s");
+		if (!winner || loss < winner_loss) {
+			winner = &candidate;
+			winner_loss = loss;
+			m_winner = ii;
+		}
+	}
+
+	if (!winner) {
+		for (auto const& candidate : candidates) {
+			if (candidate->error) {
+				std::rethrow_exception(candidate->error);
+			}
+		}
+		throw std::runtime_error("no routing candidate succeeded");
+	}
+
+	MAROCCO_INFO("Using routing candidate " << m_winner);
+
+	// Commit the winner.
+	for (auto const& hicann : winner->hardware.getAllocatedHicannCoordinates()) {
+		m_hardware[hicann] = winner->hardware[hicann];
+	}
+
+	for (auto const& hicann : winner->resource_manager.allocated()) {
+		if (m_resource_manager.available(hicann)) {
+			m_resource_manager.allocate(hicann);
+		}
+	}
+
+	// Stages of candidates are recorded in other threads, thus they are nested into the
+	// currently running stage here.
+	m_pymarocco.getStats().addStages(
+		winner->pymarocco->getStats(), StageTimer::current(m_pymarocco.getStats()));
+	l1_routing_result = winner->l1_routing;
+	synapse_routing_result = winner->synapse_routing;
+	m_synapse_loss = winner->synapse_loss;
+}
+
+boost::shared_ptr<SynapseLoss> RoutingPortfolio::getSynapseLoss() const
+{
+	return m_synapse_loss;
+}
+
+size_t RoutingPortfolio::winner() const
+{
+	return m_winner;
+}
+
+} // namespace routing
+} // namespace marocco
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <boost/shared_ptr.hpp>
+
+#include "marocco/BioGraph.h"
+#include "marocco/config.h"
+#include "marocco/placement/results/Placement.h"
+#include "marocco/routing/SynapseLoss.h"
+#include "marocco/routing/results/L1Routing.h"
+#include "marocco/routing/results/SynapseRouting.h"
+#include "pymarocco/PyMarocco.h"
+
+namespace marocco {
+namespace routing {
+
+/**
+ * @brief Routes the candidates of \c PyMarocco::routing_portfolio concurrently and
+ *        commits the one with the least synapse loss.
+ * Each candidate works on its own copy of the hardware configuration of the placed
+ * HICANNs, the resource manager and the mapping statistics.  Only the configuration,
+ * resource allocation, statistics and results of the winner are written back.
+ */
+class RoutingPortfolio
+{
+public:
+	RoutingPortfolio(
+		BioGraph const& graph,
+		sthal::Wafer& hardware,
+		resource_manager_t& resource_manager,
+		pymarocco::PyMarocco& pymarocco,
+		placement::results::Placement const& neuron_placement);
+
+	/**
+	 * @throw std::invalid_argument If the portfolio is empty.
+	 * @note If routing fails for all candidates, the first error is rethrown.
+	 */
+	void run(
+	    results::L1Routing& l1_routing_result, results::SynapseRouting& synapse_routing_result);
+	boost::shared_ptr<SynapseLoss> getSynapseLoss() const;
+
+	/// Index of the committed candidate.
+	size_t winner() const;
+
+private:
+	BioGraph const& m_graph;
+	sthal::Wafer& m_hardware;
+	resource_manager_t& m_resource_manager;
+	pymarocco::PyMarocco& m_pymarocco;
+	placement::results::Placement const& m_neuron_placement;
+	boost::shared_ptr<SynapseLoss> m_synapse_loss;
+	size_t m_winner;
+}; // RoutingPortfolio
+
+} // namespace routing
+} // namespace marocco
@@ -270,7 +270,7 @@ SynapseDriverRequirements::count_drivers(std::map<STPMode, size_t> const& requir
 std::map<Side_Parity_STP, size_t>
 SynapseDriverRequirements::resolve_triparity(
     std::map<TriParity, std::map<Side_Decoder_STP, size_t> > const& half_rows_per_triparity,
-    std::map<Side_Parity_Decoder_STP, size_t>& synrow_hist,
+    SynapseHistogram& synrow_hist,
     std::map<Side_Decoder_STP, std::vector<Parity> >& assignment_to_parity)
 {
 	synrow_hist.clear();
@@ -427,19 +427,19 @@ SynapseDriverRequirements::get_synapse_type_to_synapse_columns_map() const
 }
 
 std::pair<size_t, size_t> SynapseDriverRequirements::calc(
-	DNCMergerOnWafer const& source, graph_t const& graph) const
+	DNCMergerOnWafer const& source, BioGraph const& bio_graph) const
 {
-	std::map<Side_Parity_Decoder_STP, size_t> synapse_histogram;
-	std::map<Side_Parity_Decoder_STP, size_t> synrow_histogram;
-	return calc(source, graph, synapse_histogram, synrow_histogram);
+	SynapseHistogram synapse_histogram;
+	SynapseHistogram synrow_histogram;
+	return calc(source, bio_graph, synapse_histogram, synrow_histogram);
 }
 
 std::pair<size_t, size_t> SynapseDriverRequirements::_calc(
 	SynapseCounts const& syn_counts,
 	std::unordered_map<HMF::Coordinate::NeuronOnHICANN, Side_Parity_count_per_synapse_type> const&
 		target_synapses_per_parity_and_synaptic_input,
-	std::map<Side_Parity_Decoder_STP, size_t>& synapse_histogram,
-	std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram)
+	SynapseHistogram& synapse_histogram,
+	SynapseHistogram& synrow_histogram)
 {
 	std::vector<std::map<Type_Decoder_STP, std::map<Side_Parity, size_t> > >
 		half_rows_per_input_granularity;
@@ -482,7 +482,7 @@ std::pair<size_t, size_t> SynapseDriverRequirements::_calc(
 		NeuronOnHICANN const& nrn_addr = item.first;
 		auto const& bio_property_counts = item.second;
 
-		std::map<Side_Parity_Decoder_STP, size_t> syn_counts_per_hw_property =
+		SynapseHistogram syn_counts_per_hw_property =
 		    count_synapses_per_hardware_property(
 		        bio_property_counts, bio_to_hw_assignment[ii],
 		        target_synapses_per_parity_and_synaptic_input.at(nrn_addr),
@@ -518,51 +518,64 @@ std::pair<size_t, size_t> SynapseDriverRequirements::_calc(
 
 std::pair<size_t, size_t> SynapseDriverRequirements::calc(
 	DNCMergerOnWafer const& source,
-	graph_t const& graph,
-	std::map<Side_Parity_Decoder_STP, size_t>& synapse_histogram,
-	std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram) const
+	BioGraph const& bio_graph,
+	SynapseHistogram& synapse_histogram,
+	SynapseHistogram& synrow_histogram) const
 {
+	typedef placement::results::Placement::item_type item_type;
+	auto const& graph = bio_graph.graph();
 	SynapseCounts sc;
 
+	// Neurons of the target population of each projection placed to this HICANN, indexed
+	// by their relative index in the projection view.  Filled lazily, as the same
+	// projection is encountered for all source neurons of the population.
+	std::unordered_map<BioGraph::edge_descriptor, std::vector<item_type const*> > targets_on_hicann;
+
 	for (auto const& source_item : mPlacementResult.find(source)) {
 		for (auto const& edge : make_iterable(out_edges(source_item.population(), graph))) {
-			ProjectionView const proj_view = graph[edge];
+			ProjectionView const& proj_view = graph[edge];
 
 			if (!proj_view.pre().mask()[source_item.neuron_index()]) {
 				continue;
 			}
 
-			Connector::const_matrix_view_type const bio_weights = proj_view.getWeights();
+			auto const& connectivity = bio_graph.connectivity(edge);
 			SynapseType const syntype_proj = toSynapseType(proj_view.projection()->target());
 			STPMode const stp_proj = toSTPMode(proj_view.projection()->dynamics());
 
-			graph_t::vertex_descriptor target = boost::target(edge, graph);
-			for (auto const& target_item : mPlacementResult.find(target)) {
-				auto const& neuron_block = target_item.neuron_block();
-				if (neuron_block == boost::none ||
-				    neuron_block->toHICANNOnWafer() != mHICANN) {
-					continue;
-				}
+			auto it = targets_on_hicann.find(edge);
+			if (it == targets_on_hicann.end()) {
+				std::vector<item_type const*> targets(connectivity.num_targets(), nullptr);
+				graph_t::vertex_descriptor target = boost::target(edge, graph);
+				for (auto const& target_item : mPlacementResult.find(target)) {
+					auto const& neuron_block = target_item.neuron_block();
+					if (neuron_block == boost::none ||
+					    neuron_block->toHICANNOnWafer() != mHICANN) {
+						continue;
+					}
 
-				if (!proj_view.post().mask()[target_item.neuron_index()]) {
-					continue;
-				}
+					if (!proj_view.post().mask()[target_item.neuron_index()]) {
+						continue;
+					}
 
-				size_t const src_neuron_in_proj_view =
-					to_relative_index(proj_view.pre().mask(), source_item.neuron_index());
-				size_t const trg_neuron_in_proj_view =
-					to_relative_index(proj_view.post().mask(), target_item.neuron_index());
+					targets[to_relative_index(
+						proj_view.post().mask(), target_item.neuron_index())] = &target_item;
+				}
+				it = targets_on_hicann.emplace(edge, std::move(targets)).first;
+			}
 
-				double const weight =
-					bio_weights(src_neuron_in_proj_view, trg_neuron_in_proj_view);
+			size_t const src_neuron_in_proj_view =
+				to_relative_index(proj_view.pre().mask(), source_item.neuron_index());
 
-				if (std::isnan(weight) || weight <= 0.) {
+			for (auto const& synapse : connectivity.targets(src_neuron_in_proj_view)) {
+				auto const* target_item = it->second[synapse.index];
+				if (target_item == nullptr) {
 					continue;
 				}
 
 				auto const address = source_item.address();
 				assert(address != boost::none);
-				auto const logical_neuron = target_item.logical_neuron();
+				auto const& logical_neuron = target_item->logical_neuron();
 				assert(!logical_neuron.is_external());
 				sc.add(logical_neuron.front(), address->toL1Address(), syntype_proj, stp_proj);
 			}
@@ -573,20 +586,20 @@ std::pair<size_t, size_t> SynapseDriverRequirements::calc(
 		sc, mTargetSynapsesPerSynapticInputGranularity, synapse_histogram, synrow_histogram);
 }
 
-std::map<Side_Parity_Decoder_STP, size_t>
+SynapseHistogram
 SynapseDriverRequirements::count_synapses_per_hardware_property(
     std::map<Type_Decoder_STP, size_t> const& bio_property_counts,          // neuron-wise
     std::map<Type_Decoder_STP, Side_TriParity> const& bio_to_hw_assignment, // neuron-wise
     std::map<SynapseType, std::map<Side_Parity, size_t> > const&
         target_synapses_per_parity_and_synaptic_input,                               // neuron-wise
     std::map<Side_Decoder_STP, std::vector<Parity> > const& assignment_to_parity,    // global
-    std::map<Side_Parity_Decoder_STP, size_t> const& half_rows_per_hardware_property // global for
+    SynapseHistogram const& half_rows_per_hardware_property                          // global for
                                                                                      // check
     )
 {
-	std::map<Side_Parity_Decoder_STP, size_t> syn_count; // return value
+	SynapseHistogram syn_count; // return value
 #ifndef MAROCCO_NDEBUG
-	std::map<Side_Parity_Decoder_STP, size_t> used_half_rows; // for check
+	SynapseHistogram used_half_rows; // for check
 #endif // MAROCCO_NDEBUG
 
 	// first process synapses that are bound to even or odd columns
@@ -9,6 +9,7 @@
 
 #include "hal/Coordinate/HMFGeometry.h"
 #include "hal/HICANN/L1Address.h"
+#include "marocco/routing/HardwareSynapsePropertyArray.h"
 #include "marocco/routing/results/SynapticInputs.h"
 #include "marocco/placement/results/Placement.h"
 #include "marocco/routing/STPMode.h"
@@ -33,9 +34,6 @@ std::ostream& operator<<(std::ostream& os, TriParity p);
 
 typedef std::tuple<SynapseType, HMF::HICANN::DriverDecoder, STPMode> Type_Decoder_STP;
 
-typedef std::tuple<HMF::Coordinate::Side, Parity, HMF::HICANN::DriverDecoder, STPMode>
-	Side_Parity_Decoder_STP;
-
 typedef std::tuple<HMF::Coordinate::Side, Parity> Side_Parity;
 
 typedef std::tuple<HMF::Coordinate::Side, TriParity> Side_TriParity;
@@ -175,7 +173,7 @@ public:
 	///
 	/// @param[in] source merger used to lookup the populations whose outgoing
 	///                   projections to consider
-	/// @param[in] graph the PyNN graph of populations and projections
+	/// @param[in] bio_graph the PyNN graph of populations and projections
 	/// @param[out] synapse_histogram synapses per hardware synapse property
 	/// @param[out] synrow_histogram required half synapse rows per hardware
 	/// synapse property
@@ -184,16 +182,16 @@ public:
 	/// from this L1 Route to target neurons on the HICANN)
 	std::pair<size_t, size_t> calc(
 		HMF::Coordinate::DNCMergerOnWafer const& source,
-		graph_t const& graph,
-		std::map<Side_Parity_Decoder_STP, size_t>& synapse_histogram,
-		std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram) const;
+		BioGraph const& bio_graph,
+		SynapseHistogram& synapse_histogram,
+		SynapseHistogram& synrow_histogram) const;
 
 	/// calculate the number of required synapse drivers for connections from the
 	/// specified sources.
 	///
 	/// @param source merger used to lookup the populations whose outgoing projections
 	///               to consider
-	/// @param graph the PyNN graph of populations and projections
+	/// @param bio_graph the PyNN graph of populations and projections
 	///
 	/// @return a std::pair (number of required drivers, number of synapses)
 	///
@@ -202,7 +200,7 @@ public:
 	///       projection has targets on this HICANN. This assertion could be done much
 	///       more efficiently, cf. #1594.
 	std::pair<size_t, size_t> calc(
-		HMF::Coordinate::DNCMergerOnWafer const& source, graph_t const& graph) const;
+		HMF::Coordinate::DNCMergerOnWafer const& source, BioGraph const& bio_graph) const;
 
 	std::unordered_map<HMF::Coordinate::NeuronOnHICANN, std::map<SynapseType, SynapseColumnsMap> >
 	get_synapse_type_to_synapse_columns_map() const;
@@ -357,7 +355,7 @@ private:
 	/// @return the number of half rows per (Side, Parity, STP)
 	static std::map<Side_Parity_STP, size_t> resolve_triparity(
 	    std::map<TriParity, std::map<Side_Decoder_STP, size_t> > const& required_half_rows,
-	    std::map<Side_Parity_Decoder_STP, size_t>& synrow_hist,
+	    SynapseHistogram& synrow_hist,
 	    std::map<Side_Decoder_STP, std::vector<Parity> >& triparity_assignmemt_to_parity);
 
 	/// counts the number of synapse rows required per side and STP.
@@ -430,8 +428,8 @@ private:
 		std::unordered_map<HMF::Coordinate::NeuronOnHICANN,
 						   Side_Parity_count_per_synapse_type> const&
 			target_synapses_per_parity_and_synaptic_input,
-		std::map<Side_Parity_Decoder_STP, size_t>& synapse_histogram,
-		std::map<Side_Parity_Decoder_STP, size_t>& synrow_histogram);
+		SynapseHistogram& synapse_histogram,
+		SynapseHistogram& synrow_histogram);
 
 	/// Counts the number of synapses per hardware property for one neuron.
 	///
@@ -465,13 +463,13 @@ private:
 	/// hardware property (global)
 	///
 	/// @return for each hardware property the number of assigned synapses
-	static std::map<Side_Parity_Decoder_STP, size_t> count_synapses_per_hardware_property(
+	static SynapseHistogram count_synapses_per_hardware_property(
 	    std::map<Type_Decoder_STP, size_t> const& bio_property_counts,
 	    std::map<Type_Decoder_STP, Side_TriParity> const& bio_to_hw_assignment,
 	    std::map<SynapseType, std::map<Side_Parity, size_t> > const&
 	        target_synapses_per_parity_and_synaptic_input,
 	    std::map<Side_Decoder_STP, std::vector<Parity> > const& triparity_assignmemt_to_parity,
-	    std::map<Side_Parity_Decoder_STP, size_t> const& half_rows_per_hardware_property);
+	    SynapseHistogram const& half_rows_per_hardware_property);
 
 	// members
 	/// Coordinate of HICANN chip we are currently working on.
@@ -6,8 +6,8 @@ using namespace HMF::Coordinate;
 namespace marocco {
 namespace routing {
 
-SynapseLoss::SynapseLoss(graph_t const& graph) :
-	mImpl(new SynapseLossImpl(graph))
+SynapseLoss::SynapseLoss(BioGraph const& bio_graph) :
+	mImpl(new SynapseLossImpl(bio_graph))
 {}
 
 void SynapseLoss::addLoss(Edge const& e,
@@ -89,7 +89,7 @@ size_t SynapseLoss::getTotalSet() const
 	return mImpl->getTotalSet();
 }
 
-SynapseLoss::Matrix const& SynapseLoss::getWeights(Edge const& e) const
+SynapseLoss::Matrix SynapseLoss::getWeights(Edge const& e) const
 {
 	return static_cast<SynapseLossImpl const&>(*mImpl).getWeights(e);
 }
@@ -99,5 +99,13 @@ void SynapseLoss::fill(pymarocco::MappingStats& stats) const
 	mImpl->fill(stats);
 }
 
+void SynapseLoss::update_weights(
+	BioGraph const& bio_graph,
+	std::vector<Edge> const& edges,
+	pymarocco::MappingStats& stats)
+{
+	SynapseLossImpl::update_weights(bio_graph, edges, stats);
+}
+
 } // namespace routing
 } // namespace marocco
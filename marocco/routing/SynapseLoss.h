@@ -1,6 +1,8 @@
 #pragma once
 
+#include <vector>
 #include <boost/shared_ptr.hpp>
+#include "marocco/BioGraph.h"
 #include "marocco/graph.h"
 #include "marocco/config.h"
 #include "marocco/assignment/PopulationSlice.h"
@@ -23,7 +25,7 @@ public:
 	typedef HMF::Coordinate::HICANNOnWafer Index;
 	typedef assignment::PopulationSlice Assign;
 
-	SynapseLoss(graph_t const& graph);
+	SynapseLoss(BioGraph const& bio_graph);
 
 	void addLoss(Edge const& e,
 				 Index const& src,
@@ -59,10 +61,21 @@ public:
 	size_t getTotalSynapses() const;
 	size_t getTotalSet() const;
 
-	Matrix const& getWeights(Edge const& e) const;
+	/// Dense view of the (possibly distorted) weights, assembled on each call.
+	Matrix getWeights(Edge const& e) const;
 
 	void fill(pymarocco::MappingStats& stats) const;
 
+	/**
+	 * @brief Update weight statistics of a previous run after only the weights of the
+	 *        given projection views changed.
+	 * Synapses lost during the previous run stay marked as lost.
+	 */
+	static void update_weights(
+		BioGraph const& bio_graph,
+		std::vector<Edge> const& edges,
+		pymarocco::MappingStats& stats);
+
 private:
 	boost::shared_ptr<SynapseLossImpl> mImpl;
 };
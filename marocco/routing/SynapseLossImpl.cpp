@@ -1,4 +1,8 @@
 #include "marocco/routing/SynapseLossImpl.h"
+
+#include <cmath>
+#include <utility>
+
 #include "marocco/routing/util.h"
 #include "marocco/Logger.h"
 #include "pymarocco/MappingStats.h"
@@ -8,8 +12,38 @@ using namespace HMF::Coordinate;
 namespace marocco {
 namespace routing {
 
-SynapseLossImpl::SynapseLossImpl(graph_t const& graph) :
-	mGraph(graph)
+namespace {
+
+/// Offsets of the given projection view in the weight matrix of its projection.
+std::pair<size_t, size_t> offsets(ProjectionView const& proj_view)
+{
+	Projection const& proj = *proj_view.projection();
+
+	size_t pre_cnt = 0;
+	for (PopulationView const& view : proj.pre()) {
+		if (view == proj_view.pre()) {
+			break;
+		} else {
+			pre_cnt += view.size();
+		}
+	}
+
+	size_t post_cnt = 0;
+	for (PopulationView const& view : proj.post()) {
+		if (view == proj_view.post()) {
+			break;
+		} else {
+			post_cnt += view.size();
+		}
+	}
+
+	return std::make_pair(pre_cnt, post_cnt);
+}
+
+} // namespace
+
+SynapseLossImpl::SynapseLossImpl(BioGraph const& bio_graph) :
+	mBioGraph(bio_graph), mGraph(bio_graph.graph())
 {}
 
 void SynapseLossImpl::addLoss(Edge const& e,
@@ -20,22 +54,20 @@ void SynapseLossImpl::addLoss(Edge const& e,
 {
 #ifndef MAROCCO_NO_SYNAPSE_TRACKING
 	// first mask away original weight
-	auto& weights = getWeights(e);
+	auto& weights = getTrackedWeights(e);
 
-#ifndef MAROCCO_NDEBUG
-	// do we really want to check whether (i1,i2) references a finite weight > 0.
-	ProjectionView const view = mGraph[e];
-	auto const w = view.getWeights()(i1, i2);
-	if (!SynapseLossProxy::isRealWeight(w)) {
+	size_t const position = mBioGraph.connectivity(e).position(i1, i2);
+	if (position >= weights.size()) {
 		throw std::runtime_error("add loss for non-existant weight");
 	}
 
-	if (!SynapseLossProxy::isRealWeight(weights(i1, i2))) {
+#ifndef MAROCCO_NDEBUG
+	if (!SynapseLossProxy::isRealWeight(weights[position])) {
 		throw std::runtime_error("mask non-existant weight");
 	}
 #endif // MAROCCO_NDEBUG
 
-	weights(i1, i2) = SynapseLossProxy::NA;
+	weights[position] = SynapseLossProxy::NA;
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 
 	// then insert source loss
@@ -53,10 +85,11 @@ void SynapseLossImpl::addLoss(Edge const& e,
 {
 #ifndef MAROCCO_NO_SYNAPSE_TRACKING
 	// first mask away original weight
-	auto& weights = getWeights(e);
+	auto& weights = getTrackedWeights(e);
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 
 	ProjectionView const view = mGraph[e];
+	auto const& connectivity = mBioGraph.connectivity(e);
 
 	// calculate offsets for pre and post populations in this view
 	size_t const src_neuron_offset_in_proj_view =
@@ -64,7 +97,13 @@ void SynapseLossImpl::addLoss(Edge const& e,
 	size_t const trg_neuron_offset_in_proj_view =
 		to_relative_index(view.post().mask(), btrg.offset());
 
-	auto const& _ws = view.getWeights();
+	// relative indices of targets contained in btrg are [trg_begin, trg_end)
+	size_t const trg_begin = trg_neuron_offset_in_proj_view;
+	size_t trg_end = trg_begin;
+	for (size_t trg_neuron=btrg.offset(); trg_neuron<btrg.size()+btrg.offset(); ++trg_neuron)
+	{
+		trg_end += view.post().mask()[trg_neuron];
+	}
 
 	size_t cnt = 0;
 	size_t src_neuron_in_proj_view = src_neuron_offset_in_proj_view;
@@ -74,24 +113,17 @@ void SynapseLossImpl::addLoss(Edge const& e,
 			continue;
 		}
 
-		size_t trg_neuron_in_proj_view = trg_neuron_offset_in_proj_view;
-		for (size_t trg_neuron=btrg.offset(); trg_neuron<btrg.size()+btrg.offset(); ++trg_neuron)
+		// only existent weights are part of the sparse connectivity
+		for (auto const& synapse : connectivity.targets(src_neuron_in_proj_view))
 		{
-			// first check whether neurons are part of ProjectionView
-			if (!view.post().mask()[trg_neuron]) {
+			if (synapse.index < trg_begin || synapse.index >= trg_end) {
 				continue;
 			}
-
-			// then check whether this would be an existent weight
-			auto const w = _ws(src_neuron_in_proj_view, trg_neuron_in_proj_view);
-			if (SynapseLossProxy::isRealWeight(w))
-			{
 #ifndef MAROCCO_NO_SYNAPSE_TRACKING
-				weights(src_neuron_in_proj_view, trg_neuron_in_proj_view) = SynapseLossProxy::NA;
+			weights[connectivity.position(src_neuron_in_proj_view, synapse.index)] =
+				SynapseLossProxy::NA;
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
-				cnt++;
-			}
-			trg_neuron_in_proj_view++;
+			cnt++;
 		}
 		src_neuron_in_proj_view++;
 	}
@@ -129,22 +161,20 @@ void SynapseLossImpl::updateWeight(Edge const& e,
 								double value)
 {
 	// first mask away original weight
-	auto& weights = getWeights(e);
+	auto& weights = getTrackedWeights(e);
 
-#ifndef MAROCCO_NDEBUG
-	// do we really want to check whether (i1,i2) references a finite weight > 0.
-	ProjectionView const view = mGraph[e];
-	auto const w = view.getWeights()(i1, i2);
-	if (!SynapseLossProxy::isRealWeight(w)) {
+	size_t const position = mBioGraph.connectivity(e).position(i1, i2);
+	if (position >= weights.size()) {
 		throw std::runtime_error("add loss for non-existant weight");
 	}
 
-	if (!SynapseLossProxy::isRealWeight(weights(i1, i2))) {
+#ifndef MAROCCO_NDEBUG
+	if (!SynapseLossProxy::isRealWeight(weights[position])) {
 		throw std::runtime_error("mask non-existant weight");
 	}
 #endif // MAROCCO_NDEBUG
 
-	weights(i1, i2) = value;
+	weights[position] = value;
 }
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 
@@ -155,8 +185,9 @@ SynapseLossImpl::getProxy(Edge const& e,
 						  Index const& trg)
 {
 #ifndef MAROCCO_NO_SYNAPSE_TRACKING
-	auto& weights = getWeights(e);
-	return SynapseLossProxy(weights, mChipPre[src], mChipPost[trg], mChipSet[trg]);
+	auto& weights = getTrackedWeights(e);
+	return SynapseLossProxy(
+		mBioGraph.connectivity(e), weights, mChipPre[src], mChipPost[trg], mChipSet[trg]);
 #else
 	return SynapseLossProxy(mChipPre[src], mChipPost[trg], mChipSet[trg]);
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
@@ -175,22 +206,24 @@ SynapseLossImpl& SynapseLossImpl::operator+=(SynapseLossImpl const& rhs)
 		auto it = mWeights.find(entry.first);
 		if (it != mWeights.end()) {
 			// we need to merge
-			ProjectionView const view = mGraph[entry.first];
+			auto const& connectivity = mBioGraph.connectivity(entry.first);
 
-			auto const& orig = view.getWeights();
 			auto const& src  = entry.second;
 			auto& trg = it->second;
-			for (size_t i1=0; i1<orig.size1(); ++i1)
+			size_t position = 0;
+			for (size_t i1=0; i1<connectivity.num_sources(); ++i1)
 			{
-				for (size_t i2=0; i2<orig.size2(); ++i2)
+				for (auto const& synapse : connectivity.targets(i1))
 				{
-					if (src(i1, i2) != orig(i1, i2))
+					double const orig = synapse.weight;
+					if (src[position] != orig)
 					{
-						if (trg(i1, i2) != orig(i1, i2)) {
+						if (trg[position] != orig) {
 							throw std::runtime_error("synapese modified more than once");
 						}
-						trg(i1, i2) = src(i1, i2);
+						trg[position] = src[position];
 					}
+					++position;
 				}
 			}
 		} else {
@@ -243,18 +276,7 @@ size_t SynapseLossImpl::getTotalSynapses() const
 	std::tie(it, eit) = boost::edges(mGraph);
 	for (; it!=eit; ++it)
 	{
-		ProjectionView const proj = mGraph[*it];
-
-		auto const& weights = proj.getWeights();
-		for (size_t i1=0; i1<weights.size1(); ++i1)
-		{
-			for (size_t i2=0; i2<weights.size2(); ++i2)
-			{
-				if (SynapseLossProxy::isRealWeight(weights(i1, i2))) {
-					cnt++;
-				}
-			}
-		}
+		cnt += mBioGraph.connectivity(*it).size();
 	}
 	return cnt;
 }
@@ -268,6 +290,40 @@ size_t SynapseLossImpl::getTotalSet() const
 	return cnt;
 }
 
+void SynapseLossImpl::update_weights(
+	BioGraph const& bio_graph,
+	std::vector<Edge> const& edges,
+	pymarocco::MappingStats& stats)
+{
+#ifndef MAROCCO_NO_SYNAPSE_TRACKING
+	auto const& graph = bio_graph.graph();
+	for (auto const& edge : edges) {
+		ProjectionView const proj_view = graph[edge];
+		auto& weights = stats.getWeights(proj_view.projection()->id());
+		if (weights.size1() == 0) {
+			// No statistics of a previous run.
+			continue;
+		}
+
+		auto const& connectivity = bio_graph.connectivity(edge);
+		auto const offset = offsets(proj_view);
+		for (size_t i1 = 0; i1 < connectivity.num_sources(); ++i1) {
+			for (auto const& synapse : connectivity.targets(i1)) {
+				auto& weight = weights(offset.first + i1, offset.second + synapse.index);
+				// Lost synapses stay marked as such.
+				if (!std::isnan(weight)) {
+					weight = synapse.weight;
+				}
+			}
+		}
+	}
+#else
+	static_cast<void>(bio_graph);
+	static_cast<void>(edges);
+	static_cast<void>(stats);
+#endif // MAROCCO_NO_SYNAPSE_TRACKING
+}
+
 void SynapseLossImpl::fill(pymarocco::MappingStats& stats) const
 {
 	graph_t::edge_iterator it, eit;
@@ -285,35 +341,23 @@ void SynapseLossImpl::fill(pymarocco::MappingStats& stats) const
 			weights = proj.getWeights().get();
 		}
 
-		try {
-			auto const& sl_weights = getWeights(*it);
-
-			size_t pre_cnt = 0;
-			for (PopulationView const& view : proj.pre()) {
-				if (view == proj_view.pre()) {
-					break;
-				} else {
-					pre_cnt += view.size();
-				}
-			}
+		auto const sl_it = mWeights.find(*it);
+		if (sl_it == mWeights.end()) {
+			// no synapse loss for this combination
+			continue;
+		}
 
-			size_t post_cnt = 0;
-			for (PopulationView const& view : proj.post()) {
-				if (view == proj_view.post()) {
-					break;
-				} else {
-					post_cnt += view.size();
-				}
-			}
+		auto const& sl_weights = sl_it->second;
+		auto const& connectivity = mBioGraph.connectivity(*it);
+		auto const offset = offsets(proj_view);
 
-			// now we have the offsets
-			for (size_t i1 = 0; i1 < proj_view.pre().size(); ++i1) {
-				for (size_t i2 = 0; i2 < proj_view.post().size(); ++i2) {
-					weights(pre_cnt + i1, post_cnt + i2) = sl_weights(i1, i2);
-				}
+		// now we have the offsets, all other weights are unchanged
+		size_t position = 0;
+		for (size_t i1 = 0; i1 < connectivity.num_sources(); ++i1) {
+			for (auto const& synapse : connectivity.targets(i1)) {
+				weights(offset.first + i1, offset.second + synapse.index) =
+					sl_weights[position++];
 			}
-		} catch (std::out_of_range const&) {
-			// no synapse loss for this combination
 		}
 	}
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
@@ -324,23 +368,42 @@ void SynapseLossImpl::fill(pymarocco::MappingStats& stats) const
 	stats.setSynapsesSet(getTotalSet());
 }
 
-SynapseLossImpl::Matrix const& SynapseLossImpl::getWeights(Edge const& e) const
+SynapseLossImpl::Matrix SynapseLossImpl::getWeights(Edge const& e) const
 {
+	ProjectionView const view = mGraph[e];
+	Matrix rv(view.getWeights());
 #ifndef MAROCCO_NO_SYNAPSE_TRACKING
-	return mWeights.at(e);
-#else
-	return Matrix{};
+	auto const it = mWeights.find(e);
+	if (it == mWeights.end()) {
+		throw std::out_of_range("no synapse loss tracked for projection view");
+	}
+
+	auto const& connectivity = mBioGraph.connectivity(e);
+	size_t position = 0;
+	for (size_t i1 = 0; i1 < connectivity.num_sources(); ++i1) {
+		for (auto const& synapse : connectivity.targets(i1)) {
+			rv(i1, synapse.index) = it->second[position++];
+		}
+	}
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
+	return rv;
 }
 
 #ifndef MAROCCO_NO_SYNAPSE_TRACKING
-SynapseLossImpl::Matrix& SynapseLossImpl::getWeights(Edge const& e)
+SynapseLossImpl::Weights& SynapseLossImpl::getTrackedWeights(Edge const& e)
 {
 	auto it = mWeights.find(e);
 	if (it==mWeights.end()) {
-		ProjectionView const view = mGraph[e];
+		auto const& connectivity = mBioGraph.connectivity(e);
+		Weights weights;
+		weights.reserve(connectivity.size());
+		for (size_t i1 = 0; i1 < connectivity.num_sources(); ++i1) {
+			for (auto const& synapse : connectivity.targets(i1)) {
+				weights.push_back(synapse.weight);
+			}
+		}
 		mMutex.lock();
-		auto res = mWeights.insert(std::make_pair(e, Matrix(view.getWeights())));
+		auto res = mWeights.insert(std::make_pair(e, std::move(weights)));
 		mMutex.unlock();
 		if (!res.second) {
 			/// during concurrent insert it can happen, that one is faster than
@@ -3,9 +3,11 @@
 #include <boost/serialization/concurrent_unordered_map.h>
 #include <tbb/concurrent_unordered_map.h>
 #include <tbb/mutex.h>
+#include <vector>
 
 #include "hal/Coordinate/HICANN.h"
 
+#include "marocco/BioGraph.h"
 #include "marocco/assignment/PopulationSlice.h"
 #include "marocco/graph.h"
 #include "marocco/routing/SynapseLossProxy.h"
@@ -21,13 +23,14 @@ class SynapseLossImpl
 {
 public:
 	typedef SynapseLossProxy::Matrix Matrix;
+	typedef SynapseLossProxy::Weights Weights;
 	typedef SynapseLossProxy::value_type value_Type;
 
 	typedef graph_t::edge_descriptor Edge;
 	typedef HMF::Coordinate::HICANNOnWafer Index;
 	typedef assignment::PopulationSlice Assign;
 
-	SynapseLossImpl(graph_t const& graph);
+	SynapseLossImpl(BioGraph const& bio_graph);
 
 	// TODO: handle synapse loss of external inputs as well.
 
@@ -81,19 +84,30 @@ public:
 	/// fill weight matrices of MappingStats
 	void fill(pymarocco::MappingStats& stats) const;
 
+	/// update weight matrices of MappingStats filled by a previous run after the weights
+	/// (but not the synapses) of the given projection views changed
+	static void update_weights(
+		BioGraph const& bio_graph,
+		std::vector<Edge> const& edges,
+		pymarocco::MappingStats& stats);
+
 	static inline bool isRealWeight(double w)
 	{
 		return !std::isnan(w) && w > 0.;
 	}
 
-	Matrix const& getWeights(Edge const& e) const;
+	/// Dense view of the tracked weights of a projection view, i.e. its original weights
+	/// with lost synapses masked out.
+	/// @note This is assembled on each call and should only be used for inspection.
+	Matrix getWeights(Edge const& e) const;
 
 private:
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
-	Matrix& getWeights(Edge const& e);
+	Weights& getTrackedWeights(Edge const& e);
 
 	/// tracks synapse changes on a per ProjectionView basis.
-	tbb::concurrent_unordered_map<Edge, Matrix, std::hash<Edge> > mWeights;
+	/// Only weights of actual synapses are stored, cf. BioGraph::connectivity().
+	tbb::concurrent_unordered_map<Edge, Weights, std::hash<Edge> > mWeights;
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 
 	/// tracks number synapse of lost synapses on a HICANN basis.
@@ -102,6 +116,7 @@ private:
 
 	tbb::concurrent_unordered_map<Index, size_t, std::hash<Index> > mChipSet;
 
+	BioGraph const& mBioGraph;
 	graph_t const& mGraph;
 
 	tbb::mutex mMutex;
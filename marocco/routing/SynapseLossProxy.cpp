@@ -1,5 +1,6 @@
 #include "marocco/routing/SynapseLossProxy.h"
 #include <limits>
+#include <stdexcept>
 
 namespace marocco {
 namespace routing {
@@ -8,9 +9,23 @@ SynapseLossProxy::value_type const SynapseLossProxy::NA =
 	std::numeric_limits<SynapseLossProxy::value_type>::quiet_NaN();
 
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
-SynapseLossProxy::SynapseLossProxy(Matrix& weights, size_t& pre, size_t& post, size_t& set) :
-	mWeights(weights), mChipPre(pre), mChipPost(post), mChipSet(set)
+SynapseLossProxy::SynapseLossProxy(
+	SparseConnectivity const& connectivity,
+	Weights& weights,
+	size_t& pre,
+	size_t& post,
+	size_t& set) :
+	mConnectivity(connectivity), mWeights(weights), mChipPre(pre), mChipPost(post), mChipSet(set)
 {}
+
+SynapseLossProxy::value_type& SynapseLossProxy::weight(size_t i1, size_t i2)
+{
+	size_t const position = mConnectivity.position(i1, i2);
+	if (position >= mWeights.size()) {
+		throw std::runtime_error("mask non-existant weight (proxy)");
+	}
+	return mWeights[position];
+}
 #else
 SynapseLossProxy::SynapseLossProxy(size_t& pre, size_t& post, size_t& set) :
 	mChipPre(pre), mChipPost(post), mChipSet(set)
@@ -20,19 +35,14 @@ SynapseLossProxy::SynapseLossProxy(size_t& pre, size_t& post, size_t& set) :
 void SynapseLossProxy::addLoss(size_t i1, size_t i2)
 {
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
+	value_type& w = weight(i1, i2);
 #if !defined(MAROCCO_NDEBUG)
-	if (i1>=mWeights.size1()) {
-		throw std::runtime_error("out of range");
-	}
-	if (i2>=mWeights.size2()) {
-		throw std::runtime_error("out of range");
-	}
-	if (!isRealWeight(mWeights(i1, i2))) {
+	if (!isRealWeight(w)) {
 		throw std::runtime_error("mask non-existant weight (proxy)");
 	}
 #endif // MAROCCO_NDEBUG
 
-	mWeights(i1, i2) = NA;
+	w = NA;
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 	mChipPre++;
 	mChipPost++;
@@ -41,19 +51,14 @@ void SynapseLossProxy::addLoss(size_t i1, size_t i2)
 void SynapseLossProxy::updateWeight(size_t i1, size_t i2, double value)
 {
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
+	value_type& w = weight(i1, i2);
 #if !defined(MAROCCO_NDEBUG)
-	if (i1>=mWeights.size1()) {
-		throw std::runtime_error("out of range");
-	}
-	if (i2>=mWeights.size2()) {
-		throw std::runtime_error("out of range");
-	}
-	if (!isRealWeight(mWeights(i1, i2))) {
+	if (!isRealWeight(w)) {
 		throw std::runtime_error("mask non-existant weight (proxy)");
 	}
 #endif // MAROCCO_NDEBUG
 
-	mWeights(i1, i2) = value;
+	w = value;
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 	mChipSet++;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "marocco/graph.h"
 
 namespace marocco {
@@ -10,11 +12,19 @@ class SynapseLossProxy
 public:
 	typedef Connector::matrix_type Matrix;
 	typedef Matrix::value_type value_type;
+	/// Tracked weights of a projection view, in the order of the synapses of its
+	/// \c SparseConnectivity.
+	typedef std::vector<value_type> Weights;
 
 	static value_type const NA;
 
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
-	SynapseLossProxy(Matrix& weights, size_t& pre, size_t& post, size_t& set);
+	SynapseLossProxy(
+		SparseConnectivity const& connectivity,
+		Weights& weights,
+		size_t& pre,
+		size_t& post,
+		size_t& set);
 #else
 	SynapseLossProxy(size_t& pre, size_t& post, size_t& set);
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
@@ -33,7 +43,11 @@ public:
 
 private:
 #if !defined(MAROCCO_NO_SYNAPSE_TRACKING)
-	Matrix& mWeights;
+	/// @throw std::runtime_error If there is no synapse between the specified neurons.
+	value_type& weight(size_t i1, size_t i2);
+
+	SparseConnectivity const& mConnectivity;
+	Weights& mWeights;
 #endif // MAROCCO_NO_SYNAPSE_TRACKING
 	size_t& mChipPre;
 	size_t& mChipPost;
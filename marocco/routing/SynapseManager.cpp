@@ -26,14 +26,14 @@ SynapseManager::SynapseManager(Result const& resources) : mAllocation(), mLines(
 
 void SynapseManager::init(HistMap const& synapse_hist, HistMap const& synrow_hist)
 {
+	typedef SynapseHistogram H;
+
 	for (auto const& entry : mLines) {
 		VLineOnHICANN const& vline = entry.first;
 		size_t avail_drivers = entry.second;
 		Histogram const& synrow_histogram = synrow_hist.at(vline);
 		Histogram const& synapse_histogram = synapse_hist.at(vline);
 
-		// TODO: ensure that both Histograms have the same keys.
-
 		/////////////////////////////////////////////////////////////////////////
 		// Calculate requirements and synapse counts for different hierarchies //
 		/////////////////////////////////////////////////////////////////////////
@@ -44,57 +44,56 @@ void SynapseManager::init(HistMap const& synapse_hist, HistMap const& synrow_his
 		// 2) Nr of drivers per STP
 		// 3) Nr of rows per Side
 		// 4) Nr of half rows per hw-property;
-
-		// 0) build hierarchical maps with single keys instead of tuples.
-		typedef std::map<STPMode,
-						 std::map<Side, std::map<Parity, std::map<DriverDecoder, size_t> > > >
-			PerDecoderMap;
+		//
+		// Half rows and synapses per hw-property are read directly from the flat
+		// histograms, only hw-properties with requested half rows are considered.
 
 		typedef std::map<STPMode, std::map<Side, size_t> > PerSideMap;
 		typedef std::map<STPMode, size_t> PerSTPMap;
 
-		PerDecoderMap half_rows;
-		PerDecoderMap synapses;
-
 		PerSideMap rows_per_side;
 		PerSideMap synapses_per_side;
 
 		PerSTPMap drivers_per_stp;
 		PerSTPMap synapses_per_stp;
 
-		for (auto const& item : synrow_histogram) {
-			Side side;
-			Parity parity;
-			DriverDecoder decoder;
-			STPMode stp;
-			std::tie(side, parity, decoder, stp) = item.first;
-			size_t const half_row_count = item.second;
-			size_t const syn_count = synapse_histogram.at(item.first);
-
-			half_rows[stp][side][parity][decoder] = half_row_count;
-			synapses[stp][side][parity][decoder] = syn_count;
-			synapses_per_side[stp][side] += syn_count;
-			synapses_per_stp[stp] += syn_count;
-		}
-
 		// 1-4) calc requirements
 		size_t r_drivers = 0; // number of required drivers
-		for (auto const& stp_item : half_rows) {
-			STPMode const& stp = stp_item.first;
+		for (size_t stp_idx = 0; stp_idx < H::num_stp_modes; ++stp_idx) {
+			STPMode const stp = static_cast<STPMode>(stp_idx);
 			size_t req_rows_per_stp = 0;
-			for (auto const& side_item : stp_item.second) {
-				Side const& side = side_item.first;
+			bool stp_used = false;
+			for (size_t side_idx = 0; side_idx < H::num_sides; ++side_idx) {
+				Side const side(side_idx);
 				// The number of required rows per side is maximum of half rows per parity;
 				size_t req_rows_per_side = 0;
-				for (auto const& parity_item : side_item.second) {
-					size_t req_half_rows = std::accumulate(
-						parity_item.second.begin(), parity_item.second.end(), 0,
-						map_acc<DriverDecoder, size_t>());
+				bool side_used = false;
+				for (size_t parity = 0; parity < H::num_parities; ++parity) {
+					size_t req_half_rows = 0;
+					for (size_t decoder = 0; decoder < H::num_decoders; ++decoder) {
+						size_t const index = H::to_index(side_idx, parity, decoder, stp_idx);
+						size_t const half_row_count = synrow_histogram.at(index);
+						if (half_row_count == 0) {
+							continue;
+						}
+						size_t const syn_count = synapse_histogram.at(index);
+						req_half_rows += half_row_count;
+						synapses_per_side[stp][side] += syn_count;
+						synapses_per_stp[stp] += syn_count;
+						side_used = true;
+					}
 					if (req_half_rows > req_rows_per_side)
 						req_rows_per_side = req_half_rows;
 				}
+				if (!side_used) {
+					continue;
+				}
 				rows_per_side[stp][side] = req_rows_per_side;
 				req_rows_per_stp += req_rows_per_side;
+				stp_used = true;
+			}
+			if (!stp_used) {
+				continue;
 			}
 			size_t const req_drivers_per_stp =
 				size_t(std::ceil(req_rows_per_stp / 2.)); // 2 rows per driver
@@ -121,18 +120,33 @@ void SynapseManager::init(HistMap const& synapse_hist, HistMap const& synrow_his
 		}
 
 		// 3.) Half rows per decoder
-		PerDecoderMap assigned_half_rows;
+		H assigned_half_rows;
 
-		for (auto const& stp_item : half_rows) {
+		for (auto const& stp_item : rows_per_side) {
 			STPMode const& stp = stp_item.first;
 			for (auto const& side_item : stp_item.second) {
 				Side const& side = side_item.first;
 				// nr of assigned rows is equal to number of assigned half rows per parity
 				size_t assigned_rows = assigned_rows_per_side[stp][side];
-				for (auto const& parity_item : side_item.second) {
-					Parity const& parity = parity_item.first;
-					assigned_half_rows[stp][side][parity] = relative_reduction(
-						parity_item.second, synapses[stp][side][parity], assigned_rows);
+				for (size_t parity = 0; parity < H::num_parities; ++parity) {
+					std::map<DriverDecoder, size_t> half_rows;
+					std::map<DriverDecoder, size_t> synapses;
+					for (size_t decoder = 0; decoder < H::num_decoders; ++decoder) {
+						size_t const index = H::to_index(
+							side.value(), parity, decoder, static_cast<size_t>(stp));
+						if (synrow_histogram.at(index) == 0) {
+							continue;
+						}
+						half_rows[DriverDecoder(decoder)] = synrow_histogram.at(index);
+						synapses[DriverDecoder(decoder)] = synapse_histogram.at(index);
+					}
+					if (half_rows.empty()) {
+						continue;
+					}
+					for (auto const& item : relative_reduction(half_rows, synapses, assigned_rows)) {
+						assigned_half_rows[Side_Parity_Decoder_STP(
+							side, Parity(parity), item.first, stp)] = item.second;
+					}
 				}
 			}
 		}
@@ -145,7 +159,7 @@ void SynapseManager::init(HistMap const& synapse_hist, HistMap const& synrow_his
 
 		std::list<SynapseDriverOnHICANN>& real_drivers = mDrivers[vline];
 
-		for (auto const& stp_item : assigned_half_rows) {
+		for (auto const& stp_item : rows_per_side) {
 			STPMode const& stp = stp_item.first;
 
 			// allocate drivers and rows
@@ -171,14 +185,12 @@ void SynapseManager::init(HistMap const& synapse_hist, HistMap const& synrow_his
 					allocated_rows.pop_front();
 				}
 
-				for (auto const& parity_item : side_item.second) {
-					Parity const& parity = parity_item.first;
+				for (size_t parity = 0; parity < H::num_parities; ++parity) {
 					std::list<SynapseRowOnHICANN> my_rows_parity = my_rows; // copy!
-					for (auto const& decoder_item : parity_item.second) {
-						DriverDecoder const& decoder = decoder_item.first;
-						size_t const count = decoder_item.second;
+					for (size_t decoder = 0; decoder < H::num_decoders; ++decoder) {
 						Side_Parity_Decoder_STP const hw_synapse_property(
-							side, parity, decoder, stp);
+							side, Parity(parity), DriverDecoder(decoder), stp);
+						size_t const count = assigned_half_rows[hw_synapse_property];
 						for (size_t i = 0; i < count; ++i) {
 							auto const synrow_c = my_rows_parity.front();
 							my_rows_parity.pop_front();
@@ -199,6 +211,9 @@ std::ostream& operator<<(std::ostream& os, SynapseManager const& mgr)
 		auto const& vline = entry.first;
 		os << "    " << vline << " " << mgr.mLines.at(vline) << ": ";
 		for (auto const& item2 : entry.second) {
+			if (item2.second.empty()) {
+				continue;
+			}
 			os << item2.first << " " << item2.second.size() << "\n";
 		}
 		os << std::endl;
@@ -263,15 +278,13 @@ SynapseManager::SynapseStepper::SynapseStepper(
 		STPMode stp;
 		std::tie(side, parity) = side_parity_it->first;
 		std::tie(decoder, stp) = decoder_stp;
-		auto it = hw_prop_to_half_row.find(Side_Parity_Decoder_STP(side, parity, decoder, stp));
-		if (it != hw_prop_to_half_row.end()) {
-			hw_prop_to_half_row_it = it;
-			sub_row_it = hw_prop_to_half_row_it->second.begin();
-			if (sub_row_it != hw_prop_to_half_row_it->second.end()) {
-				syn_col_it = side_parity_it->second.begin();
-				_has_synapses = true;
-				break;
-			}
+		hw_prop_half_rows =
+			&hw_prop_to_half_row[Side_Parity_Decoder_STP(side, parity, decoder, stp)];
+		sub_row_it = hw_prop_half_rows->begin();
+		if (sub_row_it != hw_prop_half_rows->end()) {
+			syn_col_it = side_parity_it->second.begin();
+			_has_synapses = true;
+			break;
 		}
 		side_parity_it++;
 	}
@@ -298,7 +311,7 @@ void SynapseManager::SynapseStepper::update()
 	} else {
 		// next synapse row
 		sub_row_it++;
-		if (sub_row_it != hw_prop_to_half_row_it->second.end()) {
+		if (sub_row_it != hw_prop_half_rows->end()) {
 			syn_col_it = side_parity_it->second.begin();
 			_has_synapses = true;
 		} else {
@@ -311,16 +324,13 @@ void SynapseManager::SynapseStepper::update()
 				STPMode stp;
 				std::tie(side, parity) = side_parity_it->first;
 				std::tie(decoder, stp) = decoder_stp;
-				auto it =
-					hw_prop_to_half_row.find(Side_Parity_Decoder_STP(side, parity, decoder, stp));
-				if (it != hw_prop_to_half_row.end()) {
-					hw_prop_to_half_row_it = it;
-					sub_row_it = hw_prop_to_half_row_it->second.begin();
-					if (sub_row_it != hw_prop_to_half_row_it->second.end()) {
-						syn_col_it = side_parity_it->second.begin();
-						_has_synapses = true;
-						break;
-					}
+				hw_prop_half_rows =
+					&hw_prop_to_half_row[Side_Parity_Decoder_STP(side, parity, decoder, stp)];
+				sub_row_it = hw_prop_half_rows->begin();
+				if (sub_row_it != hw_prop_half_rows->end()) {
+					syn_col_it = side_parity_it->second.begin();
+					_has_synapses = true;
+					break;
 				}
 				side_parity_it++;
 			}
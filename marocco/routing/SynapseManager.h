@@ -35,10 +35,10 @@ public:
 	                                                                  // coordinates, used to map
 	                                                                  // half synapse rows HW
 	                                                                  // synapse properties
-	typedef std::map<Side_Parity_Decoder_STP, SubRows> Assignment; // assigned half synapse rows for
-																   // each HW synapse property
+	typedef HardwareSynapsePropertyArray<SubRows> Assignment; // assigned half synapse rows for
+	                                                          // each HW synapse property
 
-	typedef std::map<Side_Parity_Decoder_STP, size_t> Histogram;
+	typedef SynapseHistogram Histogram;
 	typedef std::unordered_map<HMF::Coordinate::VLineOnHICANN, Histogram> HistMap;
 
 	/// constructs the synapse row manager with results from driver assignment
@@ -160,8 +160,8 @@ public:
 		/// iterator pointing to the currently active (Side,Parity) combination
 		SynapseColumnsMap::const_iterator side_parity_it;
 
-		/// iterator pointing to current item in hw property to subrow map
-		Assignment::const_iterator hw_prop_to_half_row_it;
+		/// half rows of the current hw property
+		SubRows const* hw_prop_half_rows;
 
 		/// iterator pointing to the row of the next free synapse
 		SubRows::const_iterator sub_row_it;
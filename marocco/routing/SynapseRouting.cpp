@@ -4,6 +4,7 @@
 #include <functional>
 #include <iterator>
 #include <stdexcept>
+#include <vector>
 #include <boost/make_shared.hpp>
 
 #include "HMF/SynapseDecoderDisablingSynapse.h"
@@ -14,6 +15,7 @@
 #include "marocco/Logger.h"
 #include "marocco/routing/Fieres.h"
 #include "marocco/routing/HandleSynapseLoss.h"
+#include "marocco/routing/OptimalDriverAssignment.h"
 #include "marocco/routing/SynapseDriverRequirements.h"
 #include "marocco/routing/SynapseLoss.h"
 #include "marocco/routing/SynapseManager.h"
@@ -100,8 +102,9 @@ void SynapseRouting::run()
 	by_side_type<SynapseManager::HistMap> synrow_histogram;
 
 	for (auto const& route_item : m_l1_routing.find_routes_to(m_hicann)) {
-		auto const& route = route_item.route();
-		VLineOnHICANN const vline = boost::get<VLineOnHICANN>(route.back());
+		auto const route = route_item.segments();
+		auto const last_segment = route.back();
+		VLineOnHICANN const vline = boost::get<VLineOnHICANN>(last_segment);
 		DNCMergerOnWafer const source_dnc = route_item.source();
 
 		SideHorizontal drv_side = vline.toSideHorizontal();
@@ -111,7 +114,7 @@ void SynapseRouting::run()
 		}
 
 		auto const needed = drivers_required.calc(
-			source_dnc, m_bio_graph.graph(),
+			source_dnc, m_bio_graph,
 			synapse_histogram[drv_side][vline],
 			synrow_histogram[drv_side][vline]);
 
@@ -174,9 +177,26 @@ void SynapseRouting::run()
 			                        << m_hicann << " as defect/disabled");
 		}
 
-		Fieres fieres(requested_drivers, drv_side, chain_length, defect_list);
-		std::vector<VLineOnHICANN> const rejected = fieres.rejected();
-		auto const result = fieres.result();
+		Fieres::Rejected rejected;
+		Fieres::Result result;
+		switch (m_parameters.driver_assignment()) {
+			case parameters::SynapseRouting::DriverAssignment::fieres: {
+				Fieres fieres(requested_drivers, drv_side, chain_length, defect_list);
+				rejected = fieres.rejected();
+				result = fieres.result();
+				break;
+			}
+			case parameters::SynapseRouting::DriverAssignment::optimal: {
+				OptimalDriverAssignment assignment(
+					requested_drivers, drv_side, chain_length, defect_list,
+					std::chrono::duration<double>(m_parameters.driver_assignment_time_budget()));
+				rejected = assignment.rejected();
+				result = assignment.result();
+				break;
+			}
+			default:
+				throw std::runtime_error("unknown synapse driver assignment algorithm");
+		}
 
 		{
 			size_t used = 0;
@@ -209,15 +229,15 @@ void SynapseRouting::run()
 		{
 			VLineOnHICANN const& vline = entry.first;
 			auto const& route_item = route_item_by_source[drv_side].at(vline).get();
-			auto const& route = route_item.route();
 			DNCMergerOnWafer const route_source_merger = route_item.source();
-			HICANNOnWafer const route_source_hicann = route.source_hicann();
+			// Routes always start on the HICANN of their DNC merger.
+			HICANNOnWafer const route_source_hicann = route_source_merger.toHICANNOnWafer();
 			assert(route_item.target() == m_hicann);
 			MAROCCO_TRACE(
 			    "======================================================================\n"
 			    "route from "
-			    << route_source_merger << " to " << route.back() << " on "
-			    << route.target_hicann());
+			    << route_source_merger << " to " << vline << " on "
+			    << route_item.segments().target_hicann());
 
 			SynapseManager::SynapsesOnVLine synapses_on_vline =
 				syn_manager.getSynapses(vline, synapse_type_to_synapse_columns_map);
@@ -300,10 +320,29 @@ void SynapseRouting::run()
 					m_synapse_loss->getProxy(edge, route_source_hicann, m_hicann);
 
 				auto const proj_view = boost::make_shared<ProjectionView>(m_bio_graph.graph()[edge]);
-				Connector::const_matrix_view_type const bio_weights = proj_view->getWeights();
+				auto const& connectivity = m_bio_graph.connectivity(edge);
 				SynapseType const syntype_proj = toSynapseType(proj_view->projection()->target());
 				STPMode const stp_proj = toSTPMode(proj_view->projection()->dynamics());
 
+				// Neurons of the target population placed to the current HICANN, indexed
+				// by their relative index in the projection view.
+				std::vector<placement::results::Placement::item_type const*> targets_on_hicann(
+					connectivity.num_targets(), nullptr);
+				for (auto const& target_item : m_neuron_placement.find(target)) {
+					auto const& neuron_block = target_item.neuron_block();
+					if (neuron_block == boost::none ||
+						neuron_block->toHICANNOnWafer() != m_hicann) {
+						continue;
+					}
+
+					if (!proj_view->post().mask()[target_item.neuron_index()]) {
+						continue;
+					}
+
+					targets_on_hicann[to_relative_index(
+						proj_view->post().mask(), target_item.neuron_index())] = &target_item;
+				}
+
 				for (auto const& source_item : m_neuron_placement.find(source)) {
 					auto const& address = source_item.address();
 					// Only process source neuron placements matching current route.
@@ -318,34 +357,23 @@ void SynapseRouting::run()
 
 					MAROCCO_TRACE("from " << source_item.bio_neuron() << " with " << *address);
 
-					for (auto const& target_item : m_neuron_placement.find(target)) {
-						auto const& neuron_block = target_item.neuron_block();
-						// Only process targets on current HICANN.
-						if (neuron_block == boost::none ||
-							neuron_block->toHICANNOnWafer() != m_hicann) {
-							continue;
-						}
+					size_t const src_neuron_in_proj_view =
+						to_relative_index(proj_view->pre().mask(), source_item.neuron_index());
 
-						if (!proj_view->post().mask()[target_item.neuron_index()]) {
+					// Only visit actual synapses, i.e. non-zero entries of the weight matrix.
+					for (auto const& synapse : connectivity.targets(src_neuron_in_proj_view)) {
+						size_t const trg_neuron_in_proj_view = synapse.index;
+						auto const* target_item_ptr = targets_on_hicann[trg_neuron_in_proj_view];
+						// Only process targets on current HICANN.
+						if (target_item_ptr == nullptr) {
 							continue;
 						}
+						auto const& target_item = *target_item_ptr;
 
 						MAROCCO_TRACE(
 						    "to " << target_item.bio_neuron() << " at "
 						          << target_item.logical_neuron().front());
 
-						size_t const src_neuron_in_proj_view =
-							to_relative_index(proj_view->pre().mask(), source_item.neuron_index());
-						size_t const trg_neuron_in_proj_view =
-							to_relative_index(proj_view->post().mask(), target_item.neuron_index());
-
-						double const weight =
-							bio_weights(src_neuron_in_proj_view, trg_neuron_in_proj_view);
-
-						if (std::isnan(weight) || weight <= 0.) {
-							continue;
-						}
-
 						auto const& logical_neuron = target_item.logical_neuron();
 						assert(!logical_neuron.is_external());
 						NeuronOnHICANN const target_nrn = logical_neuron.front();
@@ -1,15 +1,20 @@
 #pragma once
 
-#include "sthal/Wafer.h"
+#include "marocco/routing/Configuration.h"
 #include "marocco/routing/results/SynapseRouting.h"
 
 namespace marocco {
 namespace routing {
 
+/**
+ * @brief Records the configuration of synapse drivers and synapse switches.
+ * Changes are applied when calling \c ConfigurationChanges::apply(), the given results
+ * have to be kept alive until then.
+ */
 class SynapseRoutingConfigurator
 {
 public:
-	SynapseRoutingConfigurator(sthal::Wafer& hardware);
+	SynapseRoutingConfigurator(ConfigurationChanges& changes);
 
 	void run(
 	    HMF::Coordinate::HICANNOnWafer const& hicann,
@@ -27,14 +32,7 @@ private:
 	    HMF::Coordinate::SynapseDriverOnHICANN const& driver,
 		HMF::Coordinate::VLineOnHICANN const& vline);
 
-	/**
-	 * @brief Connect adjacent synapse drivers.
-	 */
-	void connect_drivers(
-		HMF::Coordinate::HICANNOnWafer const& hicann,
-		results::ConnectedSynapseDrivers const& connected_drivers);
-
-	sthal::Wafer& m_hardware;
+	ConfigurationChanges& m_changes;
 }; // SynapseRoutingConfigurator
 
 } // namespace routing
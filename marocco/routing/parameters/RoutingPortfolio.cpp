@@ -0,0 +1,70 @@
+#include "marocco/routing/parameters/RoutingPortfolio.h"
+
+#include <stdexcept>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+
+namespace marocco {
+namespace routing {
+namespace parameters {
+
+RoutingPortfolio::RoutingPortfolio() : m_candidates(), m_deadline(0.)
+{
+}
+
+void RoutingPortfolio::add(L1Routing const& candidate)
+{
+	m_candidates.push_back(candidate);
+}
+
+L1Routing RoutingPortfolio::get(size_t const index) const
+{
+	return m_candidates.at(index);
+}
+
+size_t RoutingPortfolio::size() const
+{
+	return m_candidates.size();
+}
+
+bool RoutingPortfolio::empty() const
+{
+	return m_candidates.empty();
+}
+
+void RoutingPortfolio::clear()
+{
+	m_candidates.clear();
+}
+
+void RoutingPortfolio::deadline(double const seconds)
+{
+	if (seconds < 0.) {
+		throw std::invalid_argument("deadline has to be non-negative");
+	}
+	m_deadline = seconds;
+}
+
+double RoutingPortfolio::deadline() const
+{
+	return m_deadline;
+}
+
+template <typename Archive>
+void RoutingPortfolio::serialize(Archive& ar, unsigned int const /* version */)
+{
+	using namespace boost::serialization;
+	// clang-format off
+	ar & make_nvp("candidates", m_candidates)
+	   & make_nvp("deadline", m_deadline);
+	// clang-format on
+}
+
+} // namespace parameters
+} // namespace routing
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_IMPLEMENT(::marocco::routing::parameters::RoutingPortfolio)
+
+#include "boost/serialization/serialization_helper.tcc"
+EXPLICIT_INSTANTIATE_BOOST_SERIALIZE(::marocco::routing::parameters::RoutingPortfolio)
@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef PYPLUSPLUS
+#include <vector>
+#endif // !PYPLUSPLUS
+
+#include <boost/serialization/export.hpp>
+
+#include "marocco/routing/parameters/L1Routing.h"
+
+namespace boost {
+namespace serialization {
+class access;
+} // namespace serialization
+} // namespace boost
+
+namespace marocco {
+namespace routing {
+namespace parameters {
+
+/**
+ * @brief Alternative configurations of the L1 routing, which are tried concurrently.
+ * If candidates are given, routing is carried out once for each of them, starting from
+ * the same placement.  The candidate with the least synapse loss is used as the result.
+ * The parameters in \c PyMarocco::l1_routing are ignored in this case.
+ */
+class RoutingPortfolio {
+public:
+	RoutingPortfolio();
+
+	/**
+	 * @brief Adds a candidate configuration.
+	 * Candidates with equal synapse loss are preferred in the order they were added.
+	 */
+	void add(L1Routing const& candidate);
+
+	/**
+	 * @brief Returns the candidate configuration with the given index.
+	 * @throw std::out_of_range If there is no such candidate.
+	 */
+	L1Routing get(size_t index) const;
+
+	size_t size() const;
+	bool empty() const;
+	void clear();
+
+	/**
+	 * @brief Sets the wall time in seconds each candidate may spend on L1 routing.
+	 * After the deadline has passed, routes from remaining DNC mergers are reported as
+	 * failed, so candidates exceeding it are penalized by their increased synapse loss.
+	 * Defaults to zero, which disables the deadline.
+	 * @throw std::invalid_argument If the specified time is negative.
+	 */
+	void deadline(double seconds);
+	double deadline() const;
+
+private:
+#ifndef PYPLUSPLUS
+	std::vector<L1Routing> m_candidates;
+#endif // !PYPLUSPLUS
+	double m_deadline;
+
+	friend class boost::serialization::access;
+	template <typename Archive>
+	void serialize(Archive& ar, unsigned int const /* version */);
+}; // RoutingPortfolio
+
+} // namespace parameters
+} // namespace routing
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_KEY(::marocco::routing::parameters::RoutingPortfolio)
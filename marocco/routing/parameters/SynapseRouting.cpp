@@ -12,7 +12,10 @@ namespace routing {
 namespace parameters {
 
 SynapseRouting::SynapseRouting()
-	: m_driver_chain_length(3), m_only_allow_background_events(false)
+	: m_driver_chain_length(3),
+	  m_only_allow_background_events(false),
+	  m_driver_assignment(DriverAssignment::fieres),
+	  m_driver_assignment_time_budget(1.)
 {
 }
 
@@ -40,14 +43,46 @@ bool SynapseRouting::only_allow_background_events() const
 	return m_only_allow_background_events;
 }
 
+void SynapseRouting::driver_assignment(DriverAssignment value)
+{
+	m_driver_assignment = value;
+}
+
+auto SynapseRouting::driver_assignment() const -> DriverAssignment
+{
+	return m_driver_assignment;
+}
+
+void SynapseRouting::driver_assignment_time_budget(double seconds)
+{
+	if (seconds < 0.) {
+		throw std::invalid_argument("time budget has to be non-negative");
+	}
+	m_driver_assignment_time_budget = seconds;
+}
+
+double SynapseRouting::driver_assignment_time_budget() const
+{
+	return m_driver_assignment_time_budget;
+}
+
 template <typename Archive>
-void SynapseRouting::serialize(Archive& ar, unsigned int const /* version */)
+void SynapseRouting::serialize(Archive& ar, unsigned int const version)
 {
 	using namespace boost::serialization;
 	// clang-format off
 	ar & make_nvp("driver_chain_length", m_driver_chain_length)
 	   & make_nvp("only_allow_background_events", m_only_allow_background_events);
 	// clang-format on
+	if (version > 0) {
+		// clang-format off
+		ar & make_nvp("driver_assignment", m_driver_assignment)
+		   & make_nvp("driver_assignment_time_budget", m_driver_assignment_time_budget);
+		// clang-format on
+	} else if (Archive::is_loading::value) {
+		m_driver_assignment = DriverAssignment::fieres;
+		m_driver_assignment_time_budget = 1.;
+	}
 }
 
 } // namespace parameters
@@ -1,6 +1,9 @@
 #pragma once
 
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
+
+#include "pywrap/compat/macros.hpp"
 
 namespace boost {
 namespace serialization {
@@ -16,6 +19,14 @@ class SynapseRouting {
 public:
 	SynapseRouting();
 
+	PYPP_CLASS_ENUM(DriverAssignment)
+	{
+		/// Proportional rescaling of requested drivers followed by bin packing.
+		fieres,
+		/// Branch and bound search maximizing the number of realized synapses.
+		optimal
+	};
+
 	/**
 	 * @brief Sets the maximum length of chained synapse drivers.
 	 * As only a single synapse driver can be connected to a given vertical L1 bus, an
@@ -34,9 +45,29 @@ public:
 	void only_allow_background_events(bool enable);
 	bool only_allow_background_events() const;
 
+	/**
+	 * @brief Sets the algorithm used to assign synapse drivers to vertical L1 buses.
+	 * The \c optimal assignment starts from the solution found by \c fieres and is
+	 * never worse, but may take considerably longer if there are more requested than
+	 * available synapse drivers.
+	 */
+	void driver_assignment(DriverAssignment value);
+	DriverAssignment driver_assignment() const;
+
+	/**
+	 * @brief Sets the time in seconds the \c optimal driver assignment may spend on
+	 *        each side of a HICANN.
+	 * If the time budget is exhausted, the best assignment found so far is used.
+	 * @throw std::invalid_argument If the specified time is negative.
+	 */
+	void driver_assignment_time_budget(double seconds);
+	double driver_assignment_time_budget() const;
+
 private:
 	size_t m_driver_chain_length;
 	bool m_only_allow_background_events;
+	DriverAssignment m_driver_assignment;
+	double m_driver_assignment_time_budget;
 
 	friend class boost::serialization::access;
 	template <typename Archive>
@@ -48,3 +79,4 @@ private:
 } // namespace marocco
 
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::parameters::SynapseRouting)
+BOOST_CLASS_VERSION(::marocco::routing::parameters::SynapseRouting, 1)
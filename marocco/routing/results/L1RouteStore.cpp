@@ -0,0 +1,319 @@
+#include "marocco/routing/results/L1RouteStore.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <boost/mpl/at.hpp>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/distance.hpp>
+#include <boost/mpl/find.hpp>
+#include <boost/mpl/size.hpp>
+#include <boost/optional.hpp>
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace routing {
+namespace results {
+
+namespace {
+
+typedef L1Route::segment_type::types segment_types;
+
+/// Index of the given segment type in \c L1Route::segment_type.
+template <typename T>
+struct segment_tag
+	: std::integral_constant<
+		  size_t,
+		  boost::mpl::distance<
+			  typename boost::mpl::begin<segment_types>::type,
+			  typename boost::mpl::find<segment_types, T>::type>::value>
+{
+};
+
+size_t const num_tags = boost::mpl::size<segment_types>::value;
+size_t const payload_bits = 12;
+size_t const payload_mask = (1u << payload_bits) - 1;
+
+L1RouteStore::handle_type const root = std::numeric_limits<L1RouteStore::handle_type>::max();
+
+static_assert(num_tags <= (1u << (16 - payload_bits)), "segment tag does not fit into word");
+
+template <size_t N>
+typename std::enable_if<(N == num_tags), L1Route::segment_type>::type make_segment(
+	size_t /* tag */, size_t /* value */)
+{
+	throw std::runtime_error("invalid segment tag in stored L1 route");
+}
+
+template <size_t N>
+typename std::enable_if<(N < num_tags), L1Route::segment_type>::type make_segment(
+	size_t tag, size_t value)
+{
+	if (tag == N) {
+		typedef typename boost::mpl::at_c<segment_types, N>::type type;
+		typedef typename std::decay<decltype(std::declval<type>().toEnum())>::type enum_type;
+		return type(enum_type(value));
+	}
+	return make_segment<N + 1>(tag, value);
+}
+
+class EncodeVisitor : public boost::static_visitor<>
+{
+public:
+	EncodeVisitor(size_t tag, std::vector<uint16_t>& words) : m_tag(tag), m_words(words) {}
+
+	template <typename T>
+	void operator()(T const& segment) const
+	{
+		size_t const value = segment.toEnum().value();
+		if (value > payload_mask) {
+			throw std::out_of_range("segment of L1 route can not be encoded");
+		}
+		m_words.push_back(uint16_t((m_tag << payload_bits) | value));
+	}
+
+	void operator()(SynapseOnHICANN const& segment) const
+	{
+		// Synapses do not fit into a single word, so their value is stored separately.
+		m_words.push_back(uint16_t(m_tag << payload_bits));
+		m_words.push_back(uint16_t(segment.toEnum().value()));
+	}
+
+private:
+	size_t m_tag;
+	std::vector<uint16_t>& m_words;
+}; // EncodeVisitor
+
+} // namespace
+
+L1RouteStore::segments_type::iterator::iterator() : m_store(nullptr), m_node(nullptr)
+{
+}
+
+L1RouteStore::segments_type::iterator::iterator(
+	L1RouteStore const& store, handle_type const* node)
+	: m_store(&store), m_node(node)
+{
+}
+
+bool L1RouteStore::segments_type::iterator::equal(iterator const& other) const
+{
+	return m_node == other.m_node;
+}
+
+void L1RouteStore::segments_type::iterator::increment()
+{
+	// Synapses span two words, see \c EncodeVisitor.
+	if ((m_store->m_words[*m_node] >> payload_bits) == segment_tag<SynapseOnHICANN>::value) {
+		++m_node;
+	}
+	++m_node;
+}
+
+L1Route::segment_type L1RouteStore::segments_type::iterator::dereference() const
+{
+	word_type const word = m_store->m_words[*m_node];
+	size_t const tag = word >> payload_bits;
+	if (tag == segment_tag<SynapseOnHICANN>::value) {
+		return make_segment<0>(tag, m_store->m_words[*std::next(m_node)]);
+	}
+	return make_segment<0>(tag, word & payload_mask);
+}
+
+L1RouteStore::segments_type::segments_type(L1RouteStore const& store, handle_type const handle)
+	: m_store(&store), m_nodes()
+{
+	store.nodes(handle, m_nodes);
+	// Check that synapses are not truncated, so that iteration always reaches the end.
+	for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+		if ((store.m_words[*it] >> payload_bits) == segment_tag<SynapseOnHICANN>::value &&
+		    ++it == m_nodes.end()) {
+			throw std::runtime_error("truncated synapse in stored L1 route");
+		}
+	}
+}
+
+auto L1RouteStore::segments_type::begin() const -> iterator
+{
+	return iterator(*m_store, m_nodes.data());
+}
+
+auto L1RouteStore::segments_type::end() const -> iterator
+{
+	return iterator(*m_store, m_nodes.data() + m_nodes.size());
+}
+
+L1Route::segment_type L1RouteStore::segments_type::back() const
+{
+	auto last = begin();
+	for (auto it = begin(), end_ = end(); it != end_; ++it) {
+		last = it;
+	}
+	return *last;
+}
+
+HICANNOnWafer L1RouteStore::segments_type::source_hicann() const
+{
+	auto const segment = *begin();
+	if (auto const* hicann = boost::get<HICANNOnWafer>(&segment)) {
+		return *hicann;
+	}
+	throw std::logic_error("route does not start with HICANNOnWafer");
+}
+
+HICANNOnWafer L1RouteStore::segments_type::target_hicann() const
+{
+	boost::optional<HICANNOnWafer> result;
+	for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+		word_type const word = m_store->m_words[*it];
+		size_t const tag = word >> payload_bits;
+		if (tag == segment_tag<HICANNOnWafer>::value) {
+			result = HICANNOnWafer(Enum(word & payload_mask));
+		} else if (tag == segment_tag<SynapseOnHICANN>::value) {
+			++it;
+		}
+	}
+	if (!result) {
+		throw std::logic_error("route does not contain HICANNOnWafer");
+	}
+	return *result;
+}
+
+std::vector<HICANNOnWafer> L1RouteStore::segments_type::hicanns() const
+{
+	std::vector<HICANNOnWafer> result;
+	for (auto it = m_nodes.begin(); it != m_nodes.end(); ++it) {
+		word_type const word = m_store->m_words[*it];
+		size_t const tag = word >> payload_bits;
+		if (tag == segment_tag<HICANNOnWafer>::value) {
+			result.push_back(HICANNOnWafer(Enum(word & payload_mask)));
+		} else if (tag == segment_tag<SynapseOnHICANN>::value) {
+			++it;
+		}
+	}
+	return result;
+}
+
+L1Route L1RouteStore::segments_type::route() const
+{
+	L1Route::sequence_type segments;
+	segments.reserve(m_nodes.size());
+	segments.assign(begin(), end());
+	// Routes have already been verified when they were stored.
+	return L1Route(std::move(segments), L1Route::no_verify_tag());
+}
+
+L1RouteStore::L1RouteStore() : m_words(), m_parents()
+{
+}
+
+auto L1RouteStore::add(L1Route const& route, std::vector<handle_type> const& candidates)
+	-> handle_type
+{
+	if (route.empty()) {
+		throw std::invalid_argument("can not store empty L1 route");
+	}
+
+	std::vector<word_type> words;
+	encode(route, words);
+
+	// Find longest common prefix with one of the candidates.
+	handle_type parent = root;
+	size_t shared = 0;
+	std::vector<handle_type> candidate_nodes;
+	for (auto const candidate : candidates) {
+		nodes(candidate, candidate_nodes);
+		size_t common = 0;
+		while (common < candidate_nodes.size() && common < words.size() &&
+		       m_words[candidate_nodes[common]] == words[common]) {
+			++common;
+		}
+		if (common > shared) {
+			shared = common;
+			parent = candidate_nodes[common - 1];
+		}
+	}
+
+	if (m_words.size() + words.size() - shared >= root) {
+		throw std::length_error("too many L1 route segments");
+	}
+
+	for (size_t ii = shared; ii < words.size(); ++ii) {
+		m_words.push_back(words[ii]);
+		m_parents.push_back(parent);
+		parent = m_words.size() - 1;
+	}
+
+	return parent;
+}
+
+L1Route L1RouteStore::get(handle_type const handle) const
+{
+	return segments(handle).route();
+}
+
+auto L1RouteStore::segments(handle_type const handle) const -> segments_type
+{
+	return segments_type(*this, handle);
+}
+
+std::vector<HICANNOnWafer> L1RouteStore::hicanns(handle_type const handle) const
+{
+	return segments(handle).hicanns();
+}
+
+size_t L1RouteStore::size() const
+{
+	return m_words.size();
+}
+
+void L1RouteStore::clear()
+{
+	m_words.clear();
+	m_parents.clear();
+}
+
+void L1RouteStore::encode(L1Route const& route, std::vector<word_type>& words)
+{
+	words.reserve(route.size());
+	for (auto const& segment : route) {
+		boost::apply_visitor(EncodeVisitor(segment.which(), words), segment);
+	}
+}
+
+void L1RouteStore::nodes(handle_type handle, std::vector<handle_type>& nodes) const
+{
+	if (handle >= m_words.size()) {
+		throw std::out_of_range("no such L1 route");
+	}
+
+	nodes.clear();
+	for (; handle != root; handle = m_parents[handle]) {
+		nodes.push_back(handle);
+	}
+	std::reverse(nodes.begin(), nodes.end());
+}
+
+template <typename Archiver>
+void L1RouteStore::serialize(Archiver& ar, const unsigned int /* version */)
+{
+	using namespace boost::serialization;
+	// clang-format off
+	ar & make_nvp("words", m_words)
+	   & make_nvp("parents", m_parents);
+	// clang-format on
+}
+
+} // namespace results
+} // namespace routing
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_IMPLEMENT(::marocco::routing::results::L1RouteStore)
+
+#include "boost/serialization/serialization_helper.tcc"
+EXPLICIT_INSTANTIATE_BOOST_SERIALIZE(::marocco::routing::results::L1RouteStore)
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/serialization/export.hpp>
+
+#include "hal/Coordinate/HICANN.h"
+
+#include "marocco/coordinates/L1Route.h"
+
+namespace boost {
+namespace serialization {
+class access;
+} // namespace serialization
+} // namespace boost
+
+namespace marocco {
+namespace routing {
+namespace results {
+
+/**
+ * @brief Compact storage of L1 routes.
+ * Route segments are encoded as tagged 16 bit words (type of segment in the upper 4
+ * bits, its enum value in the lower 12 bits; synapses need an additional word) and
+ * stored in one contiguous arena.  Each word is a node of a prefix tree which only
+ * stores the index of its parent node, so that routes can share common prefixes, e.g.
+ * routes from the same DNC merger to different target HICANNs.  A route is identified by
+ * the node holding its last word.
+ */
+class L1RouteStore
+{
+public:
+	typedef uint32_t handle_type;
+
+	/**
+	 * @brief Segments of a stored route, decoded on access.
+	 * This allows to traverse a route without reconstructing it as an \c L1Route.
+	 * @note Only refers to the store it was obtained from, thus it is only valid as long
+	 *       as that store is alive.
+	 */
+	class segments_type
+	{
+	public:
+		class iterator : public boost::iterator_facade<iterator,
+		                                               L1Route::segment_type,
+		                                               boost::forward_traversal_tag,
+		                                               // Return copy instead of reference:
+		                                               L1Route::segment_type>
+		{
+		public:
+			iterator();
+
+		private:
+			friend class segments_type;
+			friend class boost::iterator_core_access;
+
+			iterator(L1RouteStore const& store, handle_type const* node);
+
+			bool equal(iterator const& other) const;
+			void increment();
+			L1Route::segment_type dereference() const;
+
+			L1RouteStore const* m_store;
+			handle_type const* m_node;
+		}; // iterator
+
+		iterator begin() const;
+		iterator end() const;
+
+		L1Route::segment_type back() const;
+		HMF::Coordinate::HICANNOnWafer source_hicann() const;
+		HMF::Coordinate::HICANNOnWafer target_hicann() const;
+
+		/// HICANNs traversed by the route in order.
+		std::vector<HMF::Coordinate::HICANNOnWafer> hicanns() const;
+
+		/// Reconstruct the full route.
+		L1Route route() const;
+
+	private:
+		friend class L1RouteStore;
+		segments_type(L1RouteStore const& store, handle_type handle);
+
+		L1RouteStore const* m_store;
+		/// Nodes of the route starting from the root of the prefix tree.
+		std::vector<handle_type> m_nodes;
+	}; // segments_type
+
+	L1RouteStore();
+
+	/**
+	 * @brief Store the given route.
+	 * @param candidates Previously stored routes which may share a prefix with the
+	 *        given route.  The longest common prefix is reused.
+	 * @throw std::invalid_argument If the route is empty.
+	 */
+	handle_type add(L1Route const& route, std::vector<handle_type> const& candidates);
+
+	/**
+	 * @brief Reconstruct the given route.
+	 * @throw std::out_of_range If there is no such route.
+	 * @see segments() for traversal without a copy of the route.
+	 */
+	L1Route get(handle_type handle) const;
+
+	/**
+	 * @brief Return the segments of the given route.
+	 * @throw std::out_of_range If there is no such route.
+	 */
+	segments_type segments(handle_type handle) const;
+
+	/**
+	 * @brief Return the HICANNs traversed by the given route in order, without
+	 *        reconstructing the full route.
+	 * @throw std::out_of_range If there is no such route.
+	 */
+	std::vector<HMF::Coordinate::HICANNOnWafer> hicanns(handle_type handle) const;
+
+	/// Number of stored words, i.e. nodes of the prefix tree.
+	size_t size() const;
+
+	void clear();
+
+private:
+	typedef uint16_t word_type;
+
+	static void encode(L1Route const& route, std::vector<word_type>& words);
+
+	/// Nodes of the given route starting from the root of the prefix tree.
+	void nodes(handle_type handle, std::vector<handle_type>& nodes) const;
+
+	std::vector<word_type> m_words;
+	/// Parent of each node, \c root for the first word of a route.
+	std::vector<handle_type> m_parents;
+
+	friend class boost::serialization::access;
+	template <typename Archiver>
+	void serialize(Archiver& ar, const unsigned int /* version */);
+}; // L1RouteStore
+
+} // namespace results
+} // namespace routing
+} // namespace marocco
+
+BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::L1RouteStore)
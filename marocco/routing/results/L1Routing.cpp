@@ -2,8 +2,12 @@
 
 #include "hal/Coordinate/Relations.h"
 
+#include <algorithm>
 #include <boost/serialization/nvp.hpp>
 
+#include "marocco/results/Revision.h"
+#include "marocco/util/pack_records.h"
+
 using namespace HMF::Coordinate;
 using boost::multi_index::get;
 
@@ -11,42 +15,66 @@ namespace marocco {
 namespace routing {
 namespace results {
 
-L1Routing::route_item_type::route_item_type()
-{
-}
+namespace {
+
+/**
+ * @brief Route store to be used by route items during deserialization.
+ * Set by \c L1Routing::serialize(), as items are deserialized by the multi-index
+ * container and do not have access to their owning routing result.
+ */
+thread_local std::shared_ptr<L1RouteStore> const* deserialization_store = nullptr;
 
-L1Routing::route_item_type::route_item_type(L1Route const& route, target_type const& target)
-	: m_route(route), m_source(), m_target(target)
+class DeserializationStoreGuard
 {
-	if (route.empty()) {
-		throw std::invalid_argument("empty route in routing result");
+public:
+	DeserializationStoreGuard(std::shared_ptr<L1RouteStore> const& store)
+	{
+		deserialization_store = &store;
 	}
 
-	auto const* merger = boost::get<DNCMergerOnHICANN>(&route.front());
-	if (merger == nullptr) {
-		throw std::invalid_argument("route does not start with DNC merger");
+	~DeserializationStoreGuard()
+	{
+		deserialization_store = nullptr;
 	}
+}; // DeserializationStoreGuard
 
-	auto const* vline = boost::get<VLineOnHICANN>(&route.back());
-	if (vline == nullptr) {
-		throw std::invalid_argument("route does not end on vertical bus");
-	}
+} // namespace
 
-	HICANNOnWafer const& route_target_hicann = route.target_hicann();
-	if (target != route_target_hicann &&
-	    target != ((vline->toSideHorizontal() == left) ? route_target_hicann.west()
-	                                                   : route_target_hicann.east())) {
-		throw std::invalid_argument(
-			"target HICANN has to match end of route or adjacent HICANN");
+L1Routing::route_item_type::route_item_type()
+	: m_store(nullptr), m_handle(0), m_source(), m_target()
+{
+}
+
+L1Routing::route_item_type::route_item_type(
+	std::shared_ptr<L1RouteStore const> store,
+	L1RouteStore::handle_type const handle,
+	source_type const& source,
+	target_type const& target)
+	: m_store(std::move(store)), m_handle(handle), m_source(source), m_target(target)
+{
+}
+
+L1RouteStore const& L1Routing::route_item_type::store() const
+{
+	if (m_store == nullptr) {
+		throw std::runtime_error("route item is not part of a routing result");
 	}
+	return *m_store;
+}
+
+L1Route L1Routing::route_item_type::route() const
+{
+	return store().get(m_handle);
+}
 
-	HICANNOnWafer hicann = m_route.source_hicann();
-	m_source = DNCMergerOnWafer(*merger, hicann);
+L1RouteStore::segments_type L1Routing::route_item_type::segments() const
+{
+	return store().segments(m_handle);
 }
 
-L1Route const& L1Routing::route_item_type::route() const
+std::vector<HICANNOnWafer> L1Routing::route_item_type::hicanns() const
 {
-	return m_route;
+	return store().hicanns(m_handle);
 }
 
 auto L1Routing::route_item_type::source() const -> source_type const&
@@ -92,12 +120,83 @@ auto L1Routing::projection_item_type::target() const -> target_type const&
 	return m_target;
 }
 
+L1Routing::L1Routing()
+	: m_store(std::make_shared<L1RouteStore>()),
+	  m_routes(),
+	  m_projections(),
+	  m_revision(::marocco::results::next_revision())
+{
+}
+
+L1Routing::L1Routing(L1Routing const& other)
+	: m_store(std::make_shared<L1RouteStore>(*other.m_store)),
+	  m_routes(),
+	  m_projections(other.m_projections),
+	  m_revision(other.m_revision)
+{
+	// Items have to refer to the copy of the route store.
+	for (auto const& item : other.m_routes) {
+		m_routes.insert(route_item_type(m_store, item.m_handle, item.source(), item.target()));
+	}
+}
+
+L1Routing& L1Routing::operator=(L1Routing const& other)
+{
+	if (this != &other) {
+		L1Routing copy(other);
+		std::swap(m_store, copy.m_store);
+		m_routes.swap(copy.m_routes);
+		m_projections.swap(copy.m_projections);
+		m_revision = copy.m_revision;
+	}
+	return *this;
+}
+
+auto L1Routing::check_route(L1Route const& route, target_type const& target) -> source_type
+{
+	if (route.empty()) {
+		throw std::invalid_argument("empty route in routing result");
+	}
+
+	auto const* merger = boost::get<DNCMergerOnHICANN>(&route.front());
+	if (merger == nullptr) {
+		throw std::invalid_argument("route does not start with DNC merger");
+	}
+
+	auto const* vline = boost::get<VLineOnHICANN>(&route.back());
+	if (vline == nullptr) {
+		throw std::invalid_argument("route does not end on vertical bus");
+	}
+
+	HICANNOnWafer const& route_target_hicann = route.target_hicann();
+	if (target != route_target_hicann &&
+	    target != ((vline->toSideHorizontal() == left) ? route_target_hicann.west()
+	                                                   : route_target_hicann.east())) {
+		throw std::invalid_argument(
+			"target HICANN has to match end of route or adjacent HICANN");
+	}
+
+	return DNCMergerOnWafer(*merger, route.source_hicann());
+}
+
 auto L1Routing::add(L1Route const& route, target_type const& target) -> route_item_type const&
 {
-	auto const res = m_routes.insert(route_item_type(route, target));
-	if (!res.second) {
+	auto const source = check_route(route, target);
+
+	auto& by_source_and_target = get<source_and_target_type>(m_routes);
+	if (by_source_and_target.find(boost::make_tuple(source, target)) !=
+	    by_source_and_target.end()) {
 		throw std::runtime_error("conflicting route when adding L1 routing result");
 	}
+
+	std::vector<L1RouteStore::handle_type> candidates;
+	for (auto const& item : find_routes_from(source)) {
+		candidates.push_back(item.m_handle);
+	}
+
+	auto const handle = m_store->add(route, candidates);
+	auto const res = m_routes.insert(route_item_type(m_store, handle, source, target));
+	m_revision = ::marocco::results::next_revision();
 	return *(res.first);
 }
 
@@ -110,6 +209,7 @@ auto L1Routing::add(
 	if (!res.second) {
 		throw std::runtime_error("conflicting projection when adding L1 routing result");
 	}
+	m_revision = ::marocco::results::next_revision();
 	return *(res.first);
 }
 
@@ -171,15 +271,60 @@ auto L1Routing::end() const -> iterator {
 	return m_routes.end();
 }
 
+auto L1Routing::records() const -> std::vector<record_type>
+{
+	static_assert(sizeof(record_type) == 24, "record_type has to be packed");
+
+	std::vector<record_type> result;
+	result.reserve(m_projections.size());
+	auto const& routes = get<source_and_target_type>(m_routes);
+	for (auto const& item : m_projections) {
+		record_type record;
+		record.projection = item.projection();
+		record.source_hicann = item.source().toHICANNOnWafer().toEnum().value();
+		record.dnc_merger = item.source().toDNCMergerOnHICANN().value();
+		record.target_hicann = item.target().toEnum().value();
+		auto const it = routes.find(boost::make_tuple(item.source(), item.target()));
+		record.num_hicanns = (it == routes.end()) ? 0 : it->hicanns().size();
+		result.push_back(record);
+	}
+	return result;
+}
+
+std::string L1Routing::packed_records() const
+{
+	return pack_records(records());
+}
+
+size_t L1Routing::revision() const
+{
+	return m_revision;
+}
+
 template <typename Archiver>
-void L1Routing::route_item_type::serialize(Archiver& ar, const unsigned int /* version */)
+void L1Routing::route_item_type::serialize(Archiver& ar, const unsigned int version)
 {
 	using namespace boost::serialization;
+	if (version > 0) {
+		ar & make_nvp("handle", m_handle);
+	} else {
+		// Routes used to be stored as part of the item.
+		L1Route route;
+		ar & make_nvp("route", route);
+		if (Archiver::is_loading::value) {
+			if (deserialization_store == nullptr) {
+				throw std::runtime_error("route item is not part of a routing result");
+			}
+			m_handle = (*deserialization_store)->add(route, {});
+		}
+	}
 	// clang-format off
-	ar & make_nvp("route", m_route)
-	   & make_nvp("source", m_source)
+	ar & make_nvp("source", m_source)
 	   & make_nvp("target", m_target);
 	// clang-format on
+	if (Archiver::is_loading::value) {
+		m_store = (deserialization_store == nullptr) ? nullptr : *deserialization_store;
+	}
 }
 
 template <typename Archiver>
@@ -195,13 +340,24 @@ void L1Routing::projection_item_type::serialize(Archiver& ar, const unsigned int
 }
 
 template <typename Archiver>
-void L1Routing::serialize(Archiver& ar, const unsigned int /* version */)
+void L1Routing::serialize(Archiver& ar, const unsigned int version)
 {
 	using namespace boost::serialization;
+	if (Archiver::is_loading::value) {
+		// Copies of previous route items may still refer to the current store.
+		m_store = std::make_shared<L1RouteStore>();
+	}
+	if (version > 0) {
+		ar & make_nvp("store", *m_store);
+	}
+	DeserializationStoreGuard guard(m_store);
 	// clang-format off
 	ar & make_nvp("routes", m_routes)
 	   & make_nvp("projections", m_projections);
 	// clang-format on
+	if (Archiver::is_loading::value) {
+		m_revision = ::marocco::results::next_revision();
+	}
 }
 
 } // namespace results
@@ -1,16 +1,22 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 
 #include "hal/Coordinate/HICANN.h"
 #include "hal/Coordinate/L1.h"
 
 #include "marocco/coordinates/L1Route.h"
 #include "marocco/routing/results/Edge.h"
+#include "marocco/routing/results/L1RouteStore.h"
 #include "marocco/util/iterable.h"
 
 namespace boost {
@@ -36,30 +42,52 @@ public:
 	 * @brief Single connection from a given DNC merger to another HICANN.
 	 * @note In addition to the L1Route this needs to explicitly store the target, as the
 	 *       end of the stored L1 route may lie on an adjacent HICANN.
+	 * @note The route itself is kept in compact form by the owning routing result, see
+	 *       \c L1RouteStore.  Items share ownership of that store, so copies of items
+	 *       stay valid after the routing result has been destroyed.
 	 */
 	class route_item_type {
 	public:
 		/**
-		 * @param target HICANN containing target population.
-		 *               Can be different from \c route.target_hicann() when a synapse
-		 *               switch on the target HICANN of the route is used to reach a
-		 *               synapse driver on the HICANN containing the target population.
+		 * @brief Reconstruct the route of this connection.
+		 * @note As this returns a copy, prefer \c segments() or \c hicanns() for
+		 *       traversal.
 		 */
-		route_item_type(L1Route const& route, target_type const& target);
+		L1Route route() const;
+
+#ifndef PYPLUSPLUS
+		/// Segments of the route of this connection, decoded on access.
+		L1RouteStore::segments_type segments() const;
+#endif // !PYPLUSPLUS
+
+		/// HICANNs traversed by the route of this connection in order.
+		std::vector<HMF::Coordinate::HICANNOnWafer> hicanns() const;
 
-		L1Route const& route() const;
 		source_type const& source() const;
 		target_type const& target() const;
 
 	private:
-		L1Route m_route;
+		friend class L1Routing;
+		route_item_type(
+			std::shared_ptr<L1RouteStore const> store,
+			L1RouteStore::handle_type handle,
+			source_type const& source,
+			target_type const& target);
+
+		/// @throw std::runtime_error If this item is not part of a routing result.
+		L1RouteStore const& store() const;
+
+#ifndef PYPLUSPLUS
+		std::shared_ptr<L1RouteStore const> m_store;
+#endif // !PYPLUSPLUS
+		L1RouteStore::handle_type m_handle;
 		source_type m_source;
 		target_type m_target;
 
 		friend class boost::serialization::access;
 		route_item_type();
 		template <typename Archiver>
-		void serialize(Archiver& ar, const unsigned int /* version */);
+		void serialize(Archiver& ar, const unsigned int version);
 	}; // route_item_type
 
 	/**
@@ -158,6 +186,32 @@ public:
 	typedef routes_type::iterator iterator;
 	typedef routes_type::iterator const_iterator;
 
+	/**
+	 * @brief Flat representation of a single projection item and its route, see
+	 * \c records().
+	 * HICANNs are stored as enum values, \c dnc_merger as \c DNCMergerOnHICANN of the
+	 * source HICANN.  \c num_hicanns is the number of HICANNs traversed by the route.
+	 */
+	struct record_type {
+		uint64_t projection;
+		int32_t source_hicann;
+		int32_t dnc_merger;
+		int32_t target_hicann;
+		uint32_t num_hicanns;
+	};
+
+	L1Routing();
+	L1Routing(L1Routing const& other);
+	L1Routing& operator=(L1Routing const& other);
+
+	/**
+	 * @param target HICANN containing target population.
+	 *               Can be different from \c route.target_hicann() when a synapse
+	 *               switch on the target HICANN of the route is used to reach a
+	 *               synapse driver on the HICANN containing the target population.
+	 * @note Common prefixes with other routes from the same DNC merger are only stored
+	 *       once.
+	 */
 	route_item_type const& add(L1Route const& route, target_type const& target);
 	projection_item_type const& add(
 		route_item_type const& route, edge_type const& edge, projection_type const& projection);
@@ -195,13 +249,44 @@ public:
 
 	iterator end() const;
 
+#ifndef PYPLUSPLUS
+	/// All projection items with information on their routes.
+	std::vector<record_type> records() const;
+#endif // !PYPLUSPLUS
+
+	/**
+	 * @brief Raw bytes of \c records(), for bulk export to NumPy.
+	 * @see \c pymarocco.results for conversion to a structured array.
+	 */
+	std::string packed_records() const;
+
+	/**
+	 * @brief Revision of the last modification, see \c marocco::results::next_revision().
+	 * Can be used to invalidate data derived from this routing result.  Copies share the
+	 * revision of their source.
+	 * @note This counter is not serialized.
+	 */
+	size_t revision() const;
+
 private:
+	/**
+	 * @brief Check that the route is a valid connection to the given target.
+	 * @return DNC merger the route starts from.
+	 * @throw std::invalid_argument
+	 */
+	static source_type check_route(L1Route const& route, target_type const& target);
+
+#ifndef PYPLUSPLUS
+	/// Shared with all route items, see \c route_item_type.
+	std::shared_ptr<L1RouteStore> m_store;
+#endif // !PYPLUSPLUS
 	routes_type m_routes;
 	projections_type m_projections;
+	size_t m_revision;
 
 	friend class boost::serialization::access;
 	template <typename Archiver>
-	void serialize(Archiver& ar, const unsigned int /* version */);
+	void serialize(Archiver& ar, const unsigned int version);
 }; // L1Routing
 
 PYPP_INSTANTIATE(iterable<L1Routing::projections_by_edge_type::iterator>)
@@ -218,3 +303,5 @@ PYPP_INSTANTIATE(iterable<L1Routing::routes_by_target_type::iterator>)
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::L1Routing)
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::L1Routing::route_item_type)
 BOOST_CLASS_EXPORT_KEY(::marocco::routing::results::L1Routing::projection_item_type)
+BOOST_CLASS_VERSION(::marocco::routing::results::L1Routing, 1)
+BOOST_CLASS_VERSION(::marocco::routing::results::L1Routing::route_item_type, 1)
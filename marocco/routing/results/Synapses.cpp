@@ -3,6 +3,8 @@
 #include <boost/serialization/nvp.hpp>
 #include <boost/serialization/optional.hpp>
 
+#include "marocco/util/pack_records.h"
+
 using namespace HMF::Coordinate;
 using boost::multi_index::get;
 
@@ -175,6 +177,34 @@ auto Synapses::end() const -> iterator {
 	return m_container.end();
 }
 
+auto Synapses::records() const -> std::vector<record_type>
+{
+	static_assert(sizeof(record_type) == 48, "record_type has to be packed");
+
+	std::vector<record_type> result;
+	result.reserve(m_container.size());
+	for (auto const& item : m_container) {
+		record_type record{item.projection(),
+		                   item.source_neuron().population(),
+		                   item.source_neuron().neuron_index(),
+		                   item.target_neuron().population(),
+		                   item.target_neuron().neuron_index(),
+		                   -1,
+		                   -1};
+		if (auto const& synapse = item.hardware_synapse()) {
+			record.hicann = synapse->toHICANNOnWafer().toEnum().value();
+			record.synapse = synapse->toSynapseOnHICANN().toEnum().value();
+		}
+		result.push_back(record);
+	}
+	return result;
+}
+
+std::string Synapses::packed_records() const
+{
+	return pack_records(records());
+}
+
 template <typename Archiver>
 void Synapses::item_type::serialize(Archiver& ar, const unsigned int /* version */)
 {
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <vector>
 #include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
@@ -124,6 +127,21 @@ public:
 	typedef container_type::iterator iterator;
 	typedef container_type::iterator const_iterator;
 
+	/**
+	 * @brief Flat representation of a single synapse, see \c records().
+	 * \c synapse is the enum value of the \c SynapseOnHICANN, unrealized synapses are
+	 * represented by -1 for \c hicann and \c synapse.
+	 */
+	struct record_type {
+		uint64_t projection;
+		uint64_t source_population;
+		uint64_t source_neuron_index;
+		uint64_t target_population;
+		uint64_t target_neuron_index;
+		int32_t hicann;
+		int32_t synapse;
+	};
+
 	void add(
 		edge_type const& edge,
 		projection_type const& projection,
@@ -176,6 +194,17 @@ public:
 
 	iterator end() const;
 
+#ifndef PYPLUSPLUS
+	/// All synapses in iteration order.
+	std::vector<record_type> records() const;
+#endif // !PYPLUSPLUS
+
+	/**
+	 * @brief Raw bytes of \c records(), for bulk export to NumPy.
+	 * @see \c pymarocco.results for conversion to a structured array.
+	 */
+	std::string packed_records() const;
+
 private:
 	container_type m_container;
 
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace marocco {
+
+/**
+ * @brief Raw bytes of the given records in native byte order.
+ * Used for bulk export of results, e.g. to structured NumPy arrays via
+ * \c numpy.frombuffer, which avoids crossing the language boundary once per item.
+ * @note This copies the records.  When exported to Python, the returned string is
+ *       copied once more into a Python string, which the array then refers to.
+ *       Thus such arrays are read-only.
+ */
+template <typename T>
+std::string pack_records(std::vector<T> const& records)
+{
+	static_assert(std::is_pod<T>::value, "records have to be plain old data");
+	return std::string(
+		reinterpret_cast<char const*>(records.data()), records.size() * sizeof(T));
+}
+
+} // namespace marocco
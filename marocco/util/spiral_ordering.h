@@ -1,7 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <numeric>
+
+#include "hal/Coordinate/HICANN.h"
 
 namespace marocco {
 
@@ -12,6 +17,11 @@ class spiral_ordering {
 
 public:
 	bool operator()(T const& lhs, T const& rhs) const {
+		return compare(lhs, rhs);
+	}
+
+	/// Geometric comparison, see \c operator().
+	bool compare(T const& lhs, T const& rhs) const {
 		if (distance(lhs) != distance(rhs)) {
 			return distance(lhs) < distance(rhs);
 		}
@@ -40,4 +50,39 @@ public:
 	}
 }; // spiral_ordering
 
+namespace detail {
+
+typedef std::array<uint16_t, HMF::Coordinate::HICANNOnWafer::enum_type::size> spiral_ranks_type;
+
+/// Position of each HICANN in spiral ordering, computed once on first use.
+inline spiral_ranks_type const& spiral_ranks()
+{
+	static spiral_ranks_type const ranks = [] {
+		using namespace HMF::Coordinate;
+		std::array<size_t, HICANNOnWafer::enum_type::size> ids;
+		std::iota(ids.begin(), ids.end(), 0);
+		spiral_ordering<HICANNOnWafer> ordering;
+		std::sort(ids.begin(), ids.end(), [&ordering](size_t lhs, size_t rhs) {
+			return ordering.compare(HICANNOnWafer(Enum(lhs)), HICANNOnWafer(Enum(rhs)));
+		});
+		spiral_ranks_type result;
+		for (size_t rank = 0; rank < ids.size(); ++rank) {
+			result[ids[rank]] = rank;
+		}
+		return result;
+	}();
+	return ranks;
+}
+
+} // namespace detail
+
+/// HICANNs are compared by table lookup instead of evaluating their geometry each time.
+template <>
+inline bool spiral_ordering<HMF::Coordinate::HICANNOnWafer>::operator()(
+	HMF::Coordinate::HICANNOnWafer const& lhs, HMF::Coordinate::HICANNOnWafer const& rhs) const
+{
+	auto const& ranks = detail::spiral_ranks();
+	return ranks[lhs.toEnum().value()] < ranks[rhs.toEnum().value()];
+}
+
 } // namespace marocco
@@ -0,0 +1,113 @@
+#include "marocco/util/stage_timer.h"
+
+#include <algorithm>
+#include <vector>
+#include <sys/resource.h>
+
+#include "marocco/util/trace.h"
+
+namespace marocco {
+
+namespace {
+
+/// Running timers of the current thread, innermost last.
+thread_local std::vector<StageTimer const*> running_timers;
+
+void process_usage(double& cpu_time, size_t& peak_rss)
+{
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		cpu_time = 0.;
+		peak_rss = 0;
+		return;
+	}
+	cpu_time = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec * 1e-6 + usage.ru_stime.tv_sec +
+	           usage.ru_stime.tv_usec * 1e-6;
+	// On Linux, the maximum resident set size is given in kilobytes.
+	peak_rss = usage.ru_maxrss;
+}
+
+} // namespace
+
+StageTimer::StageTimer(pymarocco::MappingStats& stats, std::string const& name)
+	: m_stats(stats),
+	  m_name(name),
+	  m_running(true),
+	  m_wall_start(clock_type::now()),
+	  m_cpu_start(0.),
+	  m_peak_rss_start(0)
+{
+	auto const parent = current(stats);
+	if (!parent.empty()) {
+		m_name = parent + "/" + name;
+	}
+	running_timers.push_back(this);
+
+	// Register stage on entry, s.t. enclosing stages are listed before nested ones.
+	pymarocco::StageStatistics stage;
+	stage.name = m_name;
+	m_stats.addStage(stage);
+
+	process_usage(m_cpu_start, m_peak_rss_start);
+}
+
+StageTimer::~StageTimer()
+{
+	stop();
+}
+
+std::string const& StageTimer::name() const
+{
+	return m_name;
+}
+
+std::string StageTimer::current(pymarocco::MappingStats const& stats)
+{
+	auto const parent = std::find_if(
+		running_timers.rbegin(), running_timers.rend(),
+		[&stats](StageTimer const* timer) { return &timer->m_stats == &stats; });
+	if (parent == running_timers.rend()) {
+		return {};
+	}
+	return (*parent)->name();
+}
+
+void StageTimer::hot_spot(
+	HMF::Coordinate::HICANNOnWafer const& hicann, clock_type::duration const duration)
+{
+	pymarocco::HotSpot hot_spot;
+	hot_spot.stage = m_name;
+	hot_spot.hicann = hicann;
+	hot_spot.wall_time = std::chrono::duration<double>(duration).count();
+	m_stats.addHotSpot(hot_spot);
+}
+
+void StageTimer::stop()
+{
+	if (!m_running) {
+		return;
+	}
+	m_running = false;
+
+	double cpu_end;
+	size_t peak_rss_end;
+	process_usage(cpu_end, peak_rss_end);
+
+	pymarocco::StageStatistics stage;
+	stage.name = m_name;
+	stage.calls = 1;
+	auto const wall_end = clock_type::now();
+	stage.wall_time = std::chrono::duration<double>(wall_end - m_wall_start).count();
+	stage.cpu_time = cpu_end - m_cpu_start;
+	stage.peak_rss_delta = peak_rss_end - m_peak_rss_start;
+	m_stats.addStage(stage);
+
+	trace::record(m_name, "stage", m_wall_start, wall_end);
+
+	auto const it = std::find(running_timers.begin(), running_timers.end(), this);
+	if (it != running_timers.end()) {
+		running_timers.erase(it);
+	}
+}
+
+} // namespace marocco
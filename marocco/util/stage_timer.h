@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "hal/Coordinate/HICANN.h"
+
+#include "marocco/util/trace.h"
+#include "pymarocco/MappingStats.h"
+
+namespace marocco {
+
+/**
+ * @brief Records resource usage of a stage of the mapping process in \c MappingStats.
+ * Wall-clock time, CPU time and the increase of the peak resident set size between
+ * construction and destruction (or \c stop()) are accumulated in the stage statistics.
+ * Timers are nested automatically: the name of the stage is prefixed with the name of the
+ * innermost running timer of the current thread which records to the same statistics.
+ * If tracing is enabled, each stage is also recorded as a trace event, see \c trace.
+ * @note Timers have to be destroyed in reverse order of construction and are not meant
+ *       to be shared between threads.
+ */
+class StageTimer
+{
+public:
+	typedef trace::clock_type clock_type;
+
+	StageTimer(pymarocco::MappingStats& stats, std::string const& name);
+	~StageTimer();
+
+	StageTimer(StageTimer const&) = delete;
+	StageTimer& operator=(StageTimer const&) = delete;
+
+	/// Full name of this stage, including the names of enclosing stages.
+	std::string const& name() const;
+
+	/**
+	 * @brief Full name of the innermost running stage of the current thread which records
+	 *        to the given statistics, or an empty string if there is none.
+	 */
+	static std::string current(pymarocco::MappingStats const& stats);
+
+	/// Record wall-clock time spent on a single HICANN during this stage.
+	void hot_spot(HMF::Coordinate::HICANNOnWafer const& hicann, clock_type::duration duration);
+
+	/// Finish recording before the end of the enclosing scope.
+	void stop();
+
+private:
+	pymarocco::MappingStats& m_stats;
+	std::string m_name;
+	bool m_running;
+	clock_type::time_point m_wall_start;
+	double m_cpu_start;
+	size_t m_peak_rss_start;
+}; // StageTimer
+
+} // namespace marocco
@@ -0,0 +1,165 @@
+#include "marocco/util/trace.h"
+
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+#include <unistd.h>
+
+namespace marocco {
+namespace trace {
+
+char const* const environment_variable = "MAROCCO_TRACE_FILE";
+
+namespace {
+
+struct Event
+{
+	std::string name;
+	char const* category;
+	clock_type::time_point begin;
+	clock_type::time_point end;
+	Argument first;
+	Argument second;
+};
+
+struct Buffer
+{
+	size_t thread;
+	std::vector<Event> events;
+};
+
+std::atomic<bool> recording{false};
+clock_type::time_point origin;
+
+/// Protects registration of buffers, recording itself is not synchronized.
+std::mutex buffers_mutex;
+std::vector<std::unique_ptr<Buffer> > buffers;
+
+thread_local Buffer* thread_buffer = nullptr;
+
+Buffer& buffer()
+{
+	if (!thread_buffer) {
+		std::lock_guard<std::mutex> lock(buffers_mutex);
+		buffers.emplace_back(new Buffer{buffers.size(), {}});
+		thread_buffer = buffers.back().get();
+	}
+	return *thread_buffer;
+}
+
+void write_string(std::ostream& os, std::string const& str)
+{
+	os << '"';
+	for (char const c : str) {
+		if (c == '"' || c == '\\') {
+			os << '\\' << c;
+		} else if (static_cast<unsigned char>(c) < 0x20) {
+			os << ' ';
+		} else {
+			os << c;
+		}
+	}
+	os << '"';
+}
+
+double microseconds(clock_type::duration duration)
+{
+	return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // namespace
+
+bool enabled()
+{
+	return recording.load(std::memory_order_relaxed);
+}
+
+void start()
+{
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	for (auto& buffer : buffers) {
+		buffer->events.clear();
+	}
+	origin = clock_type::now();
+	recording.store(true);
+}
+
+void write(std::string const& filename)
+{
+	recording.store(false);
+
+	std::ofstream file(filename);
+	if (!file) {
+		throw std::runtime_error("could not open trace file " + filename);
+	}
+
+	file << std::fixed << std::setprecision(3);
+
+	auto const pid = ::getpid();
+	bool first = true;
+	file << "{\"traceEvents\":[";
+	std::lock_guard<std::mutex> lock(buffers_mutex);
+	for (auto const& buffer : buffers) {
+		for (auto const& event : buffer->events) {
+			file << (first ? "\n" : ",\n");
+			first = false;
+			file << "{\"name\":";
+			write_string(file, event.name);
+			file << ",\"cat\":\"" << event.category << "\",\"ph\":\"X\",\"pid\":" << pid
+			     << ",\"tid\":" << buffer->thread
+			     << ",\"ts\":" << microseconds(event.begin - origin)
+			     << ",\"dur\":" << microseconds(event.end - event.begin);
+			if (event.first.name) {
+				file << ",\"args\":{\"" << event.first.name << "\":" << event.first.value;
+				if (event.second.name) {
+					file << ",\"" << event.second.name << "\":" << event.second.value;
+				}
+				file << "}";
+			}
+			file << "}";
+		}
+		buffer->events.clear();
+	}
+	file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void record(
+	std::string const& name,
+	char const* category,
+	clock_type::time_point begin,
+	clock_type::time_point end,
+	Argument const& first,
+	Argument const& second)
+{
+	if (!enabled()) {
+		return;
+	}
+	buffer().events.push_back(Event{name, category, begin, end, first, second});
+}
+
+Scope::Scope(char const* name, char const* category, Argument const& first, Argument const& second)
+	: m_enabled(enabled()),
+	  m_name(name),
+	  m_category(category),
+	  m_first(first),
+	  m_second(second),
+	  m_begin()
+{
+	if (m_enabled) {
+		m_begin = clock_type::now();
+	}
+}
+
+Scope::~Scope()
+{
+	if (m_enabled) {
+		record(m_name, m_category, m_begin, clock_type::now(), m_first, m_second);
+	}
+}
+
+} // namespace trace
+} // namespace marocco
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace marocco {
+
+/**
+ * @brief Opt-in recording of events in the Chrome trace event format.
+ * Recorded events can be inspected with chrome://tracing or https://ui.perfetto.dev to
+ * see how work is distributed over time, threads and HICANNs.
+ * Each thread records to its own buffer without synchronization; only the first event
+ * of each thread takes a lock to register its buffer.
+ * @note \c start() and \c write() must not be called while other threads record events.
+ * @see PyMarocco::trace_file
+ */
+namespace trace {
+
+typedef std::chrono::steady_clock clock_type;
+
+/// Name of an environment variable which enables tracing, overriding \c PyMarocco::trace_file.
+extern char const* const environment_variable;
+
+/// Whether events are currently recorded.
+bool enabled();
+
+/// Discard all recorded events and enable recording.
+void start();
+
+/// Disable recording and write all recorded events to the given file.
+void write(std::string const& filename);
+
+struct Argument
+{
+	char const* name;
+	std::int64_t value;
+};
+
+/**
+ * @brief Record an event which lasted from \c begin to \c end.
+ * @param name Name of the event.
+ * @param category Category of the event, has to be a string literal.
+ * @param args Up to two arguments, unused ones have to be null.
+ */
+void record(
+	std::string const& name,
+	char const* category,
+	clock_type::time_point begin,
+	clock_type::time_point end,
+	Argument const& first = Argument{nullptr, 0},
+	Argument const& second = Argument{nullptr, 0});
+
+/// Records an event lasting from construction to destruction, if tracing is enabled.
+class Scope
+{
+public:
+	Scope(
+		char const* name,
+		char const* category,
+		Argument const& first = Argument{nullptr, 0},
+		Argument const& second = Argument{nullptr, 0});
+	~Scope();
+
+	Scope(Scope const&) = delete;
+	Scope& operator=(Scope const&) = delete;
+
+private:
+	bool m_enabled;
+	char const* m_name;
+	char const* m_category;
+	Argument m_first;
+	Argument m_second;
+	clock_type::time_point m_begin;
+}; // Scope
+
+} // namespace trace
+} // namespace marocco
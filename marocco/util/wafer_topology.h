@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <boost/optional.hpp>
+
+#include "hal/Coordinate/HICANN.h"
+#include "hal/Coordinate/geometry.h"
+
+namespace marocco {
+
+/**
+ * @brief Adjacency of HICANNs on the (round) wafer.
+ * In contrast to \c HICANNOnWafer::north() etc., which throw at the border of the wafer,
+ * lookups use a table of neighbor indices generated at compile time and do not throw.
+ */
+namespace wafer_topology {
+
+namespace detail {
+
+constexpr std::size_t num_rows = HMF::Coordinate::HICANNOnWafer::y_type::size;
+constexpr std::size_t num_columns = HMF::Coordinate::HICANNOnWafer::x_type::size;
+constexpr std::size_t num_hicanns = HMF::Coordinate::HICANNOnWafer::enum_type::size;
+
+/// Number of HICANNs in each row, rows are centered horizontally.
+constexpr std::size_t row_widths[num_rows] = {12, 12, 20, 20, 28, 28, 36, 36,
+                                              36, 36, 28, 28, 20, 20, 12, 12};
+
+/// Enum of the first HICANN in each row.
+constexpr std::size_t row_offsets[num_rows + 1] = {0,   12,  24,  44,  64,  92,  120, 156, 192,
+                                                   228, 264, 292, 320, 340, 360, 372, 384};
+
+static_assert(row_offsets[num_rows] == num_hicanns, "wafer layout does not match HICANNOnWafer");
+
+constexpr std::size_t row_begin(std::size_t y)
+{
+	return (num_columns - row_widths[y]) / 2;
+}
+
+constexpr std::size_t row_of(std::size_t id, std::size_t y = 0)
+{
+	return id < row_offsets[y + 1] ? y : row_of(id, y + 1);
+}
+
+constexpr std::size_t column_of(std::size_t id)
+{
+	return row_begin(row_of(id)) + id - row_offsets[row_of(id)];
+}
+
+/// Enum of the HICANN at the given position or -1 if there is none.
+constexpr std::int16_t at(std::ptrdiff_t x, std::ptrdiff_t y)
+{
+	return (y < 0 || y >= std::ptrdiff_t(num_rows) || x < std::ptrdiff_t(row_begin(y)) ||
+	        x >= std::ptrdiff_t(row_begin(y) + row_widths[y]))
+	           ? std::int16_t(-1)
+	           : std::int16_t(row_offsets[y] + x - row_begin(y));
+}
+
+typedef std::array<std::int16_t, 4> neighbors_type;
+
+/// Neighbors of the given HICANN, in the order north, east, south, west.
+constexpr neighbors_type neighbors(std::size_t id)
+{
+	return {{at(column_of(id), std::ptrdiff_t(row_of(id)) - 1),
+	         at(column_of(id) + 1, row_of(id)),
+	         at(column_of(id), row_of(id) + 1),
+	         at(std::ptrdiff_t(column_of(id)) - 1, row_of(id))}};
+}
+
+template <std::size_t... I>
+constexpr std::array<neighbors_type, sizeof...(I)> make_neighbor_table(std::index_sequence<I...>)
+{
+	return {{neighbors(I)...}};
+}
+
+constexpr auto neighbor_table = make_neighbor_table(std::make_index_sequence<num_hicanns>());
+
+inline std::size_t index(HMF::Coordinate::Direction const& direction)
+{
+	using namespace HMF::Coordinate;
+	return direction == north ? 0 : direction == east ? 1 : direction == south ? 2 : 3;
+}
+
+} // namespace detail
+
+/**
+ * @brief Adjacent HICANN in the given direction.
+ * @return \c boost::none at the border of the wafer.
+ */
+inline boost::optional<HMF::Coordinate::HICANNOnWafer> neighbor(
+	HMF::Coordinate::HICANNOnWafer const& hicann, HMF::Coordinate::Direction const& direction)
+{
+	auto const id = detail::neighbor_table[hicann.toEnum().value()][detail::index(direction)];
+	if (id < 0) {
+		return boost::none;
+	}
+	return HMF::Coordinate::HICANNOnWafer(HMF::Coordinate::Enum(id));
+}
+
+} // namespace wafer_topology
+} // namespace marocco
@@ -1,9 +1,33 @@
 #include "pymarocco/MappingStats.h"
 #include "euter/projection.h"
+#include <algorithm>
+#include <iterator>
 #include <ostream>
+#include <stdexcept>
 
 namespace pymarocco {
 
+StageStatistics::StageStatistics() :
+	name(),
+	calls(0),
+	wall_time(0.),
+	cpu_time(0.),
+	peak_rss_delta(0)
+{}
+
+size_t StageStatistics::depth() const
+{
+	return std::count(name.begin(), name.end(), '/');
+}
+
+HotSpot::HotSpot() :
+	stage(),
+	hicann(),
+	wall_time(0.)
+{}
+
+size_t const MappingStats::max_hot_spots_per_stage;
+
 MappingStats::MappingStats() :
 	timeSpentInParallelRegion(0),
 	timeTotal(0),
@@ -12,7 +36,9 @@ MappingStats::MappingStats() :
 	mSynapses(0),
 	mNumPopulations(0),
 	mNumProjections(0),
-	mNumNeurons(0)
+	mNumNeurons(0),
+	mMappingCacheHits(0),
+	mMappingCacheMisses(0)
 {}
 
 void MappingStats::setSynapseLoss(size_t s)
@@ -105,6 +131,108 @@ double MappingStats::getSynapseUsage() const
 	return mSynapseUsage;
 }
 
+void MappingStats::setMappingCacheHits(size_t s)
+{
+	mMappingCacheHits = s;
+}
+
+size_t MappingStats::getMappingCacheHits() const
+{
+	return mMappingCacheHits;
+}
+
+void MappingStats::setMappingCacheMisses(size_t s)
+{
+	mMappingCacheMisses = s;
+}
+
+size_t MappingStats::getMappingCacheMisses() const
+{
+	return mMappingCacheMisses;
+}
+
+std::vector<StageStatistics> const& MappingStats::getStages() const
+{
+	return mStages;
+}
+
+StageStatistics const& MappingStats::getStage(std::string const& name) const
+{
+	for (auto const& stage : mStages) {
+		if (stage.name == name) {
+			return stage;
+		}
+	}
+	throw std::out_of_range("no statistics for stage " + name);
+}
+
+std::vector<HotSpot> const& MappingStats::getHotSpots() const
+{
+	return mHotSpots;
+}
+
+void MappingStats::addStage(StageStatistics const& stage)
+{
+	for (auto& existing : mStages) {
+		if (existing.name == stage.name) {
+			existing.calls += stage.calls;
+			existing.wall_time += stage.wall_time;
+			existing.cpu_time += stage.cpu_time;
+			existing.peak_rss_delta += stage.peak_rss_delta;
+			return;
+		}
+	}
+	mStages.push_back(stage);
+}
+
+void MappingStats::addHotSpot(HotSpot const& hot_spot)
+{
+	// Hot spots are grouped by stage and sorted by decreasing wall-clock time.
+	auto const begin = std::find_if(mHotSpots.begin(), mHotSpots.end(), [&](HotSpot const& other) {
+		return other.stage == hot_spot.stage;
+	});
+	auto const end = std::find_if(begin, mHotSpots.end(), [&](HotSpot const& other) {
+		return other.stage != hot_spot.stage;
+	});
+
+	auto const position = std::find_if(begin, end, [&](HotSpot const& other) {
+		return other.wall_time < hot_spot.wall_time;
+	});
+	if (size_t(std::distance(begin, end)) >= max_hot_spots_per_stage) {
+		if (position == end) {
+			return;
+		}
+		// Remove fastest entry first, as insertion invalidates iterators.
+		auto const index = std::distance(mHotSpots.begin(), position);
+		mHotSpots.erase(std::prev(end));
+		mHotSpots.insert(mHotSpots.begin() + index, hot_spot);
+		return;
+	}
+	mHotSpots.insert(position, hot_spot);
+}
+
+void MappingStats::addStages(MappingStats const& other, std::string const& prefix)
+{
+	for (auto stage : other.mStages) {
+		if (!prefix.empty()) {
+			stage.name = prefix + "/" + stage.name;
+		}
+		addStage(stage);
+	}
+	for (auto hot_spot : other.mHotSpots) {
+		if (!prefix.empty()) {
+			hot_spot.stage = prefix + "/" + hot_spot.stage;
+		}
+		addHotSpot(hot_spot);
+	}
+}
+
+void MappingStats::clearStages()
+{
+	mStages.clear();
+	mHotSpots.clear();
+}
+
 std::ostream& MappingStats::operator<< (std::ostream& os) const
 {
 	os << "MappingStats {"
@@ -119,7 +247,27 @@ std::ostream& MappingStats::operator<< (std::ostream& os) const
 		<< "\n\tpopulations: " << getNumPopulations()
 		<< "\n\tprojections: " << getNumProjections()
 		<< "\n\tneurons: " << getNumNeurons()
-		<< "}";
+		<< "\n\tmapping cache hits: " << getMappingCacheHits()
+		<< "\n\tmapping cache misses: " << getMappingCacheMisses();
+	if (!mStages.empty()) {
+		os << "\n\tstages (wall / cpu time, peak rss increase):";
+		for (auto const& stage : mStages) {
+			os << "\n\t\t" << std::string(2 * stage.depth(), ' ')
+			   << stage.name.substr(stage.name.rfind('/') + 1) << ": " << stage.wall_time
+			   << "s / " << stage.cpu_time << "s, " << stage.peak_rss_delta << "kB";
+			if (stage.calls > 1) {
+				os << " (" << stage.calls << " calls)";
+			}
+		}
+	}
+	if (!mHotSpots.empty()) {
+		os << "\n\thot spots:";
+		for (auto const& hot_spot : mHotSpots) {
+			os << "\n\t\t" << hot_spot.stage << " on " << hot_spot.hicann << ": "
+			   << hot_spot.wall_time << "s";
+		}
+	}
+	os << "}";
 	return os;
 }
 
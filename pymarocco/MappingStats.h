@@ -4,15 +4,78 @@
 #include <iosfwd>
 #include <map>
 
+#include <string>
+#include <vector>
+
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/matrix_proxy.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/string.hpp>
+#include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 #include "boost/serialization/ublas.hpp"
 
+#include "hal/Coordinate/HICANN.h"
+
 namespace ublas = boost::numeric::ublas;
 
 namespace pymarocco {
 
+/**
+ * @brief Resources consumed by a stage of the mapping process.
+ * Stages are nested, the name of a stage contains the names of all enclosing stages,
+ * separated by slashes (e.g. "mapping/routing/l1_routing").
+ * If a stage is entered several times, resource usage is accumulated.
+ */
+struct StageStatistics
+{
+	StageStatistics();
+
+	std::string name;
+	/// number of times the stage was entered
+	size_t calls;
+	/// wall-clock time in s
+	double wall_time;
+	/// CPU time of the whole process (all threads) in s
+	double cpu_time;
+	/// increase of the peak resident set size of the process in kB
+	size_t peak_rss_delta;
+
+	/// nesting level, 0 for top-level stages
+	size_t depth() const;
+
+	template<typename Archive>
+	void serialize(Archive& ar, unsigned int const)
+	{
+		using boost::serialization::make_nvp;
+		ar & make_nvp("name", name)
+		   & make_nvp("calls", calls)
+		   & make_nvp("wall_time", wall_time)
+		   & make_nvp("cpu_time", cpu_time)
+		   & make_nvp("peak_rss_delta", peak_rss_delta);
+	}
+};
+
+/// Wall-clock time spent on a single HICANN during a stage of the mapping process.
+struct HotSpot
+{
+	HotSpot();
+
+	std::string stage;
+	HMF::Coordinate::HICANNOnWafer hicann;
+	/// wall-clock time in s
+	double wall_time;
+
+	template<typename Archive>
+	void serialize(Archive& ar, unsigned int const)
+	{
+		using boost::serialization::make_nvp;
+		ar & make_nvp("stage", stage)
+		   & make_nvp("hicann", hicann)
+		   & make_nvp("wall_time", wall_time);
+	}
+};
+
 class MappingStats
 {
 public:
@@ -33,6 +96,11 @@ public:
 	double getNeuronUsage() const;
 	double getSynapseUsage() const;
 
+	/// Cumulative number of hits of the mapping cache, see \c PyMarocco::mapping_cache.
+	size_t getMappingCacheHits() const;
+	/// Cumulative number of misses of the mapping cache, see \c PyMarocco::mapping_cache.
+	size_t getMappingCacheMisses() const;
+
 #if !defined(PYPLUSPLUS)
 	void setSynapseLoss(size_t s);
 	void setSynapseLossAfterL1Routing(size_t s);
@@ -44,6 +112,9 @@ public:
 
 	void setNeuronUsage(double v);
 	void setSynapseUsage(double v);
+
+	void setMappingCacheHits(size_t s);
+	void setMappingCacheMisses(size_t s);
 #endif
 
 	size_t timeSpentInParallelRegion;
@@ -54,6 +125,40 @@ public:
 	friend std::ostream& operator<< (
 		std::ostream& os, MappingStats const& ms);
 
+	/// Resource usage of all stages of the mapping process, in order of first entry.
+	std::vector<StageStatistics> const& getStages() const;
+
+	/**
+	 * @brief Resource usage of a single stage of the mapping process.
+	 * @throw std::out_of_range If no stage of that name was recorded.
+	 */
+	StageStatistics const& getStage(std::string const& name) const;
+
+	/// Slowest HICANNs of each stage, sorted by stage and decreasing wall-clock time.
+	std::vector<HotSpot> const& getHotSpots() const;
+
+#if !defined(PYPLUSPLUS)
+	/// Accumulate resource usage of the stage of the same name.
+	void addStage(StageStatistics const& stage);
+
+	/// Only the slowest \c max_hot_spots_per_stage HICANNs of each stage are kept.
+	void addHotSpot(HotSpot const& hot_spot);
+
+	/**
+	 * @brief Accumulate stages and hot spots of another mapping run.
+	 * Used to combine the statistics of mappers running in parallel on different wafers,
+	 * thus times of stages can exceed the total time.
+	 * @param prefix If not empty, prepended to the names of the stages of \c other,
+	 *        separated by a slash, to nest them into the given stage.
+	 */
+	void addStages(MappingStats const& other, std::string const& prefix = std::string());
+
+	/// Remove all stages and hot spots.
+	void clearStages();
+#endif
+
+	static size_t const max_hot_spots_per_stage = 10;
+
 	Matrix const& getWeights(ProjectionId proj) const;
 #if !defined(PYPLUSPLUS)
 	Matrix&       getWeights(ProjectionId proj);
@@ -71,12 +176,18 @@ private:
 	double mNeuronUsage;
 	double mSynapseUsage;
 
+	size_t mMappingCacheHits;
+	size_t mMappingCacheMisses;
+
+	std::vector<StageStatistics> mStages;
+	std::vector<HotSpot> mHotSpots;
+
 	/// mapping of projection ids to weight matrices
 	std::map<ProjectionId, Matrix> mWeights;
 
 	friend class boost::serialization::access;
 	template<typename Archive>
-	void serialize(Archive& ar, unsigned int const)
+	void serialize(Archive& ar, unsigned int const version)
 	{
 		using boost::serialization::make_nvp;
 		ar & make_nvp("synapse_loss", mSynapseLoss)
@@ -88,7 +199,20 @@ private:
 		   & make_nvp("weights", mWeights)
 		   & make_nvp("neuron_usage", mNeuronUsage)
 		   & make_nvp("synapse_usage", mSynapseUsage);
+		if (version > 0) {
+			ar & make_nvp("mapping_cache_hits", mMappingCacheHits)
+			   & make_nvp("mapping_cache_misses", mMappingCacheMisses)
+			   & make_nvp("stages", mStages)
+			   & make_nvp("hot_spots", mHotSpots);
+		} else if (Archive::is_loading::value) {
+			mMappingCacheHits = 0;
+			mMappingCacheMisses = 0;
+			mStages.clear();
+			mHotSpots.clear();
+		}
 	}
 };
 
 } // pymarocco
+
+BOOST_CLASS_VERSION(::pymarocco::MappingStats, 1)
@@ -36,7 +36,11 @@ PyMarocco::PyMarocco() :
 	bkg_gen_isi(125),
 	pll_freq(125e6),
 	hicann_configurator(HICANNCfg::ParallelHICANNv4Configurator),
-	continue_despite_synapse_loss(false)
+	continue_despite_synapse_loss(false),
+	incremental_weight_update(false),
+	mapping_cache(),
+	mapping_cache_max_size(0),
+	trace_file()
 {}
 
 boost::shared_ptr<PyMarocco> PyMarocco::create()
@@ -45,7 +49,7 @@ boost::shared_ptr<PyMarocco> PyMarocco::create()
 }
 
 template<typename Archive>
-void PyMarocco::serialize(Archive& ar, unsigned int const /* version */)
+void PyMarocco::serialize(Archive& ar, unsigned int const version)
 {
 	using namespace boost::serialization;
 	// clang-format off
@@ -73,6 +77,19 @@ void PyMarocco::serialize(Archive& ar, unsigned int const /* version */)
 	   & make_nvp("ess_config", ess_config)
 	   & make_nvp("ess_temp_directory", ess_temp_directory)
 	   & make_nvp("continue_despite_synapse_loss", continue_despite_synapse_loss);
+	if (version > 0) {
+		ar & make_nvp("incremental_weight_update", incremental_weight_update)
+		   & make_nvp("mapping_cache", mapping_cache)
+		   & make_nvp("mapping_cache_max_size", mapping_cache_max_size)
+		   & make_nvp("trace_file", trace_file)
+		   & make_nvp("routing_portfolio", routing_portfolio);
+	} else if (Archive::is_loading::value) {
+		incremental_weight_update = false;
+		mapping_cache.clear();
+		mapping_cache_max_size = 0;
+		trace_file.clear();
+		routing_portfolio = marocco::routing::parameters::RoutingPortfolio();
+	}
 	// clang-format on
 }
 
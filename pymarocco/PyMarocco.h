@@ -3,6 +3,7 @@
 #include <string>
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/serialization/version.hpp>
 
 #include "euter/metadata.h"
 #include "pywrap/compat/macros.hpp"
@@ -18,6 +19,7 @@
 #include "marocco/placement/parameters/MergerRouting.h"
 #include "marocco/placement/parameters/NeuronPlacement.h"
 #include "marocco/routing/parameters/L1Routing.h"
+#include "marocco/routing/parameters/RoutingPortfolio.h"
 #include "marocco/routing/parameters/SynapseRouting.h"
 
 #include "sthal/ESSConfig.h"
@@ -116,6 +118,7 @@ public:
 	marocco::placement::parameters::NeuronPlacement neuron_placement;
 	marocco::placement::parameters::L1AddressAssignment l1_address_assignment;
 	marocco::routing::parameters::L1Routing l1_routing;
+	marocco::routing::parameters::RoutingPortfolio routing_portfolio;
 	marocco::routing::parameters::SynapseRouting synapse_routing;
 	marocco::experiment::parameters::Experiment experiment;
 
@@ -202,6 +205,46 @@ public:
 	/// default: false
 	bool continue_despite_synapse_loss;
 
+	/**
+	 * @brief Only update synapse weights if nothing but weights changed since the last run.
+	 * Requires a \c runtime::Runtime object to be passed in, which keeps hardware
+	 * configuration and mapping results alive between runs.  If populations,
+	 * projections, mapping parameters and defects are unchanged, placement and routing
+	 * are reused and only the synapse weights of affected HICANNs are transformed again.
+	 * If additionally a configurator that does not reset the HICANNs is used (see
+	 * \c hicann_configurator), only HICANNs whose configuration changed are configured
+	 * again on hardware.  This is not the case when \c skip_mapping is set.
+	 * Changes to neuron and current source parameters cause a full mapping.
+	 * @note Parameters of spike sources are not compared, their spike times are
+	 *       translated again in every run.
+	 * default: false
+	 */
+	bool incremental_weight_update;
+
+	/**
+	 * @brief Directory of an on-disk cache of placement and routing results.
+	 * Results are looked up by a hash of the network, the mapping parameters and the
+	 * defects, so that repeated runs of the same network skip placement and routing.
+	 * Hit and miss counts are reported in the mapping statistics.
+	 * default: "" (no caching)
+	 */
+	std::string mapping_cache;
+
+	/// maximum size of the mapping cache in bytes, least recently used entries are
+	/// removed when it is exceeded.
+	/// default: 0 (unlimited)
+	size_t mapping_cache_max_size;
+
+	/**
+	 * @brief File to write a trace of the mapping run to, in Chrome trace event format.
+	 * The trace contains begin and duration of all stages (see \c MappingStats::getStages())
+	 * as well as per-HICANN events of merger routing, L1 routing, synapse routing and
+	 * parameter translation.  It can be inspected with chrome://tracing or Perfetto.
+	 * Can be overridden via the environment variable \c MAROCCO_TRACE_FILE.
+	 * default: "" (no tracing)
+	 */
+	std::string trace_file;
+
 private:
 	PyMarocco();
 
@@ -213,3 +256,4 @@ private:
 } // pymarocco
 
 BOOST_CLASS_EXPORT_KEY(::pymarocco::PyMarocco)
+BOOST_CLASS_VERSION(::pymarocco::PyMarocco, 1)
@@ -53,3 +53,59 @@ def _patch_methods():
 
 _patch_methods()
 del _patch_methods
+
+
+# Layout of the records returned by `packed_records()`, see the
+# corresponding `record_type` in C++.
+placement_dtype = [
+    ("population", "=u8"),
+    ("neuron_index", "=u8"),
+    ("hicann", "=i2"),
+    ("neuron_block", "=i2"),
+    ("dnc_merger", "=i2"),
+    ("l1_address", "=i2"),
+]
+
+synapses_dtype = [
+    ("projection", "=u8"),
+    ("source_population", "=u8"),
+    ("source_neuron_index", "=u8"),
+    ("target_population", "=u8"),
+    ("target_neuron_index", "=u8"),
+    ("hicann", "=i4"),
+    ("synapse", "=i4"),
+]
+
+l1_routing_dtype = [
+    ("projection", "=u8"),
+    ("source_hicann", "=i4"),
+    ("dnc_merger", "=i4"),
+    ("target_hicann", "=i4"),
+    ("num_hicanns", "=u4"),
+]
+
+
+def _add_numpy_export():
+    """
+    Provide `to_numpy()` on result containers, which returns all items
+    as structured NumPy array.  Data crosses the language boundary
+    once, instead of once per item.  Missing coordinates are
+    represented by -1.
+
+    The records are copied three times: into a record vector, into the
+    packed string and into a Python string.  The array is a read-only
+    view of the latter, use `to_numpy().copy()` for a writable array.
+    """
+
+    def export(dtype):
+        def to_numpy(self):
+            import numpy
+            return numpy.frombuffer(self.packed_records(), dtype=dtype)
+        return to_numpy
+
+    Placement.to_numpy = export(placement_dtype)
+    Synapses.to_numpy = export(synapses_dtype)
+    L1Routing.to_numpy = export(l1_routing_dtype)
+
+_add_numpy_export()
+del _add_numpy_export
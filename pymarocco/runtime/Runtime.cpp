@@ -36,12 +36,35 @@ boost::shared_ptr<marocco::results::Marocco> Runtime::results()
 	return m_results;
 }
 
+std::vector<HMF::Coordinate::HICANNOnWafer> Runtime::changed_hicanns() const
+{
+	return m_changed_hicanns;
+}
+
+void Runtime::changed_hicanns(std::vector<HMF::Coordinate::HICANNOnWafer> const& hicanns)
+{
+	m_changed_hicanns = hicanns;
+}
+
+boost::shared_ptr<marocco::IncrementalMapping> Runtime::incremental_mapping()
+{
+	return m_incremental_mapping;
+}
+
+void Runtime::incremental_mapping(boost::shared_ptr<marocco::IncrementalMapping> const& state)
+{
+	m_incremental_mapping = state;
+}
+
 Runtime::Runtime()
 {
 }
 
 Runtime::Runtime(HMF::Coordinate::Wafer const& wafer)
-	: m_wafer(new sthal::Wafer(wafer)), m_results(new marocco::results::Marocco())
+	: m_wafer(new sthal::Wafer(wafer)),
+	  m_results(new marocco::results::Marocco()),
+	  m_incremental_mapping(),
+	  m_changed_hicanns()
 {
 }
 
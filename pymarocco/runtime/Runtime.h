@@ -1,5 +1,6 @@
 #pragma once
 
+#include <vector>
 #include <boost/serialization/export.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -15,6 +16,10 @@ class access;
 } // namespace serialization
 } // namespace boost
 
+namespace marocco {
+class IncrementalMapping;
+} // namespace marocco
+
 namespace pymarocco {
 namespace runtime {
 
@@ -30,12 +35,38 @@ public:
 	boost::shared_ptr<sthal::Wafer> wafer();
 	boost::shared_ptr<marocco::results::Marocco> results();
 
+	/**
+	 * @brief HICANNs whose configuration was modified by the last mapping run, compared
+	 *        to the run before.
+	 * When \c PyMarocco::incremental_weight_update is set and configurators that do not
+	 * reset the chips are used, only these HICANNs are configured again.  Callers
+	 * configuring the hardware themselves can do the same.  If \c PyMarocco::skip_mapping
+	 * is set, all allocated HICANNs are reported.
+	 * @note This is not serialized.
+	 */
+	std::vector<HMF::Coordinate::HICANNOnWafer> changed_hicanns() const;
+
+#if !defined(PYPLUSPLUS)
+	void changed_hicanns(std::vector<HMF::Coordinate::HICANNOnWafer> const& hicanns);
+
+	/**
+	 * @brief State of the last mapping run, used to detect weight-only changes and to
+	 *        reconfigure only HICANNs whose experiment setup changed.
+	 * @note This is not serialized.
+	 * @see PyMarocco::incremental_weight_update
+	 */
+	boost::shared_ptr<marocco::IncrementalMapping> incremental_mapping();
+	void incremental_mapping(boost::shared_ptr<marocco::IncrementalMapping> const& state);
+#endif // !PYPLUSPLUS
+
 private:
 	Runtime();
 	Runtime(HMF::Coordinate::Wafer const& wafer);
 
 	boost::shared_ptr<sthal::Wafer> m_wafer;
 	boost::shared_ptr<marocco::results::Marocco> m_results;
+	boost::shared_ptr<marocco::IncrementalMapping> m_incremental_mapping;
+	std::vector<HMF::Coordinate::HICANNOnWafer> m_changed_hicanns;
 
 	friend class boost::serialization::access;
 	template<typename Archive>
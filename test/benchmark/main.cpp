@@ -0,0 +1,296 @@
+/**
+ * Benchmark of the individual mapping stages on synthetic networks.
+ *
+ * Placement and routing are run for both L1 routing algorithms and both synapse driver
+ * assignment algorithms, results are written to and read from disk.  The resources used
+ * by each stage (see \c StageTimer) are printed in JSON format, e.g.:
+ * \code{.sh}
+ * marocco-benchmark --topology feed_forward --populations 32 --layers 4 --output ff.json
+ * \endcode
+ * Setting up the L1 routing graph is reported as separate stage \c routing/l1_routing/graph.
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <boost/filesystem.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/program_options.hpp>
+
+#include "hal/Coordinate/iter_all.h"
+#include "redman/backend/MockBackend.h"
+#include "redman/resources/Wafer.h"
+#include "sthal/Wafer.h"
+
+#include "marocco/BioGraph.h"
+#include "marocco/config.h"
+#include "marocco/placement/Placement.h"
+#include "marocco/results/Marocco.h"
+#include "marocco/routing/Routing.h"
+#include "marocco/routing/SynapseLoss.h"
+#include "marocco/util/iterable.h"
+#include "marocco/util/stage_timer.h"
+#include "pymarocco/PyMarocco.h"
+#include "test/benchmark/networks.h"
+
+using namespace HMF::Coordinate;
+namespace po = boost::program_options;
+
+namespace marocco {
+namespace benchmark {
+
+namespace {
+
+struct DefectParameters
+{
+	/// Probability that a HICANN is unavailable.
+	double hicann_rate;
+	/// Probability that a horizontal or vertical L1 bus is unavailable.
+	double bus_rate;
+	size_t seed;
+};
+
+void inject_defects(resource_manager_t& mgr, Wafer const& wafer, DefectParameters const& defects)
+{
+	redman::resources::WaferWithBackend res(mgr.backend(), wafer);
+	std::mt19937 rng(defects.seed);
+	std::bernoulli_distribution hicann_defect(defects.hicann_rate);
+	std::bernoulli_distribution bus_defect(defects.bus_rate);
+
+	for (auto const hicann : iter_all<HICANNOnWafer>()) {
+		if (hicann_defect(rng)) {
+			res.hicanns()->disable(hicann, true);
+			continue;
+		}
+
+		if (defects.bus_rate == 0.) {
+			continue;
+		}
+
+		auto const components = boost::make_shared<redman::resources::Hicann>();
+		for (auto const hline : iter_all<HLineOnHICANN>()) {
+			if (bus_defect(rng)) {
+				components->hbuses()->disable(hline);
+			}
+		}
+		for (auto const vline : iter_all<VLineOnHICANN>()) {
+			if (bus_defect(rng)) {
+				components->vbuses()->disable(vline);
+			}
+		}
+		res.inject(hicann, components);
+	}
+
+	mgr.inject(res);
+}
+
+size_t num_synapses(BioGraph const& bio_graph)
+{
+	size_t result = 0;
+	for (auto const& edge : make_iterable(boost::edges(bio_graph.graph()))) {
+		result += bio_graph.connectivity(edge).size();
+	}
+	return result;
+}
+
+void write_json(std::ostream& os, pymarocco::StageStatistics const& stage)
+{
+	os << "{\"name\": \"" << stage.name << "\", \"calls\": " << stage.calls
+	   << ", \"wall_time\": " << stage.wall_time << ", \"cpu_time\": " << stage.cpu_time
+	   << ", \"peak_rss_delta\": " << stage.peak_rss_delta << "}";
+}
+
+/// Map the network once and write the resulting statistics as JSON object.
+void run(
+	std::ostream& os,
+	ObjectStore const& store,
+	Wafer const& wafer,
+	DefectParameters const& defects,
+	routing::parameters::L1Routing::Algorithm algorithm,
+	routing::parameters::SynapseRouting::DriverAssignment driver_assignment,
+	double driver_assignment_time_budget,
+	size_t repetition)
+{
+	auto const pymarocco = pymarocco::PyMarocco::create();
+	pymarocco->l1_routing.algorithm(algorithm);
+	pymarocco->synapse_routing.driver_assignment(driver_assignment);
+	pymarocco->synapse_routing.driver_assignment_time_budget(driver_assignment_time_budget);
+	pymarocco->neuron_placement.skip_hicanns_without_neuron_blacklisting(false);
+	auto& stats = pymarocco->getStats();
+
+	resource_manager_t mgr{boost::make_shared<redman::backend::MockBackend>()};
+	inject_defects(mgr, wafer, defects);
+
+	sthal::Wafer hardware(wafer);
+	results::Marocco results;
+	for (auto const hicann : mgr.present()) {
+		results.resources.add(hicann);
+	}
+
+	BioGraph bio_graph;
+	{
+		StageTimer timer(stats, "bio_graph");
+		bio_graph.load(store);
+	}
+
+	{
+		StageTimer timer(stats, "placement");
+		placement::Placement placer(*pymarocco, bio_graph, hardware, mgr);
+		placer.run(results.placement);
+	}
+
+	size_t synapse_loss = 0;
+	{
+		StageTimer timer(stats, "routing");
+		routing::Routing router(bio_graph, hardware, mgr, *pymarocco, results.placement);
+		router.run(results.l1_routing, results.synapse_routing);
+		synapse_loss = router.getSynapseLoss()->getTotalLoss();
+	}
+
+	auto const filename = (boost::filesystem::temp_directory_path() /
+	                       boost::filesystem::unique_path("marocco-benchmark-%%%%-%%%%.bin"))
+	                          .native();
+	{
+		StageTimer timer(stats, "results_save");
+		results.save(filename, /*overwrite=*/true);
+	}
+	{
+		StageTimer timer(stats, "results_load");
+		results::Marocco loaded;
+		loaded.load(filename);
+	}
+	boost::filesystem::remove(filename);
+
+	os << "{\"l1_routing\": \""
+	   << (algorithm == routing::parameters::L1Routing::Algorithm::backbone ? "backbone"
+	                                                                         : "dijkstra")
+	   << "\", \"driver_assignment\": \""
+	   << (driver_assignment == routing::parameters::SynapseRouting::DriverAssignment::fieres
+	           ? "fieres"
+	           : "optimal")
+	   << "\", \"repetition\": " << repetition << ", \"synapse_loss\": " << synapse_loss
+	   << ", \"synapses\": " << num_synapses(bio_graph) << ", \"stages\": [";
+	bool first = true;
+	for (auto const& stage : stats.getStages()) {
+		os << (first ? "\n\t\t\t" : ",\n\t\t\t");
+		first = false;
+		write_json(os, stage);
+	}
+	os << "]}";
+}
+
+} // namespace
+
+} // namespace benchmark
+} // namespace marocco
+
+int main(int argc, char** argv)
+{
+	using namespace marocco;
+	using namespace marocco::benchmark;
+
+	NetworkParameters network;
+	DefectParameters defects{0., 0., 0};
+	size_t wafer = 33;
+	size_t repetitions = 1;
+	double driver_assignment_time_budget = 1.;
+	std::string output;
+
+	po::options_description options("Benchmark of marocco mapping stages");
+	// clang-format off
+	options.add_options()
+		("help", "print this message")
+		("topology", po::value(&network.topology)->default_value(network.topology),
+		 "ring, random, all_to_all or feed_forward")
+		("populations", po::value(&network.populations)->default_value(network.populations),
+		 "number of neuron populations")
+		("size", po::value(&network.population_size)->default_value(network.population_size),
+		 "number of neurons per population")
+		("probability", po::value(&network.probability)->default_value(network.probability),
+		 "connection probability between neurons of connected populations")
+		("projection-probability",
+		 po::value(&network.projection_probability)->default_value(network.projection_probability),
+		 "probability that two populations are connected (random)")
+		("layers", po::value(&network.layers)->default_value(network.layers),
+		 "number of layers (feed_forward)")
+		("spike-sources",
+		 po::value(&network.spike_sources)->default_value(network.spike_sources),
+		 "number of spike sources")
+		("seed", po::value(&network.seed)->default_value(network.seed),
+		 "seed for network and defects")
+		("hicann-defect-rate", po::value(&defects.hicann_rate)->default_value(defects.hicann_rate),
+		 "probability that a HICANN is unavailable")
+		("bus-defect-rate", po::value(&defects.bus_rate)->default_value(defects.bus_rate),
+		 "probability that an L1 bus is unavailable")
+		("wafer", po::value(&wafer)->default_value(wafer), "wafer to map to")
+		("repetitions", po::value(&repetitions)->default_value(repetitions),
+		 "number of runs per L1 routing and driver assignment algorithm")
+		("driver-assignment-time-budget",
+		 po::value(&driver_assignment_time_budget)->default_value(driver_assignment_time_budget),
+		 "time in seconds the optimal driver assignment may spend per side of a HICANN")
+		("output", po::value(&output), "JSON output file, defaults to stdout");
+	// clang-format on
+
+	po::variables_map vm;
+	try {
+		po::store(po::parse_command_line(argc, argv, options), vm);
+		po::notify(vm);
+	} catch (po::error const& err) {
+		std::cerr << err.what() << "\n" << options;
+		return EXIT_FAILURE;
+	}
+
+	if (vm.count("help")) {
+		std::cout << options;
+		return EXIT_SUCCESS;
+	}
+
+	defects.seed = network.seed;
+
+	ObjectStore store;
+	create_network(store, network);
+
+	std::ofstream file;
+	if (!output.empty()) {
+		file.open(output);
+		if (!file) {
+			std::cerr << "could not open " << output << "\n";
+			return EXIT_FAILURE;
+		}
+	}
+	std::ostream& os = output.empty() ? std::cout : file;
+
+	os << "{\n\t\"network\": {\"topology\": \"" << network.topology
+	   << "\", \"populations\": " << network.populations
+	   << ", \"size\": " << network.population_size
+	   << ", \"probability\": " << network.probability
+	   << ", \"projection_probability\": " << network.projection_probability
+	   << ", \"layers\": " << network.layers
+	   << ", \"spike_sources\": " << network.spike_sources
+	   << ", \"seed\": " << network.seed << "},\n"
+	   << "\t\"defects\": {\"hicann_rate\": " << defects.hicann_rate
+	   << ", \"bus_rate\": " << defects.bus_rate << "},\n"
+	   << "\t\"wafer\": " << wafer << ",\n"
+	   << "\t\"runs\": [";
+
+	bool first = true;
+	for (auto const algorithm : {routing::parameters::L1Routing::Algorithm::backbone,
+	                             routing::parameters::L1Routing::Algorithm::dijkstra}) {
+		for (auto const driver_assignment :
+		     {routing::parameters::SynapseRouting::DriverAssignment::fieres,
+		      routing::parameters::SynapseRouting::DriverAssignment::optimal}) {
+			for (size_t repetition = 0; repetition < repetitions; ++repetition) {
+				os << (first ? "\n\t\t" : ",\n\t\t");
+				first = false;
+				run(os, store, Wafer(wafer), defects, algorithm, driver_assignment,
+				    driver_assignment_time_budget, repetition);
+			}
+		}
+	}
+	os << "\n\t]\n}\n";
+
+	return EXIT_SUCCESS;
+}
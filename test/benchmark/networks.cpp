@@ -0,0 +1,93 @@
+#include "test/benchmark/networks.h"
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <boost/make_shared.hpp>
+
+#include "euter/fixedprobabilityconnector.h"
+#include "euter/nativerandomgenerator.h"
+#include "euter/population.h"
+#include "euter/projection.h"
+
+namespace marocco {
+namespace benchmark {
+
+NetworkParameters::NetworkParameters()
+	: topology("ring"),
+	  populations(16),
+	  population_size(64),
+	  probability(0.1),
+	  projection_probability(0.2),
+	  layers(4),
+	  spike_sources(64),
+	  seed(1234)
+{
+}
+
+void create_network(ObjectStore& store, NetworkParameters const& parameters)
+{
+	auto const rng = boost::make_shared<NativeRandomGenerator>(parameters.seed);
+	auto const connector = boost::make_shared<FixedProbabilityConnector>(
+		parameters.probability, /*allow_self_connections=*/true, /*weight=*/0.01);
+	std::mt19937 projection_rng(parameters.seed);
+	std::bernoulli_distribution has_projection(parameters.projection_probability);
+
+	std::vector<PopulationPtr> populations;
+	for (size_t ii = 0; ii < parameters.populations; ++ii) {
+		populations.push_back(
+			Population::create(store, parameters.population_size, CellType::IF_cond_exp));
+	}
+
+	auto connect = [&](PopulationPtr const& source, PopulationPtr const& target) {
+		Projection::create(store, source, target, connector, rng);
+	};
+
+	size_t const n = populations.size();
+	size_t inputs = n == 0 ? 0 : 1;
+	if (parameters.topology == "ring") {
+		for (size_t ii = 0; ii < n; ++ii) {
+			connect(populations[ii], populations[(ii + 1) % n]);
+		}
+	} else if (parameters.topology == "random") {
+		for (auto const& source : populations) {
+			for (auto const& target : populations) {
+				if (has_projection(projection_rng)) {
+					connect(source, target);
+				}
+			}
+		}
+	} else if (parameters.topology == "all_to_all") {
+		for (auto const& source : populations) {
+			for (auto const& target : populations) {
+				connect(source, target);
+			}
+		}
+	} else if (parameters.topology == "feed_forward") {
+		if (parameters.layers == 0 || n % parameters.layers != 0) {
+			throw std::invalid_argument("number of populations has to be a multiple of layers");
+		}
+		size_t const width = n / parameters.layers;
+		for (size_t layer = 0; layer + 1 < parameters.layers; ++layer) {
+			for (size_t ii = 0; ii < width; ++ii) {
+				for (size_t jj = 0; jj < width; ++jj) {
+					connect(populations[layer * width + ii], populations[(layer + 1) * width + jj]);
+				}
+			}
+		}
+		inputs = width;
+	} else {
+		throw std::invalid_argument("unknown topology " + parameters.topology);
+	}
+
+	if (parameters.spike_sources != 0) {
+		auto const sources =
+			Population::create(store, parameters.spike_sources, CellType::SpikeSourcePoisson);
+		for (size_t ii = 0; ii < inputs; ++ii) {
+			connect(sources, populations[ii]);
+		}
+	}
+}
+
+} // namespace benchmark
+} // namespace marocco
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string>
+
+#include "euter/objectstore.h"
+
+namespace marocco {
+namespace benchmark {
+
+/// Parameters of synthetic networks used for benchmarking.
+struct NetworkParameters
+{
+	NetworkParameters();
+
+	/// One of "ring", "random", "all_to_all" and "feed_forward".
+	std::string topology;
+	/// Number of neuron populations.
+	size_t populations;
+	/// Number of neurons per population.
+	size_t population_size;
+	/// Connection probability between neurons of connected populations.
+	double probability;
+	/// Probability that two populations are connected, only used for "random".
+	double projection_probability;
+	/// Number of layers, only used for "feed_forward".
+	size_t layers;
+	/// Number of spike sources, each projecting onto the first population (or layer).
+	size_t spike_sources;
+	size_t seed;
+};
+
+/**
+ * @brief Populate the object store with a synthetic network.
+ * - ring: population \f$i\f$ projects onto population \f$i + 1\f$, the last one onto the
+ *   first one.
+ * - random: each ordered pair of populations is connected with probability
+ *   \c projection_probability.
+ * - all_to_all: each population projects onto all populations, including itself.
+ * - feed_forward: populations are split into \c layers layers of equal size, each
+ *   population projects onto all populations of the next layer.
+ * @throw std::invalid_argument If the topology is unknown.
+ */
+void create_network(ObjectStore& store, NetworkParameters const& parameters);
+
+} // namespace benchmark
+} // namespace marocco
@@ -2,7 +2,11 @@
 
 #include <algorithm>
 #include <iterator>
+#include <sstream>
 #include <vector>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include "hal/Coordinate/HMFGeometry.h"
 #include "marocco/coordinates/LogicalNeuron.h"
@@ -176,6 +180,56 @@ TEST(LogicalNeuron, backInserter)
 	EXPECT_EQ(12, nrn.size());
 }
 
+TEST(LogicalNeuron, rectangularEqualsBuiltNeuron)
+{
+	typedef NeuronOnNeuronBlock N;
+	NeuronBlockOnWafer const nb{};
+	auto const nrn = LogicalNeuron::rectangular(N(X(4), Y(0)).toNeuronOnWafer(nb), 8);
+	auto const reference =
+		LogicalNeuron::on(nb).add(N(X(4), Y(0)), 4).add(N(X(4), Y(1)), 4).done();
+	EXPECT_EQ(reference, nrn);
+	EXPECT_EQ(hash_value(reference), hash_value(nrn));
+	EXPECT_EQ(8, nrn.size());
+	EXPECT_TRUE(nrn.is_rectangular());
+
+	EXPECT_ANY_THROW(LogicalNeuron::rectangular(N(X(30), Y(0)).toNeuronOnWafer(nb), 8))
+		<< "Neuron exceeds neuron block bounds.";
+}
+
+TEST(LogicalNeuron, canBeSerialized)
+{
+	typedef NeuronOnNeuronBlock N;
+	NeuronBlockOnWafer const nb{};
+	std::vector<LogicalNeuron> const neurons{
+		LogicalNeuron::external(5, 3),
+		LogicalNeuron::rectangular(N(X(2), Y(0)).toNeuronOnWafer(nb), 4),
+		// More chunks than can be stored inline:
+		LogicalNeuron::on(nb)
+			.add(N(X(1), Y(0)), 3)
+			.add(N(X(3), Y(1)), 3)
+			.add(N(X(5), Y(0)), 3)
+			.add(N(X(7), Y(1)), 3)
+			.add(N(X(9), Y(0)), 3)
+			.add(N(X(11), Y(1)), 3)
+			.done()};
+
+	std::stringstream stream;
+	{
+		boost::archive::binary_oarchive archive{stream};
+		archive << neurons;
+	}
+	std::vector<LogicalNeuron> loaded;
+	{
+		boost::archive::binary_iarchive archive{stream};
+		archive >> loaded;
+	}
+
+	ASSERT_EQ(neurons, loaded);
+	EXPECT_EQ(18, loaded.back().size());
+	EXPECT_EQ(N(X(13), Y(1)), loaded.back().back().toNeuronOnNeuronBlock());
+	EXPECT_TRUE(loaded.back().shares_denmems_with(neurons.back()));
+}
+
 TEST(LogicalNeuron, canBeIterated)
 {
 	NeuronBlockOnWafer const nb{};
@@ -0,0 +1,83 @@
+#include "test/common.h"
+
+#include <utility>
+#include <vector>
+
+#include "marocco/experiment/MembraneTrace.h"
+
+namespace marocco {
+namespace experiment {
+
+class AMembraneTrace : public ::testing::Test
+{
+protected:
+	typedef std::vector<std::pair<float, float> > trace_type;
+
+	AMembraneTrace()
+	{
+		parameters.bio_duration_in_s(1.);
+		parameters.offset_in_s(1.);
+		parameters.speedup(1.);
+		param_trafo.shift_v = 1.;
+		param_trafo.alpha_v = 10.;
+	}
+
+	size_t append(std::vector<double> const& times, std::vector<double> const& voltages)
+	{
+		return append_membrane_trace(times, voltages, parameters, param_trafo, trace);
+	}
+
+	parameters::Experiment parameters;
+	pymarocco::ParamTrafo param_trafo;
+	trace_type trace;
+};
+
+TEST_F(AMembraneTrace, convertsToBiologicalUnits)
+{
+	EXPECT_EQ(1, append({1.5}, {1.1}));
+	ASSERT_EQ(1, trace.size());
+	EXPECT_FLOAT_EQ(500., trace[0].first);
+	EXPECT_FLOAT_EQ(10., trace[0].second);
+}
+
+TEST_F(AMembraneTrace, usesCommonSamplesOfUnequalLengths)
+{
+	EXPECT_EQ(2, append({1.1, 1.2, 1.3}, {1., 1.}));
+	EXPECT_EQ(2, trace.size());
+
+	EXPECT_EQ(1, append({1.4}, {1., 1., 1.}));
+	ASSERT_EQ(3, trace.size());
+	EXPECT_FLOAT_EQ(400., trace[2].first);
+}
+
+TEST_F(AMembraneTrace, keepsSamplesAtBoundaries)
+{
+	std::vector<double> const times{0.999, 1., 1.5, 2., 2.001};
+	EXPECT_EQ(3, append(times, std::vector<double>(times.size(), 1.)));
+	ASSERT_EQ(3, trace.size());
+	EXPECT_FLOAT_EQ(0., trace.front().first);
+	EXPECT_FLOAT_EQ(1000., trace.back().first);
+}
+
+TEST_F(AMembraneTrace, dropsAllSamplesOutsideOfExperiment)
+{
+	trace.emplace_back(42., 42.);
+	EXPECT_EQ(0, append({0.1, 0.5, 2.5, 3.}, {1., 1., 1., 1.}));
+	ASSERT_EQ(1, trace.size());
+	EXPECT_FLOAT_EQ(42., trace.front().first);
+
+	EXPECT_EQ(0, append({}, {}));
+	EXPECT_EQ(1, trace.size());
+}
+
+TEST_F(AMembraneTrace, canKeepAllSamples)
+{
+	parameters.truncate_membrane_traces(false);
+	EXPECT_EQ(4, append({0.1, 0.5, 2.5, 3.}, {1., 1., 1., 1.}));
+	ASSERT_EQ(4, trace.size());
+	EXPECT_FLOAT_EQ(-900., trace.front().first);
+	EXPECT_FLOAT_EQ(2000., trace.back().first);
+}
+
+} // namespace experiment
+} // namespace marocco
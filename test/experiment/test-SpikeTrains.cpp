@@ -0,0 +1,115 @@
+#include "test/common.h"
+
+#include <limits>
+#include <vector>
+
+#include "marocco/experiment/SpikeTrains.h"
+
+namespace marocco {
+namespace experiment {
+
+class ASpikeTrain : public ::testing::Test
+{
+protected:
+	typedef parameter::results::SpikeTimes::spikes_type spikes_type;
+	typedef HMF::HICANN::L1Address L1Address;
+
+	ASpikeTrain()
+	{
+		parameters.bio_duration_in_s(1.);
+		parameters.offset_in_s(1.);
+		parameters.speedup(10.);
+	}
+
+	parameters::Experiment parameters;
+	std::vector<sthal::Spike> result;
+};
+
+TEST_F(ASpikeTrain, isTruncatedAtEndOfExperiment)
+{
+	spikes_type const spikes{0., 500., 1000., 1000.5, 2000.};
+	auto const train = make_spike_train(L1Address(1), spikes, parameters);
+	EXPECT_EQ(L1Address(1), train.address);
+	EXPECT_EQ(spikes.begin(), train.begin);
+	// Spikes at the end of the experiment are kept.
+	ASSERT_EQ(3, train.size());
+	EXPECT_EQ(1000., *(train.end - 1));
+
+	EXPECT_EQ(0, make_spike_train(L1Address(1), spikes_type{1001.}, parameters).size());
+	EXPECT_EQ(0, make_spike_train(L1Address(1), spikes_type{}, parameters).size());
+}
+
+TEST_F(ASpikeTrain, mergesSortedTrainsInHardwareTime)
+{
+	spikes_type const first{0., 300., 600.};
+	spikes_type const second{100., 200., 700.};
+	spikes_type const empty;
+	std::vector<SpikeTrain> const trains{
+		make_spike_train(L1Address(1), first, parameters),
+		make_spike_train(L1Address(2), empty, parameters),
+		make_spike_train(L1Address(3), second, parameters)};
+
+	result.emplace_back(L1Address(4), 0.);
+	merge_spike_trains(trains, parameters, result);
+
+	// Previous content is replaced.
+	ASSERT_EQ(6, result.size());
+	std::vector<double> const expected_times{0., 100., 200., 300., 600., 700.};
+	std::vector<L1Address> const expected_addresses{
+		L1Address(1), L1Address(3), L1Address(3), L1Address(1), L1Address(1), L1Address(3)};
+	for (size_t ii = 0; ii < result.size(); ++ii) {
+		EXPECT_DOUBLE_EQ(1. + expected_times[ii] * 1e-3 / 10., result[ii].time);
+		EXPECT_EQ(expected_addresses[ii], result[ii].addr);
+	}
+}
+
+TEST_F(ASpikeTrain, ordersSpikesOfEqualTimeByTrain)
+{
+	spikes_type const first{5., 5., 10.};
+	spikes_type const second{0., 5., 10.};
+	std::vector<SpikeTrain> const trains{
+		make_spike_train(L1Address(7), first, parameters),
+		make_spike_train(L1Address(2), second, parameters)};
+
+	merge_spike_trains(trains, parameters, result);
+
+	std::vector<L1Address> const expected{
+		L1Address(2), L1Address(7), L1Address(7), L1Address(2), L1Address(7), L1Address(2)};
+	ASSERT_EQ(expected.size(), result.size());
+	for (size_t ii = 0; ii < result.size(); ++ii) {
+		EXPECT_EQ(expected[ii], result[ii].addr);
+	}
+}
+
+TEST_F(ASpikeTrain, mergesNoTrainsToEmptyStream)
+{
+	result.emplace_back(L1Address(4), 0.);
+	merge_spike_trains({}, parameters, result);
+	EXPECT_TRUE(result.empty());
+}
+
+TEST_F(ASpikeTrain, limitsBufferedSpikesByDefault)
+{
+	EXPECT_EQ(0, parameters.max_buffered_spikes());
+	EXPECT_LT(0, max_buffered_spikes(parameters));
+	EXPECT_GT(std::numeric_limits<size_t>::max(), max_buffered_spikes(parameters));
+
+	parameters.max_buffered_spikes(42);
+	EXPECT_EQ(42, max_buffered_spikes(parameters));
+}
+
+TEST(EndOfBatch, boundsNumberOfBufferedSpikes)
+{
+	std::vector<size_t> const sizes{3, 4, 2, 10, 1};
+	EXPECT_EQ(2, end_of_batch(sizes, 0, 7));
+	EXPECT_EQ(3, end_of_batch(sizes, 1, 7));
+	// At least one stream is processed, even if it exceeds the limit.
+	EXPECT_EQ(4, end_of_batch(sizes, 3, 7));
+	EXPECT_EQ(5, end_of_batch(sizes, 4, 7));
+	EXPECT_EQ(1, end_of_batch(sizes, 0, 0));
+	EXPECT_EQ(5, end_of_batch(sizes, 0, std::numeric_limits<size_t>::max()));
+	EXPECT_EQ(5, end_of_batch(sizes, 5, 7));
+}
+
+} // namespace experiment
+} // namespace marocco
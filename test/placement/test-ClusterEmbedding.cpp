@@ -0,0 +1,79 @@
+#include "test/common.h"
+
+#include <algorithm>
+#include <set>
+
+#include "marocco/placement/internal/ClusterEmbedding.h"
+#include "marocco/util.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+class AClusterEmbedding : public ::testing::Test
+{
+protected:
+	AClusterEmbedding()
+	{
+		// 4x4 block of HICANNs.
+		for (size_t y = 10; y < 14; ++y) {
+			for (size_t x = 10; x < 14; ++x) {
+				hicanns.push_back(HICANNOnWafer(X(x), Y(y)));
+			}
+		}
+	}
+
+	std::vector<HICANNOnWafer> hicanns;
+}; // AClusterEmbedding
+
+TEST_F(AClusterEmbedding, placesChainOnAdjacentHICANNs)
+{
+	size_t const num_clusters = 6;
+	ClusterEmbedding embedding(hicanns, num_clusters);
+	for (size_t ii = 0; ii + 1 < num_clusters; ++ii) {
+		embedding.add_edge(ii, ii + 1, 10);
+	}
+
+	auto const result = embedding.run();
+	ASSERT_EQ(num_clusters, result.size());
+	EXPECT_EQ(10 * (num_clusters - 1), embedding.wire_length());
+
+	std::set<HICANNOnWafer> used(result.begin(), result.end());
+	EXPECT_EQ(num_clusters, used.size());
+}
+
+TEST_F(AClusterEmbedding, prefersFirstHICANNForUnconnectedClusters)
+{
+	ClusterEmbedding embedding(hicanns, 1);
+	auto const result = embedding.run();
+	ASSERT_EQ(1, result.size());
+	EXPECT_EQ(hicanns.front(), result.front());
+	EXPECT_EQ(0, embedding.wire_length());
+}
+
+TEST_F(AClusterEmbedding, keepsStronglyConnectedClustersClose)
+{
+	// Prefer a HICANN with four neighbors.
+	std::swap(hicanns.front(), hicanns[5]);
+
+	// Star: cluster 4 is connected to all others.
+	ClusterEmbedding embedding(hicanns, 5);
+	for (size_t ii = 0; ii < 4; ++ii) {
+		embedding.add_edge(4, ii, 10);
+	}
+
+	embedding.run();
+	EXPECT_EQ(40, embedding.wire_length());
+}
+
+TEST_F(AClusterEmbedding, throwsIfOutOfResources)
+{
+	ClusterEmbedding embedding(hicanns, hicanns.size() + 1);
+	EXPECT_THROW(embedding.run(), ResourceExhaustedError);
+}
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
@@ -0,0 +1,109 @@
+#include "test/common.h"
+
+#include "marocco/placement/internal/GraphPartitioning.h"
+#include "marocco/util.h"
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+TEST(GraphPartitioning, keepsConnectedVerticesTogether)
+{
+	// Two cliques {0, 1, 2} and {3, 4, 5} with a weak link between them.
+	GraphPartitioning partitioning({1, 1, 1, 1, 1, 1}, {3, 3});
+	partitioning.add_edge(0, 1, 10);
+	partitioning.add_edge(1, 2, 10);
+	partitioning.add_edge(0, 2, 10);
+	partitioning.add_edge(3, 4, 10);
+	partitioning.add_edge(4, 5, 10);
+	partitioning.add_edge(3, 5, 10);
+	partitioning.add_edge(2, 3, 1);
+
+	auto const& result = partitioning.run();
+	ASSERT_EQ(6, result.size());
+	EXPECT_EQ(result[0], result[1]);
+	EXPECT_EQ(result[0], result[2]);
+	EXPECT_EQ(result[3], result[4]);
+	EXPECT_EQ(result[3], result[5]);
+	EXPECT_NE(result[0], result[3]);
+	EXPECT_EQ(1, partitioning.cut());
+}
+
+TEST(GraphPartitioning, respectsCapacities)
+{
+	GraphPartitioning partitioning({4, 4, 4}, {8, 4});
+	partitioning.add_edge(0, 1, 5);
+	partitioning.add_edge(1, 2, 5);
+	partitioning.add_edge(0, 2, 5);
+
+	auto const& result = partitioning.run();
+	auto const& usage = partitioning.usage();
+	EXPECT_EQ(8, usage[0]);
+	EXPECT_EQ(4, usage[1]);
+	EXPECT_EQ(10, partitioning.cut());
+	EXPECT_EQ(3, result.size());
+}
+
+TEST(GraphPartitioning, fillsPartsInOrder)
+{
+	GraphPartitioning partitioning({1, 1, 1}, {5, 5});
+
+	auto const& result = partitioning.run();
+	for (auto const part : result) {
+		EXPECT_EQ(0, part);
+	}
+	EXPECT_EQ(0, partitioning.cut());
+}
+
+TEST(GraphPartitioning, prefersStrongConnectionsWhenPartIsFull)
+{
+	GraphPartitioning partitioning({3, 1, 1, 1}, {5, 5});
+	partitioning.add_edge(0, 3, 1);
+	partitioning.add_edge(1, 2, 1);
+	partitioning.add_edge(2, 3, 2);
+
+	auto const& result = partitioning.run();
+	EXPECT_EQ(result[0], result[3]);
+	EXPECT_EQ(result[2], result[3]);
+	EXPECT_NE(result[1], result[2]);
+	EXPECT_EQ(1, partitioning.cut());
+}
+
+TEST(GraphPartitioning, refinesGivenAssignment)
+{
+	GraphPartitioning partitioning({1, 1, 1, 1}, {2, 2});
+	partitioning.add_edge(0, 1, 5);
+	partitioning.add_edge(2, 3, 5);
+	partitioning.add_edge(1, 2, 1);
+
+	// Vertex 1 and 2 are swapped, but every single move is blocked by capacities.
+	auto const& result = partitioning.run({0, 1, 0, 1});
+	EXPECT_EQ(10 + 1, partitioning.cut());
+	EXPECT_EQ(4, result.size());
+
+	GraphPartitioning relaxed({1, 1, 1, 1}, {4, 4});
+	relaxed.add_edge(0, 1, 5);
+	relaxed.add_edge(2, 3, 5);
+	relaxed.add_edge(1, 2, 1);
+	relaxed.run({0, 1, 0, 1});
+	EXPECT_EQ(0, relaxed.cut());
+
+	EXPECT_THROW(relaxed.run({0, 1}), std::invalid_argument);
+	EXPECT_THROW(relaxed.run({0, 1, 2, 0}), std::invalid_argument);
+}
+
+TEST(GraphPartitioning, throwsIfOutOfResources)
+{
+	GraphPartitioning partitioning({3, 3}, {4, 2});
+	EXPECT_THROW(partitioning.run(), ResourceExhaustedError);
+}
+
+TEST(GraphPartitioning, rejectsUnknownVertices)
+{
+	GraphPartitioning partitioning({1}, {1});
+	EXPECT_THROW(partitioning.add_edge(0, 1, 1), std::out_of_range);
+}
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
@@ -0,0 +1,91 @@
+#include "test/placement/test-MergerTreeRouter.h"
+
+#include "hal/Coordinate/iter_all.h"
+#include "marocco/placement/MergerTreeRouterCache.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace placement {
+
+class AMergerTreeRouterCache : public AMergerTreeRouter
+{
+protected:
+	void SetUp() override
+	{
+		MergerTreeRouterCache::instance().clear();
+	}
+
+	void TearDown() override
+	{
+		MergerTreeRouterCache::instance().clear();
+	}
+
+	MergerTreeRouterCache::result_type get()
+	{
+		return MergerTreeRouterCache::instance().get(
+			graph, MergerTreeRouter::count_neurons(neuron_block_mapping),
+			parameters::MergerRouting::Strategy::minimize_number_of_sending_repeaters);
+	}
+}; // AMergerTreeRouterCache
+
+TEST_F(AMergerTreeRouterCache, returnsSameResultAsRouter)
+{
+	add(NeuronBlockOnHICANN(3), 32);
+	add(NeuronBlockOnHICANN(4), 26);
+	add(NeuronBlockOnHICANN(5), 32);
+
+	auto router = build_router();
+	router.run();
+
+	EXPECT_EQ(router.result(), get());
+	EXPECT_EQ(router.result(), get());
+}
+
+TEST_F(AMergerTreeRouterCache, countsHitsAndMisses)
+{
+	auto& cache = MergerTreeRouterCache::instance();
+
+	add(NeuronBlockOnHICANN(2), 12);
+	get();
+	EXPECT_EQ(0, cache.hits());
+	EXPECT_EQ(1, cache.misses());
+
+	get();
+	get();
+	EXPECT_EQ(2, cache.hits());
+	EXPECT_EQ(1, cache.misses());
+	EXPECT_EQ(1, cache.size());
+
+	add(NeuronBlockOnHICANN(3), 1);
+	get();
+	EXPECT_EQ(2, cache.hits());
+	EXPECT_EQ(2, cache.misses());
+	EXPECT_EQ(2, cache.size());
+}
+
+TEST_F(AMergerTreeRouterCache, distinguishesDefectMergers)
+{
+	auto& cache = MergerTreeRouterCache::instance();
+
+	add(NeuronBlockOnHICANN(2), 12);
+	add(NeuronBlockOnHICANN(3), 32);
+	get();
+	EXPECT_EQ(1, cache.misses());
+
+	// Merger of unused neuron block does not change the result, but the signature.
+	graph.remove(Merger0OnHICANN(7));
+	auto const result = get();
+	EXPECT_EQ(0, cache.hits());
+	EXPECT_EQ(2, cache.misses());
+
+	auto router = build_router();
+	router.run();
+	EXPECT_EQ(router.result(), result);
+
+	get();
+	EXPECT_EQ(1, cache.hits());
+}
+
+} // namespace placement
+} // namespace marocco
@@ -0,0 +1,72 @@
+#include "test/common.h"
+
+#include <set>
+
+#include "marocco/placement/internal/MultilevelPartitioning.h"
+#include "marocco/util.h"
+
+namespace marocco {
+namespace placement {
+namespace internal {
+
+TEST(MultilevelPartitioning, separatesClusters)
+{
+	// Eight dense clusters of 16 vertices each, connected in a ring by single edges.
+	size_t const num_clusters = 8;
+	size_t const cluster_size = 16;
+	MultilevelPartitioning partitioning(
+		std::vector<size_t>(num_clusters * cluster_size, 1), num_clusters, cluster_size);
+
+	for (size_t cluster = 0; cluster < num_clusters; ++cluster) {
+		size_t const offset = cluster * cluster_size;
+		for (size_t ii = 0; ii < cluster_size; ++ii) {
+			for (size_t jj = ii + 1; jj < cluster_size; ++jj) {
+				partitioning.add_edge(offset + ii, offset + jj, 10);
+			}
+		}
+		partitioning.add_edge(offset, ((cluster + 1) % num_clusters) * cluster_size + 1, 1);
+	}
+
+	auto const& result = partitioning.run();
+	ASSERT_EQ(num_clusters * cluster_size, result.size());
+	EXPECT_LT(1, partitioning.num_levels());
+
+	std::set<size_t> parts;
+	for (size_t cluster = 0; cluster < num_clusters; ++cluster) {
+		size_t const offset = cluster * cluster_size;
+		for (size_t ii = 1; ii < cluster_size; ++ii) {
+			EXPECT_EQ(result[offset], result[offset + ii]);
+		}
+		parts.insert(result[offset]);
+	}
+	EXPECT_EQ(num_clusters, parts.size());
+	EXPECT_EQ(num_clusters, partitioning.cut());
+}
+
+TEST(MultilevelPartitioning, respectsCapacity)
+{
+	MultilevelPartitioning partitioning(std::vector<size_t>(20, 1), 4, 5);
+	for (size_t ii = 0; ii + 1 < 20; ++ii) {
+		partitioning.add_edge(ii, ii + 1, 1);
+	}
+
+	auto const& result = partitioning.run();
+	std::vector<size_t> usage(4, 0);
+	for (auto const part : result) {
+		ASSERT_GT(4, part);
+		++usage[part];
+	}
+	for (auto const count : usage) {
+		EXPECT_EQ(5, count);
+	}
+}
+
+TEST(MultilevelPartitioning, throwsIfOutOfResources)
+{
+	MultilevelPartitioning partitioning(std::vector<size_t>(10, 1), 2, 4);
+	EXPECT_THROW(partitioning.run(), ResourceExhaustedError);
+}
+
+} // namespace internal
+} // namespace placement
+} // namespace marocco
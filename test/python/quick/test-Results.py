@@ -154,21 +154,25 @@ class TestResults(utils.TestWithResults):
         results = self.load_results()
 
         self.assertEqual(0, len(results.spike_times.get(target[0])))
+        # Spike trains are stored sorted.
         for spike_times, pop in zip(params, sources):
             self.assertSequenceEqual(
-                spike_times, results.spike_times.get(pop[0]))
+                sorted(spike_times), results.spike_times.get(pop[0]))
 
-        spike_times.append(5.)
-        results.spike_times.add(pop[0], 5.)
-        self.assertSequenceEqual(spike_times, results.spike_times.get(pop[0]))
+        spike_times.append(2.5)
+        results.spike_times.add(pop[0], 2.5)
+        self.assertSequenceEqual(
+            sorted(spike_times), results.spike_times.get(pop[0]))
 
-        spike_times.extend([6., 7.])
-        results.spike_times.add(pop[0], [6., 7.])
-        self.assertSequenceEqual(spike_times, results.spike_times.get(pop[0]))
+        spike_times.extend([7., 1.])
+        results.spike_times.add(pop[0], [7., 1.])
+        self.assertSequenceEqual(
+            sorted(spike_times), results.spike_times.get(pop[0]))
 
-        spike_times = [42., 123.]
+        spike_times = [123., 42.]
         results.spike_times.set(pop[0], spike_times)
-        self.assertSequenceEqual(spike_times, results.spike_times.get(pop[0]))
+        self.assertSequenceEqual(
+            sorted(spike_times), results.spike_times.get(pop[0]))
 
         params[-1][:] = []
         results.spike_times.clear(pop[0])
@@ -302,6 +306,54 @@ class TestResults(utils.TestWithResults):
             self.assertEqual(1, len(items))
             self.assertTrue(hw_ab.issuperset(to_hw_synapses(items)))
 
+    def test_numpy_export(self):
+        pynn.setup(marocco=self.marocco)
+
+        target = pynn.Population(1, pynn.IF_cond_exp, {})
+        source = pynn.Population(
+            2, pynn.SpikeSourceArray, {'spike_times': [1.]})
+
+        proj = pynn.Projection(
+            source, target, pynn.AllToAllConnector(weights=0.004))
+
+        pynn.run(0)
+        pynn.end()
+
+        results = self.load_results()
+
+        placement = results.placement.to_numpy()
+        self.assertEqual(3, len(placement))
+        self.assertFalse(placement.flags.writeable)
+        for item in results.placement:
+            row, = placement[
+                (placement["population"] == item.bio_neuron().population()) &
+                (placement["neuron_index"] == item.bio_neuron().neuron_index())]
+            address = item.address()
+            self.assertEqual(address.toHICANNOnWafer().toEnum().value(),
+                             row["hicann"])
+            self.assertEqual(address.toDNCMergerOnHICANN().value(),
+                             row["dnc_merger"])
+            self.assertEqual(address.toL1Address().value(),
+                             row["l1_address"])
+            neuron_block = item.neuron_block()
+            self.assertEqual(
+                -1 if neuron_block is None
+                else neuron_block.toNeuronBlockOnHICANN().value(),
+                row["neuron_block"])
+
+        synapses = results.synapse_routing.synapses().to_numpy()
+        self.assertEqual(2, len(synapses))
+        self.assertTrue((synapses["projection"] == proj.euter_id()).all())
+        self.assertTrue(
+            (synapses["target_population"] == target.euter_id()).all())
+        self.assertEqual([0, 1], sorted(synapses["source_neuron_index"]))
+        self.assertTrue((synapses["synapse"] >= 0).all())
+
+        routes = results.l1_routing.to_numpy()
+        self.assertLessEqual(1, len(routes))
+        self.assertTrue((routes["projection"] == proj.euter_id()).all())
+        self.assertTrue((routes["num_hicanns"] >= 1).all())
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -50,6 +50,45 @@ class TestRouting(utils.TestWithResults):
         synapses = results.synapse_routing.synapses()
         self.assertEqual(1, synapses.size())
 
+    def test_routing_portfolio(self):
+        """
+        The backbone router can not establish the convex route of
+        `test_dijkstra_routing`, so the dijkstra candidate has to be picked.
+        """
+        pynn.setup(marocco=self.marocco)
+
+        source = pynn.Population(1, pynn.IF_cond_exp, {})
+        target = pynn.Population(1, pynn.IF_cond_exp, {})
+        proj = pynn.Projection(
+            source, target, pynn.AllToAllConnector(weights=0.004))
+
+        source_hicann = C.HICANNOnWafer(C.Enum(167))
+        target_hicann = C.HICANNOnWafer(C.Enum(240))
+        self.marocco.manual_placement.on_hicann(source, source_hicann)
+        self.marocco.manual_placement.on_hicann(target, target_hicann)
+
+        allowed_hicanns = [206] + range(167, 171) + range(240, 243)
+        wafer = self.marocco.default_wafer
+        for hicann in C.iter_all(C.HICANNOnWafer):
+            if hicann.id().value() in allowed_hicanns:
+                continue
+            self.marocco.defects.disable(C.HICANNGlobal(hicann, wafer))
+
+        L1Routing = type(self.marocco.l1_routing)
+        for algorithm in [L1Routing.backbone, L1Routing.dijkstra]:
+            candidate = L1Routing()
+            candidate.algorithm(algorithm)
+            self.marocco.routing_portfolio.add(candidate)
+        self.marocco.routing_portfolio.deadline(60.)
+
+        pynn.run(0)
+        pynn.end()
+
+        results = self.load_results()
+
+        synapses = results.synapse_routing.synapses()
+        self.assertEqual(1, synapses.size())
+
 
 if __name__ == '__main__':
     unittest.main()
@@ -416,6 +416,21 @@ TEST_F(AHICANNManager, CanBeIteratedOverMultipleWafersWooooaaaah) {
 	ASSERT_EQ(Co::HICANNOnWafer::enum_type::size * 2, count);
 }
 
+TEST_P(AHICANNManagerWithHICANN, CanBeCopiedIndependently) {
+	HICANNManager copy = manager;
+	copy.allocate(hicann);
+	ASSERT_TRUE(manager.available(hicann));
+	ASSERT_FALSE(copy.available(hicann));
+
+	size_t count = 0;
+	for (auto other : copy.allocated()) {
+		ASSERT_EQ(hicann, other);
+		++count;
+	}
+	ASSERT_EQ(1, count);
+	ASSERT_TRUE(manager.allocated().empty());
+}
+
 TEST_P(AHICANNManagerWithOmittedHICANN, OmitsHicannWhenIterating) {
 	size_t count = 0;
 
@@ -0,0 +1,64 @@
+#include "test/common.h"
+
+#include "marocco/results/Marocco.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace results {
+
+class AMarocco : public ::testing::Test
+{
+protected:
+	AMarocco()
+		: hicann(Enum(42)),
+		  neuron(LogicalNeuron::on(NeuronBlockOnWafer(NeuronBlockOnHICANN(0), hicann))
+		             .add(NeuronOnNeuronBlock(X(0), Y(0)), 2)
+		             .done()),
+		  external(LogicalNeuron::external(0, 0)),
+		  address(DNCMergerOnWafer(DNCMergerOnHICANN(0), hicann), HMF::HICANN::L1Address(1))
+	{
+		results.resources.add(hicann);
+	}
+
+	HICANNOnWafer const hicann;
+	LogicalNeuron const neuron;
+	LogicalNeuron const external;
+	L1AddressOnWafer const address;
+	Marocco results;
+};
+
+TEST_F(AMarocco, reflectsLaterModificationsInProperties)
+{
+	EXPECT_TRUE(results.properties(hicann).is_transit_only());
+
+	results.placement.add(BioNeuron(0, 0), neuron);
+	EXPECT_EQ(1, results.properties(hicann).num_neurons());
+	EXPECT_EQ(0, results.properties(hicann).num_inputs());
+
+	results.placement.add(BioNeuron(1, 0), external);
+	EXPECT_EQ(0, results.properties(hicann).num_inputs());
+
+	results.placement.set_address(external, address);
+	EXPECT_EQ(1, results.properties(hicann).num_neurons());
+	EXPECT_EQ(1, results.properties(hicann).num_inputs());
+}
+
+TEST_F(AMarocco, reflectsAssignedResultsInProperties)
+{
+	Marocco other;
+	other.placement.add(BioNeuron(0, 0), neuron);
+
+	// Both placement results have been modified once.
+	results.placement.add(BioNeuron(0, 0), external);
+	EXPECT_EQ(0, results.properties(hicann).num_neurons());
+
+	results.placement = other.placement;
+	EXPECT_EQ(1, results.properties(hicann).num_neurons());
+
+	results.resources = Resources();
+	EXPECT_FALSE(results.properties(hicann).is_available());
+}
+
+} // namespace results
+} // namespace marocco
@@ -88,5 +88,71 @@ TEST(RoutingConfiguration, configureWithTestOutput)
 	EXPECT_EQ(hicann2_ref, hw[hicann2]);
 }
 
+TEST(RoutingConfiguration, recordedChangesMatchDirectConfiguration)
+{
+	HICANNOnWafer const hicann1(X(5), Y(5));
+	HICANNOnWafer const hicann2(X(6), Y(5));
+	HICANNOnWafer const hicann3(X(7), Y(5));
+	std::vector<L1Route> routes{
+	    L1Route{hicann1, DNCMergerOnHICANN(2), HLineOnHICANN(46), hicann2, HLineOnHICANN(48),
+	            VLineOnHICANN(39)},
+	    L1Route{hicann2, DNCMergerOnHICANN(2), HLineOnHICANN(46), hicann3, HLineOnHICANN(48),
+	            VLineOnHICANN(39)},
+	    L1Route{hicann1, DNCMergerOnHICANN(2), HLineOnHICANN(46), VLineOnHICANN(8)}};
+
+	sthal::Wafer hw;
+	for (auto const& route : routes) {
+		configure(hw, route);
+	}
+
+	ConfigurationChanges changes;
+	for (auto const& route : routes) {
+		configure(changes, route);
+	}
+	EXPECT_EQ((std::vector<HICANNOnWafer>{hicann1, hicann2, hicann3}), changes.hicanns());
+
+	sthal::Wafer parallel_hw;
+	changes.apply(parallel_hw);
+
+	EXPECT_EQ(hw.getAllocatedHicannCoordinates(), parallel_hw.getAllocatedHicannCoordinates());
+	for (auto const& hicann : changes.hicanns()) {
+		EXPECT_EQ(hw[hicann], parallel_hw[hicann]);
+	}
+}
+
+TEST(RoutingConfiguration, groupsRecordedChangesByHICANN)
+{
+	HICANNOnWafer const hicann1(X(5), Y(5));
+	HICANNOnWafer const hicann2(X(6), Y(5));
+	auto const repeater = HLineOnHICANN(46).toHRepeaterOnHICANN();
+
+	ConfigurationChanges changes;
+	EXPECT_TRUE(changes.empty());
+
+	changes[hicann2].crossbar_switches.emplace_back(VLineOnHICANN(39), HLineOnHICANN(48));
+	changes[hicann1].horizontal_repeaters.push_back({repeater, right, true});
+	// Later changes to the same repeater take precedence.
+	changes[hicann1].horizontal_repeaters.push_back({repeater, right, false});
+	changes[hicann2].crossbar_switches.emplace_back(VLineOnHICANN(8), HLineOnHICANN(46));
+	EXPECT_EQ((std::vector<HICANNOnWafer>{hicann2, hicann1}), changes.hicanns());
+	EXPECT_EQ(2, changes[hicann2].crossbar_switches.size());
+
+	sthal::Wafer hw;
+	changes.apply(hw);
+
+	sthal::HICANN hicann1_ref;
+	sthal::HICANN hicann2_ref;
+	hicann1_ref.repeater[repeater].setOutput(right);
+	hicann2_ref.crossbar_switches.set(VLineOnHICANN(39), HLineOnHICANN(48), true);
+	hicann2_ref.crossbar_switches.set(VLineOnHICANN(8), HLineOnHICANN(46), true);
+	EXPECT_EQ(hicann1_ref, hw[hicann1]);
+	EXPECT_EQ(hicann2_ref, hw[hicann2]);
+
+	changes.clear();
+	EXPECT_TRUE(changes.empty());
+	EXPECT_TRUE(changes[hicann1].horizontal_repeaters.empty());
+	EXPECT_EQ(std::vector<HICANNOnWafer>{hicann1}, changes.hicanns());
+}
+
 } // namespace routing
 } // namespace marocco
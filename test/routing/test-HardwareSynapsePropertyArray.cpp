@@ -0,0 +1,67 @@
+#include "test/common.h"
+
+#include <map>
+
+#include "marocco/routing/HardwareSynapsePropertyArray.h"
+
+using namespace HMF::Coordinate;
+using HMF::HICANN::DriverDecoder;
+
+namespace marocco {
+namespace routing {
+
+TEST(HardwareSynapsePropertyArray, enumeratesAllProperties)
+{
+	std::map<Side_Parity_Decoder_STP, size_t> indices;
+	for (size_t ii = 0; ii < SynapseHistogram::size; ++ii) {
+		auto const key = SynapseHistogram::to_key(ii);
+		EXPECT_EQ(ii, SynapseHistogram::to_index(key));
+		indices[key] = ii;
+	}
+	ASSERT_EQ(48, indices.size());
+
+	// Indices follow the lexicographic order of the key tuple.
+	size_t expected = 0;
+	for (auto const& item : indices) {
+		EXPECT_EQ(expected++, item.second);
+	}
+
+	EXPECT_THROW(SynapseHistogram::to_key(SynapseHistogram::size), std::out_of_range);
+}
+
+TEST(HardwareSynapsePropertyArray, behavesLikeMap)
+{
+	Side_Parity_Decoder_STP const p1(left, Parity(0), DriverDecoder(2), STPMode::depression);
+	Side_Parity_Decoder_STP const p2(right, Parity(1), DriverDecoder(0), STPMode::off);
+
+	SynapseHistogram histogram;
+	std::map<Side_Parity_Decoder_STP, size_t> reference;
+	histogram[p2] += 3;
+	reference[p2] += 3;
+	histogram[p1]++;
+	reference[p1]++;
+
+	EXPECT_EQ(1, histogram.at(p1));
+	EXPECT_EQ(3, histogram[p2]);
+
+	auto ref_it = reference.begin();
+	size_t total = 0;
+	for (auto const& item : histogram) {
+		total += item.second;
+		if (item.second == 0) {
+			continue;
+		}
+		ASSERT_TRUE(ref_it != reference.end());
+		EXPECT_EQ(ref_it->first, item.first);
+		EXPECT_EQ(ref_it->second, item.second);
+		++ref_it;
+	}
+	EXPECT_TRUE(ref_it == reference.end());
+	EXPECT_EQ(4, total);
+
+	histogram.clear();
+	EXPECT_EQ(0, histogram[p2]);
+}
+
+} // namespace routing
+} // namespace marocco
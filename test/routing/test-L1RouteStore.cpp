@@ -0,0 +1,144 @@
+#include "test/common.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include <boost/optional.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+#include "marocco/routing/results/L1RouteStore.h"
+#include "marocco/routing/results/L1Routing.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace routing {
+namespace results {
+
+class AL1RouteStore : public ::testing::Test
+{
+protected:
+	AL1RouteStore()
+		: hicann1(X(5), Y(5)),
+		  hicann2(X(6), Y(5)),
+		  route1{hicann1, HLineOnHICANN(46), hicann2, HLineOnHICANN(48), VLineOnHICANN(39)},
+		  route2{hicann1, HLineOnHICANN(46), hicann2, HLineOnHICANN(48), VLineOnHICANN(7)}
+	{
+	}
+
+	HICANNOnWafer hicann1;
+	HICANNOnWafer hicann2;
+	L1Route route1;
+	L1Route route2;
+};
+
+TEST_F(AL1RouteStore, restoresRoutes)
+{
+	L1RouteStore store;
+	auto const handle1 = store.add(route1, {});
+	auto const handle2 = store.add(route2, {});
+	EXPECT_EQ(route1, store.get(handle1));
+	EXPECT_EQ(route2, store.get(handle2));
+	EXPECT_EQ((std::vector<HICANNOnWafer>{hicann1, hicann2}), store.hicanns(handle2));
+	EXPECT_EQ(10, store.size());
+	EXPECT_THROW(store.get(10), std::out_of_range);
+}
+
+TEST_F(AL1RouteStore, sharesCommonPrefixes)
+{
+	L1RouteStore store;
+	auto const handle1 = store.add(route1, {});
+	auto const handle2 = store.add(route2, {handle1});
+	EXPECT_EQ(6, store.size());
+	EXPECT_EQ(route1, store.get(handle1));
+	EXPECT_EQ(route2, store.get(handle2));
+
+	// Identical routes (e.g. to different targets) are stored only once.
+	EXPECT_EQ(handle2, store.add(route2, {handle1, handle2}));
+	EXPECT_EQ(6, store.size());
+}
+
+TEST_F(AL1RouteStore, storesSynapsesInTwoWords)
+{
+	L1Route const route(
+		L1Route::sequence_type{hicann1, VLineOnHICANN(39), SynapseDriverOnHICANN(Enum(100)),
+		                       SynapseOnHICANN(Enum(50000))},
+		L1Route::no_verify_tag());
+
+	L1RouteStore store;
+	auto const handle = store.add(route, {});
+	EXPECT_EQ(5, store.size());
+	EXPECT_EQ(route, store.get(handle));
+	EXPECT_EQ((std::vector<HICANNOnWafer>{hicann1}), store.hicanns(handle));
+}
+
+TEST_F(AL1RouteStore, traversesSegmentsWithoutCopies)
+{
+	L1RouteStore store;
+	auto const handle1 = store.add(route1, {});
+	auto const handle2 = store.add(route2, {handle1});
+
+	auto const segments = store.segments(handle2);
+	EXPECT_TRUE(std::equal(route2.begin(), route2.end(), segments.begin()));
+	EXPECT_EQ(route2.size(), size_t(std::distance(segments.begin(), segments.end())));
+	EXPECT_EQ(route2.back(), segments.back());
+	EXPECT_EQ(hicann1, segments.source_hicann());
+	EXPECT_EQ(hicann2, segments.target_hicann());
+	EXPECT_THROW(store.segments(10), std::out_of_range);
+}
+
+TEST_F(AL1RouteStore, traversesSynapses)
+{
+	L1Route const route(
+		L1Route::sequence_type{hicann1, VLineOnHICANN(39), SynapseDriverOnHICANN(Enum(100)),
+		                       SynapseOnHICANN(Enum(50000))},
+		L1Route::no_verify_tag());
+
+	L1RouteStore store;
+	auto const segments = store.segments(store.add(route, {}));
+	EXPECT_EQ(route.size(), size_t(std::distance(segments.begin(), segments.end())));
+	EXPECT_EQ(route.back(), segments.back());
+	EXPECT_EQ(hicann1, segments.target_hicann());
+}
+
+TEST_F(AL1RouteStore, outlivesRoutingResult)
+{
+	L1Route const route(
+		L1Route::sequence_type{hicann1, DNCMergerOnHICANN(3), HLineOnHICANN(46), hicann2,
+		                       HLineOnHICANN(48), VLineOnHICANN(39)},
+		L1Route::no_verify_tag());
+	boost::optional<L1Routing::route_item_type> item;
+	{
+		L1Routing routing;
+		item = routing.add(route, hicann2);
+	}
+	EXPECT_EQ(route, item->route());
+	EXPECT_EQ(hicann2, item->segments().target_hicann());
+}
+
+TEST_F(AL1RouteStore, canBeSerialized)
+{
+	L1RouteStore store;
+	auto const handle1 = store.add(route1, {});
+	auto const handle2 = store.add(route2, {handle1});
+
+	std::stringstream stream;
+	{
+		boost::archive::binary_oarchive archive{stream};
+		archive << store;
+	}
+	L1RouteStore loaded;
+	{
+		boost::archive::binary_iarchive archive{stream};
+		archive >> loaded;
+	}
+
+	EXPECT_EQ(store.size(), loaded.size());
+	EXPECT_EQ(route1, loaded.get(handle1));
+	EXPECT_EQ(route2, loaded.get(handle2));
+}
+
+} // namespace results
+} // namespace routing
+} // namespace marocco
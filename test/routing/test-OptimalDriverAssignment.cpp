@@ -0,0 +1,103 @@
+#include <algorithm>
+#include <set>
+
+#include "test/common.h"
+#include "marocco/routing/OptimalDriverAssignment.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace routing {
+
+namespace {
+
+typedef std::vector<DriverInterval> IntervalList;
+
+std::chrono::duration<double> const time_budget(1.);
+
+/// Checks that chains are disjoint, do not contain defects and respect the chain length.
+void expect_valid(
+	OptimalDriverAssignment::Result const& result,
+	size_t max_chain_length,
+	std::vector<SynapseDriverOnHICANN> const& defects)
+{
+	std::set<SynapseDriverOnHICANN> used;
+	for (auto const& item : result) {
+		for (auto const& connected : item.second) {
+			EXPECT_LE(connected.size(), max_chain_length);
+			for (auto const& driver : connected.drivers()) {
+				EXPECT_TRUE(used.insert(driver).second);
+				EXPECT_EQ(defects.end(), std::find(defects.begin(), defects.end(), driver));
+			}
+		}
+	}
+}
+
+} // namespace
+
+TEST(OptimalDriverAssignment, realizesAllSynapsesIfEnoughDrivers)
+{
+	IntervalList const list = {
+		DriverInterval(VLineOnHICANN(133), 2, 40),
+		DriverInterval(VLineOnHICANN(172), 3, 688),
+		DriverInterval(VLineOnHICANN(205), 3, 321)};
+
+	OptimalDriverAssignment assignment(list, right, 3, {}, time_budget);
+
+	EXPECT_TRUE(assignment.rejected().empty());
+	EXPECT_TRUE(assignment.optimal());
+	EXPECT_DOUBLE_EQ(40 + 688 + 321, assignment.realized_synapses());
+	EXPECT_EQ(3, assignment.result().size());
+	expect_valid(assignment.result(), 3, {});
+}
+
+TEST(OptimalDriverAssignment, isNotWorseThanFieresIfDriversAreScarce)
+{
+	IntervalList list;
+	for (size_t ii = 0; ii < 40; ++ii) {
+		list.emplace_back(VLineOnHICANN(128 + 3 * ii), 1 + ii % 3, 10 + (ii * 37) % 100);
+	}
+
+	std::vector<SynapseDriverOnHICANN> defects;
+	for (auto const& driver : VLineOnHICANN(131).toSynapseDriverOnHICANN(right)) {
+		defects.push_back(driver);
+	}
+
+	Fieres fieres(list, right, 3, defects);
+	double const heuristic =
+		OptimalDriverAssignment::realized_synapses(list, fieres.result());
+
+	OptimalDriverAssignment assignment(list, right, 3, defects, time_budget);
+	EXPECT_GE(assignment.realized_synapses() + 1e-9, heuristic);
+	EXPECT_LE(assignment.realized_synapses(), assignment.upper_bound() + 1e-9);
+	EXPECT_DOUBLE_EQ(
+		assignment.realized_synapses(),
+		OptimalDriverAssignment::realized_synapses(list, assignment.result()));
+	expect_valid(assignment.result(), 3, defects);
+
+	size_t handled = assignment.rejected().size();
+	for (auto const& item : assignment.result()) {
+		handled += !item.second.empty();
+	}
+	EXPECT_EQ(list.size(), handled);
+}
+
+TEST(OptimalDriverAssignment, fallsBackToFieresWithoutTimeBudget)
+{
+	IntervalList list;
+	for (size_t ii = 0; ii < 40; ++ii) {
+		list.emplace_back(VLineOnHICANN(128 + 3 * ii), 3, 10 + ii);
+	}
+
+	Fieres fieres(list, right, 3);
+	OptimalDriverAssignment assignment(
+		list, right, 3, {}, std::chrono::duration<double>::zero());
+
+	EXPECT_GE(
+		assignment.realized_synapses() + 1e-9,
+		OptimalDriverAssignment::realized_synapses(list, fieres.result()));
+	expect_valid(assignment.result(), 3, {});
+}
+
+} // namespace routing
+} // namespace marocco
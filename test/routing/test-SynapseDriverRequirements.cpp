@@ -146,7 +146,7 @@ TEST(SynapseDriverRequirements, resolve_triparity)
 	required_half_rows[TriParity::odd][c6] = 3;
 
 	std::map<Side_Decoder_STP, std::vector<Parity> > triparity_assignmemt_to_parity;
-	std::map<Side_Parity_Decoder_STP, size_t> synrow_hist;
+	SynapseHistogram synrow_hist;
 
 	std::map<Side_Parity_STP, size_t> half_rows_per_parity =
 		SynapseDriverRequirements::resolve_triparity(
@@ -426,8 +426,8 @@ TEST(SynapseDriverRequirements, _calc)
 	sc.add(NeuronOnHICANN(Enum(0)), L1Address(6), SynapseType::excitatory, STPMode::off);
 
 	size_t num_drivers, num_synapses;
-	std::map<Side_Parity_Decoder_STP, size_t> synapse_histogram;
-	std::map<Side_Parity_Decoder_STP, size_t> synrow_histogram;
+	SynapseHistogram synapse_histogram;
+	SynapseHistogram synrow_histogram;
 	std::tie(num_drivers, num_synapses) = SynapseDriverRequirements::_calc(
 		sc, target_synapses_per_synaptic_input_granularity, synapse_histogram, synrow_histogram);
 
@@ -468,7 +468,7 @@ TEST(SynapseDriverRequirements, count_synapses_per_hardware_property)
 	bio_to_hw_assignment[bio3] = Side_TriParity(geometry::right, TriParity::odd);
 
 	// synapse row histogram
-	std::map<Side_Parity_Decoder_STP, size_t> half_rows_assigned_per_parity;
+	SynapseHistogram half_rows_assigned_per_parity;
 	// synapse type 1: requires 2 half rows for 4 synapses, as there are 2 target synapses per (right, even) config.
 	half_rows_assigned_per_parity[Side_Parity_Decoder_STP(geometry::right, Parity::even, DriverDecoder(0), STPMode::off)] = 2;
 	// synapse type 2: requires 3 half rows for 3 synapses on (right, odd) config.
@@ -481,7 +481,7 @@ TEST(SynapseDriverRequirements, count_synapses_per_hardware_property)
 	// only for synapse type 0. Even columns have priority over odd columns.
 	assignmemt_to_parity[ Side_Decoder_STP(geometry::left, DriverDecoder(0), STPMode::off) ].push_back(Parity::even);
 
-	std::map<Side_Parity_Decoder_STP, size_t> hardware_property_counts =
+	SynapseHistogram hardware_property_counts =
 		SynapseDriverRequirements::count_synapses_per_hardware_property(
 			bio_property_counts, bio_to_hw_assignment,
 			target_synapses_per_parity_and_synaptic_input,
@@ -507,7 +507,7 @@ struct map_acc
 // procedure taken from SynapseManager.init().
 // needed for next tests
 size_t count_drivers_from_synrow_histogram(
-		std::map<Side_Parity_Decoder_STP, size_t> const& synrow_histogram
+		SynapseHistogram const& synrow_histogram
 		)
 {
 	typedef std::map<STPMode,
@@ -593,8 +593,8 @@ TEST(SynapseDriverRequirements, Issue2115_minimal)
 	sc.add(NeuronOnHICANN(Enum(2)), L1Address(16), SynapseType::excitatory, STPMode::off);
 
 	size_t num_drivers, num_synapses;
-	std::map<Side_Parity_Decoder_STP, size_t> synapse_histogram;
-	std::map<Side_Parity_Decoder_STP, size_t> synrow_histogram;
+	SynapseHistogram synapse_histogram;
+	SynapseHistogram synrow_histogram;
 	std::tie(num_drivers, num_synapses) = SynapseDriverRequirements::_calc(
 		sc, target_synapses_per_synaptic_input_granularity, synapse_histogram,
 		synrow_histogram);
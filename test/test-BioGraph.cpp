@@ -0,0 +1,138 @@
+#include "test/common.h"
+
+#include <functional>
+#include <sstream>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+#include <boost/make_shared.hpp>
+
+#include "euter/objectstore.h"
+#include "euter/fixedprobabilityconnector.h"
+#include "euter/nativerandomgenerator.h"
+
+#include "marocco/BioGraph.h"
+
+namespace marocco {
+
+class ABioGraph : public ::testing::Test
+{
+protected:
+	ABioGraph()
+	{
+		pop0 = Population::create(os, 20, CellType::IF_cond_exp);
+		auto pop1 = Population::create(os, 30, CellType::IF_cond_exp);
+		auto con = boost::make_shared<FixedProbabilityConnector>(0.3, true, 1.0);
+		auto rng = boost::make_shared<NativeRandomGenerator>(1234);
+		Projection::create(os, pop0, pop1, con, rng);
+		Projection::create(os, pop1, pop0, con, rng);
+		graph.load(os);
+	}
+
+	ObjectStore os;
+	PopulationPtr pop0;
+	BioGraph graph;
+};
+
+TEST_F(ABioGraph, canBeRestoredFromStoredForm)
+{
+	results::BioGraph stored;
+	graph.store(stored);
+	EXPECT_EQ(2, stored.num_vertices());
+	EXPECT_EQ(2, stored.num_edges());
+
+	std::stringstream stream;
+	{
+		boost::archive::binary_oarchive archive{stream};
+		archive << stored;
+	}
+	results::BioGraph loaded;
+	{
+		boost::archive::binary_iarchive archive{stream};
+		archive >> loaded;
+	}
+
+	BioGraph restored;
+	ASSERT_TRUE(restored.load(os, loaded));
+	ASSERT_EQ(boost::num_vertices(graph.graph()), boost::num_vertices(restored.graph()));
+	ASSERT_EQ(boost::num_edges(graph.graph()), boost::num_edges(restored.graph()));
+
+	for (auto const& edge : make_iterable(boost::edges(graph.graph()))) {
+		auto const id = graph.edge_to_id(edge);
+		auto const other = restored.edge_from_id(id);
+		EXPECT_EQ(boost::source(edge, graph.graph()), boost::source(other, restored.graph()));
+		EXPECT_EQ(boost::target(edge, graph.graph()), boost::target(other, restored.graph()));
+		EXPECT_EQ(
+			graph.graph()[edge].projection()->id(),
+			restored.graph()[other].projection()->id());
+		EXPECT_EQ(graph.connectivity(edge), restored.connectivity(other));
+	}
+}
+
+TEST_F(ABioGraph, rejectsStoredFormOfDifferentNetwork)
+{
+	results::BioGraph stored;
+	graph.store(stored);
+
+	ObjectStore other;
+	Population::create(other, 20, CellType::IF_cond_exp);
+	Population::create(other, 31, CellType::IF_cond_exp);
+
+	BioGraph restored;
+	EXPECT_FALSE(restored.load(other, stored));
+	EXPECT_EQ(0, boost::num_vertices(restored.graph()));
+}
+
+TEST_F(ABioGraph, rejectsStoredFormMissingProjections)
+{
+	results::BioGraph stored;
+	graph.store(stored);
+
+	auto con = boost::make_shared<FixedProbabilityConnector>(0.3, true, 1.0);
+	auto rng = boost::make_shared<NativeRandomGenerator>(1234);
+	Projection::create(os, pop0, pop0, con, rng);
+
+	BioGraph restored;
+	EXPECT_FALSE(restored.load(os, stored));
+	EXPECT_EQ(0, boost::num_vertices(restored.graph()));
+}
+
+TEST_F(ABioGraph, rejectsStoredFormWithCorruptSynapses)
+{
+	results::BioGraph stored;
+	graph.store(stored);
+
+	auto const corrupted = [&stored](std::function<void(results::BioGraph::Edge&)> modify) {
+		results::BioGraph result;
+		for (auto const& vertex : stored.vertices()) {
+			result.add(vertex);
+		}
+		for (auto edge : stored.edges()) {
+			if (result.num_edges() == 0) {
+				modify(edge);
+			}
+			result.add(std::move(edge));
+		}
+		return result;
+	};
+
+	ASSERT_FALSE(stored.edges().front().targets.empty());
+
+	BioGraph restored;
+	EXPECT_FALSE(restored.load(os, corrupted([](results::BioGraph::Edge& edge) {
+		edge.row_offsets.pop_back();
+	})));
+	EXPECT_FALSE(restored.load(os, corrupted([](results::BioGraph::Edge& edge) {
+		edge.row_offsets.back() += 1;
+	})));
+	EXPECT_FALSE(restored.load(os, corrupted([](results::BioGraph::Edge& edge) {
+		edge.row_offsets[1] = edge.row_offsets.back() + 1;
+	})));
+	EXPECT_FALSE(restored.load(os, corrupted([](results::BioGraph::Edge& edge) {
+		edge.targets.back() = edge.num_targets;
+	})));
+	EXPECT_EQ(0, boost::num_vertices(restored.graph()));
+
+	EXPECT_TRUE(restored.load(os, corrupted([](results::BioGraph::Edge&) {})));
+}
+
+} // namespace marocco
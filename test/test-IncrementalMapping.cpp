@@ -0,0 +1,287 @@
+#include "test/common.h"
+
+#include <boost/dynamic_bitset.hpp>
+#include <boost/make_shared.hpp>
+
+#include "euter/fixedprobabilityconnector.h"
+#include "euter/nativerandomgenerator.h"
+#include "euter/objectstore.h"
+#include "euter/typedcellparametervector.h"
+#include "redman/backend/MockBackend.h"
+#include "redman/resources/Wafer.h"
+#include "sthal/Wafer.h"
+
+#include "marocco/IncrementalMapping.h"
+#include "marocco/Mapper.h"
+#include "marocco/experiment/parameters/Experiment.h"
+#include "marocco/results/Marocco.h"
+#include "pymarocco/PyMarocco.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+
+namespace {
+
+typedef boost::dynamic_bitset<> mask_type;
+
+/// Spike source projecting to two target populations.
+struct Network
+{
+	Network(mask_type const& mask = mask_type(10).set()) : os()
+	{
+		source = Population::create(os, 5, CellType::SpikeSourceArray);
+		target0 = Population::create(os, 10, CellType::IF_cond_exp);
+		target1 = Population::create(os, 10, CellType::IF_cond_exp);
+		auto const con = boost::make_shared<FixedProbabilityConnector>(1., true, 0.01);
+		auto const rng = boost::make_shared<NativeRandomGenerator>(1234);
+		proj0 = Projection::create(os, source, PopulationView(target0, mask), con, rng);
+		proj1 = Projection::create(os, source, target1, con, rng);
+	}
+
+	BioGraph bio_graph() const
+	{
+		BioGraph result;
+		result.load(os);
+		return result;
+	}
+
+	ObjectStore os;
+	PopulationPtr source;
+	PopulationPtr target0;
+	PopulationPtr target1;
+	ProjectionPtr proj0;
+	ProjectionPtr proj1;
+};
+
+} // namespace
+
+class IncrementalWeightUpdateTest : public ::testing::Test
+{
+protected:
+	IncrementalWeightUpdateTest() : wafer(33), pymarocco(pymarocco::PyMarocco::create())
+	{
+		pymarocco->calib_backend = pymarocco::PyMarocco::CalibBackend::Default;
+		pymarocco->incremental_weight_update = true;
+		pymarocco->continue_despite_synapse_loss = true;
+		pymarocco->neuron_placement.skip_hicanns_without_neuron_blacklisting(false);
+	}
+
+	std::unique_ptr<resource_manager_t> resources() const
+	{
+		std::unique_ptr<resource_manager_t> mgr(
+			new resource_manager_t{boost::make_shared<redman::backend::MockBackend>()});
+		mgr->inject(redman::resources::WaferWithBackend(mgr->backend(), wafer));
+		return mgr;
+	}
+
+	bool weights_only(Network const& network) const
+	{
+		return incremental.weights_only(
+			network.os, network.bio_graph(), *pymarocco, *resources());
+	}
+
+	void store(Network const& network)
+	{
+		incremental.store(network.os, network.bio_graph(), *pymarocco, *resources());
+	}
+
+	Wafer const wafer;
+	boost::shared_ptr<pymarocco::PyMarocco> pymarocco;
+	IncrementalMapping incremental;
+};
+
+TEST_F(IncrementalWeightUpdateTest, detectsChangedWeights)
+{
+	Network network;
+	EXPECT_FALSE(weights_only(network));
+	store(network);
+	EXPECT_TRUE(weights_only(network));
+
+	network.proj0->getWeights().get()(0, 0) = 0.02;
+	ASSERT_TRUE(weights_only(network));
+
+	auto const bio_graph = network.bio_graph();
+	auto const changed = incremental.changed_edges(bio_graph);
+	ASSERT_EQ(1, changed.size());
+	EXPECT_EQ(network.proj0->id(), bio_graph.graph()[changed.front()].projection()->id());
+}
+
+TEST_F(IncrementalWeightUpdateTest, rejectsChangedTopology)
+{
+	Network network;
+	store(network);
+	Population::create(network.os, 3, CellType::IF_cond_exp);
+	EXPECT_FALSE(weights_only(network));
+}
+
+TEST_F(IncrementalWeightUpdateTest, rejectsChangedMask)
+{
+	store(Network());
+	// Networks are rebuilt from scratch, thus this only differs in the mask.
+	EXPECT_TRUE(weights_only(Network()));
+
+	mask_type mask(10);
+	mask.set();
+	mask.reset(3);
+	EXPECT_FALSE(weights_only(Network(mask)));
+}
+
+TEST_F(IncrementalWeightUpdateTest, rejectsChangedNeuronParameters)
+{
+	Network network;
+	store(network);
+	auto& parameters = dynamic_cast<TypedCellParameterVector<CellType::IF_cond_exp>&>(
+		network.target0->parameters());
+	parameters.parameters()[0].tau_m += 1.;
+	EXPECT_FALSE(weights_only(network));
+}
+
+TEST_F(IncrementalWeightUpdateTest, ignoresChangedSpikeSources)
+{
+	Network network;
+	store(network);
+	auto& parameters = dynamic_cast<TypedCellParameterVector<CellType::SpikeSourceArray>&>(
+		network.source->parameters());
+	parameters.parameters()[0].spike_times.push_back(5.);
+	EXPECT_TRUE(weights_only(network));
+}
+
+TEST_F(IncrementalWeightUpdateTest, rejectsChangedMappingParameters)
+{
+	Network network;
+	store(network);
+	pymarocco->neuron_placement.default_neuron_size(8);
+	EXPECT_FALSE(weights_only(network));
+}
+
+TEST_F(IncrementalWeightUpdateTest, updatesOnlyHICANNsWithChangedWeights)
+{
+	Network network;
+	HICANNOnWafer const hicann0(Enum(276));
+	HICANNOnWafer const hicann1(Enum(277));
+	pymarocco->manual_placement.on_hicann(network.target0->id(), hicann0);
+	pymarocco->manual_placement.on_hicann(network.target1->id(), hicann1);
+
+	sthal::Wafer hardware(wafer);
+	auto results = boost::make_shared<results::Marocco>();
+	auto const state = boost::make_shared<IncrementalMapping>();
+
+	{
+		auto const mgr = resources();
+		Mapper mapper(hardware, *mgr, pymarocco, results, state);
+		mapper.run(network.os);
+	}
+	EXPECT_EQ(1, state->changed_hicanns().count(hicann0));
+	EXPECT_EQ(1, state->changed_hicanns().count(hicann1));
+
+	network.proj0->getWeights().get()(0, 0) = 0.02;
+	{
+		auto const mgr = resources();
+		Mapper mapper(hardware, *mgr, pymarocco, results, state);
+		mapper.run(network.os);
+	}
+	EXPECT_EQ(IncrementalMapping::hicanns_type{hicann0}, state->changed_hicanns());
+	EXPECT_EQ(1, pymarocco->getStats().getStage("weight_update").calls);
+}
+
+class IncrementalMappingTest : public ::testing::Test
+{
+protected:
+	IncrementalMappingTest()
+		: hicann(Enum(42)),
+		  input(BioNeuron(0, 0)),
+		  external(LogicalNeuron::external(0, 0)),
+		  recorded(LogicalNeuron::on(NeuronBlockOnWafer(NeuronBlockOnHICANN(0), hicann))
+		               .add(NeuronOnNeuronBlock(X(0), Y(0)), 2)
+		               .done())
+	{
+		parameters.bio_duration_in_s(1.);
+		results.placement.add(input, external);
+		results.placement.set_address(
+			external,
+			L1AddressOnWafer(
+				DNCMergerOnWafer(DNCMergerOnHICANN(0), hicann), HMF::HICANN::L1Address(1)));
+		results.spike_times.set(input, {10., 20.});
+	}
+
+	HICANNOnWafer const hicann;
+	BioNeuron const input;
+	LogicalNeuron const external;
+	LogicalNeuron const recorded;
+	results::Marocco results;
+	experiment::parameters::Experiment parameters;
+	IncrementalMapping incremental;
+};
+
+TEST_F(IncrementalMappingTest, configuresEverythingOnFirstRun)
+{
+	auto const changes = incremental.update_experiment(results, parameters);
+	EXPECT_TRUE(changes.all);
+	EXPECT_TRUE(changes.analog_outputs.empty());
+	ASSERT_EQ(1, changes.spike_input.size());
+	EXPECT_EQ(hicann, *changes.spike_input.begin());
+	EXPECT_EQ(1, incremental.changed_hicanns().count(hicann));
+}
+
+TEST_F(IncrementalMappingTest, detectsUnchangedExperiment)
+{
+	incremental.update_experiment(results, parameters);
+	auto const changes = incremental.update_experiment(results, parameters);
+	EXPECT_FALSE(changes.all);
+	EXPECT_TRUE(changes.analog_outputs.empty());
+	EXPECT_TRUE(changes.spike_input.empty());
+}
+
+TEST_F(IncrementalMappingTest, detectsChangedSpikeInput)
+{
+	incremental.update_experiment(results, parameters);
+
+	results.spike_times.add(input, 30.);
+	auto changes = incremental.update_experiment(results, parameters);
+	EXPECT_FALSE(changes.all);
+	EXPECT_EQ(1, changes.spike_input.count(hicann));
+
+	// Spikes after the end of the experiment are not uploaded.
+	results.spike_times.add(input, 2000.);
+	changes = incremental.update_experiment(results, parameters);
+	EXPECT_TRUE(changes.spike_input.empty());
+
+	parameters.speedup(parameters.speedup() * 2);
+	changes = incremental.update_experiment(results, parameters);
+	EXPECT_EQ(1, changes.spike_input.count(hicann));
+}
+
+TEST_F(IncrementalMappingTest, detectsChangedAnalogOutputs)
+{
+	incremental.update_experiment(results, parameters);
+
+	results.analog_outputs.record(recorded);
+	auto changes = incremental.update_experiment(results, parameters);
+	EXPECT_FALSE(changes.all);
+	EXPECT_EQ(1, changes.analog_outputs.count(hicann));
+	EXPECT_TRUE(changes.spike_input.empty());
+
+	// HICANNs without analog outputs have to be reconfigured, too.
+	results.analog_outputs.unrecord(recorded);
+	changes = incremental.update_experiment(results, parameters);
+	EXPECT_EQ(1, changes.analog_outputs.count(hicann));
+}
+
+TEST_F(IncrementalMappingTest, resetInvalidatesExperiment)
+{
+	incremental.update_experiment(results, parameters);
+	incremental.reset();
+	EXPECT_TRUE(incremental.update_experiment(results, parameters).all);
+}
+
+TEST_F(IncrementalMappingTest, resetInvalidatesHardwareConfiguration)
+{
+	EXPECT_FALSE(incremental.configured());
+	incremental.configured(true);
+	EXPECT_TRUE(incremental.configured());
+	incremental.reset();
+	EXPECT_FALSE(incremental.configured());
+}
+
+} // namespace marocco
@@ -29,4 +29,11 @@ TEST(Logger, MacroLogging)
 	MAROCCO_TRACE("a trace msg " << 42);
 }
 
+TEST(Logger, CachesLoggerHandles)
+{
+	auto const& logger = marocco::Logger::getLoggerPtr(this);
+	EXPECT_EQ(logger, marocco::Logger::getLoggerPtr(this));
+	EXPECT_EQ(log4cxx::Logger::getLogger(marocco::Logger::getLogger(this)), logger);
+}
+
 } // marocco
@@ -0,0 +1,219 @@
+#include "test/common.h"
+
+#include <ctime>
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+#include <boost/make_shared.hpp>
+
+#include "euter/fixedprobabilityconnector.h"
+#include "euter/nativerandomgenerator.h"
+#include "euter/objectstore.h"
+#include "redman/backend/MockBackend.h"
+#include "redman/resources/Wafer.h"
+
+#include "marocco/MappingCache.h"
+#include "marocco/util/iterable.h"
+#include "pymarocco/PyMarocco.h"
+
+using namespace HMF::Coordinate;
+namespace bfs = boost::filesystem;
+
+namespace marocco {
+
+class MappingCacheTest : public ::testing::Test
+{
+protected:
+	MappingCacheTest()
+		: directory(bfs::temp_directory_path() / bfs::unique_path("marocco-cache-%%%%-%%%%")),
+		  wafer(33),
+		  pymarocco(pymarocco::PyMarocco::create()),
+		  hardware(wafer)
+	{
+		auto pop0 = Population::create(os, 10, CellType::IF_cond_exp);
+		auto pop1 = Population::create(os, 10, CellType::IF_cond_exp);
+		auto const con = boost::make_shared<FixedProbabilityConnector>(0.5, true, 0.01);
+		auto const rng = boost::make_shared<NativeRandomGenerator>(1234);
+		proj = Projection::create(os, pop0, pop1, con, rng);
+
+		results.spike_times.set(BioNeuron(0, 0), {1., 2.});
+		stats.setSynapseLoss(3);
+		stats.setSynapsesSet(42);
+	}
+
+	~MappingCacheTest()
+	{
+		boost::system::error_code error;
+		bfs::remove_all(directory, error);
+	}
+
+	std::unique_ptr<resource_manager_t> resources(
+		HICANNOnWafer const* disabled = nullptr) const
+	{
+		std::unique_ptr<resource_manager_t> mgr(
+			new resource_manager_t{boost::make_shared<redman::backend::MockBackend>()});
+		redman::resources::WaferWithBackend res(mgr->backend(), wafer);
+		if (disabled) {
+			res.hicanns()->disable(*disabled, true);
+		}
+		mgr->inject(res);
+		return mgr;
+	}
+
+	MappingCache::key_type key(HICANNOnWafer const* disabled = nullptr) const
+	{
+		BioGraph bio_graph;
+		bio_graph.load(os);
+		return MappingCache::key(bio_graph, *pymarocco, *resources(disabled), wafer);
+	}
+
+	std::unique_ptr<MappingCache> cache(size_t max_size = 0) const
+	{
+		return std::unique_ptr<MappingCache>(new MappingCache(directory.native(), max_size));
+	}
+
+	bool load(MappingCache& cache, MappingCache::key_type const& key)
+	{
+		results::Marocco loaded_results;
+		sthal::Wafer loaded_hardware(wafer);
+		pymarocco::MappingStats loaded_stats;
+		return cache.load(key, loaded_results, loaded_hardware, loaded_stats);
+	}
+
+	bfs::path const directory;
+	Wafer const wafer;
+	ObjectStore os;
+	ProjectionPtr proj;
+	boost::shared_ptr<pymarocco::PyMarocco> pymarocco;
+	results::Marocco results;
+	sthal::Wafer hardware;
+	pymarocco::MappingStats stats;
+};
+
+TEST_F(MappingCacheTest, hasStableKeys)
+{
+	EXPECT_EQ(key(), key());
+	EXPECT_EQ(16, key().size());
+}
+
+TEST_F(MappingCacheTest, keyDependsOnWeights)
+{
+	auto const previous = key();
+	auto& weights = proj->getWeights().get();
+	for (size_t ii = 0; ii < weights.size1(); ++ii) {
+		for (size_t jj = 0; jj < weights.size2(); ++jj) {
+			if (weights(ii, jj) > 0.) {
+				weights(ii, jj) *= 2;
+			}
+		}
+	}
+	EXPECT_NE(previous, key());
+}
+
+TEST_F(MappingCacheTest, keyDependsOnDefects)
+{
+	HICANNOnWafer const hicann(Enum(42));
+	EXPECT_NE(key(), key(&hicann));
+}
+
+TEST_F(MappingCacheTest, keyDependsOnParameters)
+{
+	auto const previous = key();
+	pymarocco->l1_routing.algorithm(routing::parameters::L1Routing::Algorithm::dijkstra);
+	auto const routing = key();
+	EXPECT_NE(previous, routing);
+
+	pymarocco->neuron_placement.default_neuron_size(8);
+	EXPECT_NE(routing, key());
+}
+
+TEST_F(MappingCacheTest, keyIgnoresParameterTranslation)
+{
+	auto const previous = key();
+	pymarocco->calib_path = "/some/where/else";
+	pymarocco->experiment.offset_in_s(1.);
+	EXPECT_EQ(previous, key());
+}
+
+TEST_F(MappingCacheTest, roundTripsEntries)
+{
+	auto const entry = key();
+	{
+		auto const c = cache();
+		c->store(entry, results, hardware, stats);
+	}
+
+	auto const c = cache();
+	results::Marocco loaded_results;
+	sthal::Wafer loaded_hardware(wafer);
+	pymarocco::MappingStats loaded_stats;
+	ASSERT_TRUE(c->load(entry, loaded_results, loaded_hardware, loaded_stats));
+	EXPECT_EQ(
+		results.spike_times.get(BioNeuron(0, 0)),
+		loaded_results.spike_times.get(BioNeuron(0, 0)));
+	EXPECT_EQ(3, loaded_stats.getSynapseLoss());
+	EXPECT_EQ(42, loaded_stats.getSynapsesSet());
+	EXPECT_EQ(wafer, loaded_hardware.index());
+}
+
+TEST_F(MappingCacheTest, countsHitsAndMisses)
+{
+	auto const c = cache();
+	EXPECT_FALSE(load(*c, "missing"));
+	c->store("entry", results, hardware, stats);
+	EXPECT_TRUE(load(*c, "entry"));
+	EXPECT_TRUE(load(*c, "entry"));
+	EXPECT_EQ(2, c->hits());
+	EXPECT_EQ(1, c->misses());
+
+	// Counts are shared by all users of the cache directory.
+	auto const other = cache();
+	EXPECT_EQ(2, other->hits());
+	EXPECT_EQ(1, other->misses());
+}
+
+TEST_F(MappingCacheTest, treatsBrokenEntriesAsMisses)
+{
+	auto const c = cache();
+	c->store("entry", results, hardware, stats);
+	{
+		// Truncate the stored results.
+		bfs::ofstream stream(directory / "entry" / "results.bin", std::ios::trunc);
+		stream << "garbage";
+	}
+
+	EXPECT_FALSE(load(*c, "entry"));
+	EXPECT_FALSE(bfs::exists(directory / "entry"));
+	EXPECT_EQ(0, c->hits());
+	EXPECT_EQ(1, c->misses());
+}
+
+TEST_F(MappingCacheTest, evictsLeastRecentlyUsedEntries)
+{
+	size_t entry_size = 0;
+	{
+		auto const c = cache();
+		c->store("first", results, hardware, stats);
+		bfs::directory_iterator const begin(directory / "first");
+		for (auto const& file : make_iterable(begin, bfs::directory_iterator())) {
+			entry_size += bfs::file_size(file.path());
+		}
+		c->store("second", results, hardware, stats);
+	}
+
+	// Timestamps only have a resolution of seconds, thus they are set explicitly.
+	std::time_t const now = std::time(nullptr);
+	bfs::last_write_time(directory / "first", now - 20);
+	bfs::last_write_time(directory / "second", now - 10);
+
+	// Room for two entries only.
+	auto const c = cache(2 * entry_size + entry_size / 2);
+	// Loading marks the first entry as most recently used.
+	EXPECT_TRUE(load(*c, "first"));
+	c->store("third", results, hardware, stats);
+
+	EXPECT_TRUE(bfs::exists(directory / "first"));
+	EXPECT_FALSE(bfs::exists(directory / "second"));
+	EXPECT_TRUE(bfs::exists(directory / "third"));
+}
+
+} // namespace marocco
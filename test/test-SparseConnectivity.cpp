@@ -0,0 +1,144 @@
+#include "test/common.h"
+
+#include <limits>
+#include <stdexcept>
+#include <boost/numeric/ublas/matrix.hpp>
+
+#include "marocco/SparseConnectivity.h"
+
+namespace marocco {
+
+class ASparseConnectivity : public ::testing::Test
+{
+protected:
+	ASparseConnectivity() : weights(3, 4, 0.)
+	{
+		// 0 . 1 .
+		// . . . .
+		// 2 n 3 4
+		weights(0, 0) = 0.5;
+		weights(0, 2) = 1.0;
+		weights(2, 0) = 2.0;
+		weights(2, 1) = std::numeric_limits<double>::quiet_NaN();
+		weights(2, 2) = 3.0;
+		weights(2, 3) = 4.0;
+		weights(1, 3) = -1.0;
+	}
+
+	boost::numeric::ublas::matrix<double> weights;
+};
+
+TEST_F(ASparseConnectivity, onlyStoresSynapses)
+{
+	SparseConnectivity connectivity(weights);
+	EXPECT_EQ(3, connectivity.num_sources());
+	EXPECT_EQ(4, connectivity.num_targets());
+	EXPECT_EQ(5, connectivity.size());
+	EXPECT_TRUE(connectivity.targets(1).empty());
+	EXPECT_TRUE(connectivity.sources(1).empty());
+}
+
+TEST_F(ASparseConnectivity, providesRowAccess)
+{
+	SparseConnectivity connectivity(weights);
+	std::vector<size_t> targets;
+	std::vector<double> values;
+	for (auto const& entry : connectivity.targets(2)) {
+		targets.push_back(entry.index);
+		values.push_back(entry.weight);
+	}
+	EXPECT_EQ((std::vector<size_t>{0, 2, 3}), targets);
+	EXPECT_EQ((std::vector<double>{2.0, 3.0, 4.0}), values);
+	EXPECT_THROW(connectivity.targets(3), std::out_of_range);
+}
+
+TEST_F(ASparseConnectivity, providesColumnAccess)
+{
+	SparseConnectivity connectivity(weights);
+	std::vector<size_t> sources;
+	for (auto const& entry : connectivity.sources(0)) {
+		sources.push_back(entry.index);
+		EXPECT_EQ(weights(entry.index, 0), entry.weight);
+	}
+	EXPECT_EQ((std::vector<size_t>{0, 2}), sources);
+	EXPECT_THROW(connectivity.sources(4), std::out_of_range);
+}
+
+TEST_F(ASparseConnectivity, findsPositionsInRowMajorOrder)
+{
+	SparseConnectivity connectivity(weights);
+	EXPECT_EQ(0, connectivity.position(0, 0));
+	EXPECT_EQ(1, connectivity.position(0, 2));
+	EXPECT_EQ(2, connectivity.position(2, 0));
+	EXPECT_EQ(4, connectivity.position(2, 3));
+
+	// Missing synapses, including NaN and negative weights.
+	EXPECT_EQ(connectivity.size(), connectivity.position(0, 1));
+	EXPECT_EQ(connectivity.size(), connectivity.position(2, 1));
+	EXPECT_EQ(connectivity.size(), connectivity.position(1, 3));
+	EXPECT_EQ(connectivity.size(), connectivity.position(3, 0));
+}
+
+TEST_F(ASparseConnectivity, providesWeightsOfSynapses)
+{
+	SparseConnectivity connectivity(weights);
+	EXPECT_EQ(0.5, connectivity.weight(0, 0));
+	EXPECT_EQ(3.0, connectivity.weight(2, 2));
+	EXPECT_THROW(connectivity.weight(2, 1), std::out_of_range);
+	EXPECT_THROW(connectivity.weight(1, 3), std::out_of_range);
+	EXPECT_THROW(connectivity.weight(3, 0), std::out_of_range);
+}
+
+TEST_F(ASparseConnectivity, distinguishesStructureFromWeights)
+{
+	SparseConnectivity const connectivity(weights);
+
+	auto changed_weight = weights;
+	changed_weight(2, 3) = 5.0;
+	SparseConnectivity const reweighted(changed_weight);
+	EXPECT_TRUE(connectivity.same_synapses(reweighted));
+	EXPECT_NE(connectivity, reweighted);
+
+	auto removed_synapse = weights;
+	removed_synapse(2, 3) = 0.;
+	SparseConnectivity const pruned(removed_synapse);
+	EXPECT_FALSE(connectivity.same_synapses(pruned));
+
+	EXPECT_EQ(connectivity, SparseConnectivity(weights));
+}
+
+TEST_F(ASparseConnectivity, canBeRestoredFromRows)
+{
+	SparseConnectivity connectivity(weights);
+
+	std::vector<size_t> row_offsets{0};
+	std::vector<SparseConnectivity::Entry> rows;
+	for (size_t src = 0; src < connectivity.num_sources(); ++src) {
+		for (auto const& entry : connectivity.targets(src)) {
+			rows.push_back(entry);
+		}
+		row_offsets.push_back(rows.size());
+	}
+
+	SparseConnectivity restored(3, 4, row_offsets, rows);
+	EXPECT_EQ(connectivity, restored);
+	std::vector<size_t> sources;
+	for (auto const& entry : restored.sources(2)) {
+		sources.push_back(entry.index);
+	}
+	EXPECT_EQ((std::vector<size_t>{0, 2}), sources);
+
+	EXPECT_THROW(SparseConnectivity(2, 4, row_offsets, rows), std::invalid_argument);
+	EXPECT_THROW(SparseConnectivity(3, 2, row_offsets, rows), std::invalid_argument);
+	row_offsets.back() = 4;
+	EXPECT_THROW(SparseConnectivity(3, 4, row_offsets, rows), std::invalid_argument);
+}
+
+TEST(SparseConnectivity, isEmptyByDefault)
+{
+	SparseConnectivity connectivity;
+	EXPECT_EQ(0, connectivity.size());
+	EXPECT_THROW(connectivity.targets(0), std::out_of_range);
+}
+
+} // namespace marocco
@@ -0,0 +1,101 @@
+#include <stdexcept>
+
+#include "marocco/util/stage_timer.h"
+#include "test/common.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+
+TEST(StageTimer, NestsStagesOfSameStatistics)
+{
+	pymarocco::MappingStats stats;
+	pymarocco::MappingStats other;
+	{
+		StageTimer outer(stats, "mapping");
+		{
+			StageTimer unrelated(other, "unrelated");
+			StageTimer inner(stats, "routing");
+			EXPECT_EQ("mapping/routing", inner.name());
+		}
+		StageTimer inner(stats, "routing");
+	}
+
+	auto const& stages = stats.getStages();
+	ASSERT_EQ(2, stages.size());
+	EXPECT_EQ("mapping", stages[0].name);
+	EXPECT_EQ(0, stages[0].depth());
+	EXPECT_EQ(1, stages[0].calls);
+	EXPECT_EQ("mapping/routing", stages[1].name);
+	EXPECT_EQ(1, stages[1].depth());
+	EXPECT_EQ(2, stages[1].calls);
+	EXPECT_LE(stages[1].wall_time, stages[0].wall_time);
+
+	ASSERT_EQ(1, other.getStages().size());
+	EXPECT_EQ("unrelated", other.getStage("unrelated").name);
+	EXPECT_THROW(other.getStage("mapping"), std::out_of_range);
+}
+
+TEST(StageTimer, StopsOnlyOnce)
+{
+	pymarocco::MappingStats stats;
+	{
+		StageTimer timer(stats, "mapping");
+		timer.stop();
+		StageTimer next(stats, "experiment");
+		EXPECT_EQ("experiment", next.name());
+	}
+	EXPECT_EQ(1, stats.getStage("mapping").calls);
+}
+
+TEST(StageTimer, KeepsSlowestHotSpotsPerStage)
+{
+	pymarocco::MappingStats stats;
+	size_t const max = pymarocco::MappingStats::max_hot_spots_per_stage;
+	{
+		StageTimer timer(stats, "parameter_translation");
+		for (size_t ii = 0; ii < max + 5; ++ii) {
+			timer.hot_spot(HICANNOnWafer(Enum(ii)), std::chrono::milliseconds(ii));
+		}
+		StageTimer other(stats, "routing");
+		other.hot_spot(HICANNOnWafer(Enum(0)), std::chrono::milliseconds(100));
+	}
+
+	auto const& hot_spots = stats.getHotSpots();
+	ASSERT_EQ(max + 1, hot_spots.size());
+	for (size_t ii = 0; ii < max; ++ii) {
+		EXPECT_EQ("parameter_translation", hot_spots[ii].stage);
+		EXPECT_EQ(HICANNOnWafer(Enum(max + 4 - ii)), hot_spots[ii].hicann);
+	}
+	EXPECT_EQ("parameter_translation/routing", hot_spots.back().stage);
+}
+
+TEST(StageTimer, NestsStagesRecordedInOtherThreadsIntoCurrentStage)
+{
+	pymarocco::MappingStats stats;
+	pymarocco::MappingStats candidate;
+	EXPECT_EQ("", StageTimer::current(stats));
+	{
+		StageTimer outer(stats, "mapping");
+		StageTimer inner(stats, "routing");
+		EXPECT_EQ("mapping/routing", StageTimer::current(stats));
+		EXPECT_EQ("", StageTimer::current(candidate));
+
+		{
+			// Would be recorded in a worker thread, without enclosing stage.
+			StageTimer timer(candidate, "l1_routing");
+			timer.hot_spot(HICANNOnWafer(Enum(0)), std::chrono::milliseconds(1));
+		}
+		stats.addStages(candidate, StageTimer::current(stats));
+	}
+	EXPECT_EQ("", StageTimer::current(stats));
+
+	auto const& stages = stats.getStages();
+	ASSERT_EQ(3, stages.size());
+	EXPECT_EQ("mapping/routing/l1_routing", stages[2].name);
+	EXPECT_EQ(1, stages[2].calls);
+	ASSERT_EQ(1, stats.getHotSpots().size());
+	EXPECT_EQ("mapping/routing/l1_routing", stats.getHotSpots().front().stage);
+}
+
+} // namespace marocco
@@ -0,0 +1,62 @@
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <boost/filesystem.hpp>
+
+#include "marocco/util/trace.h"
+#include "test/common.h"
+
+namespace marocco {
+namespace trace {
+
+namespace {
+
+std::string read_file(std::string const& filename)
+{
+	std::ifstream file(filename);
+	std::stringstream contents;
+	contents << file.rdbuf();
+	return contents.str();
+}
+
+} // namespace
+
+TEST(Trace, IsDisabledByDefault)
+{
+	EXPECT_FALSE(enabled());
+	Scope scope("ignored", "test");
+}
+
+TEST(Trace, WritesEventsOfAllThreads)
+{
+	auto const filename =
+		(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).native();
+
+	start();
+	EXPECT_TRUE(enabled());
+	{
+		Scope scope("main \"thread\"", "test", {"hicann", 42}, {"merger", 3});
+		std::thread other([] { Scope scope("other", "test"); });
+		other.join();
+	}
+	write(filename);
+	EXPECT_FALSE(enabled());
+
+	auto const contents = read_file(filename);
+	boost::filesystem::remove(filename);
+
+	EXPECT_NE(std::string::npos, contents.find("\"traceEvents\""));
+	EXPECT_NE(std::string::npos, contents.find("\"name\":\"main \\\"thread\\\"\""));
+	EXPECT_NE(std::string::npos, contents.find("\"args\":{\"hicann\":42,\"merger\":3}"));
+	EXPECT_NE(std::string::npos, contents.find("\"name\":\"other\""));
+	EXPECT_EQ(std::string::npos, contents.find("ignored"));
+
+	// Events are not written twice.
+	start();
+	write(filename);
+	EXPECT_EQ(std::string::npos, read_file(filename).find("\"name\":\"other\""));
+	boost::filesystem::remove(filename);
+}
+
+} // namespace trace
+} // namespace marocco
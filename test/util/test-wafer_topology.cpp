@@ -0,0 +1,56 @@
+#include "test/common.h"
+
+#include "marocco/util/wafer_topology.h"
+
+#include <stdexcept>
+
+#include "hal/Coordinate/iter_all.h"
+
+using namespace HMF::Coordinate;
+
+namespace marocco {
+namespace wafer_topology {
+
+namespace {
+
+/// Reference implementation using the throwing coordinate conversions of halbe.
+boost::optional<HICANNOnWafer> move(HICANNOnWafer const& hicann, Direction const& direction)
+{
+	try {
+		return hicann.move(direction);
+	} catch (std::overflow_error const&) {
+	} catch (std::domain_error const&) {
+	}
+	return boost::none;
+}
+
+} // namespace
+
+static_assert(detail::neighbor_table[0][0] == -1, "first HICANN has no northern neighbor");
+static_assert(detail::neighbor_table[0][1] == 1, "second HICANN is east of first HICANN");
+static_assert(detail::neighbor_table[174][2] == 210, "wrong southern neighbor");
+
+TEST(WaferTopology, MatchesHICANNOnWafer)
+{
+	for (auto const hicann : iter_all<HICANNOnWafer>()) {
+		for (auto const direction : iter_all<Direction>()) {
+			EXPECT_EQ(move(hicann, direction), neighbor(hicann, direction))
+				<< hicann << " " << direction;
+		}
+	}
+}
+
+TEST(WaferTopology, HandlesBorderOfWafer)
+{
+	HICANNOnWafer const corner(X(12), Y(0));
+	EXPECT_FALSE(neighbor(corner, north));
+	EXPECT_FALSE(neighbor(corner, west));
+	EXPECT_EQ(HICANNOnWafer(X(13), Y(0)), *neighbor(corner, east));
+
+	// Round wafer: there is no HICANN north of the leftmost one in the fifth row.
+	EXPECT_FALSE(neighbor(HICANNOnWafer(X(4), Y(4)), north));
+	EXPECT_EQ(HICANNOnWafer(X(4), Y(5)), *neighbor(HICANNOnWafer(X(4), Y(4)), south));
+}
+
+} // namespace wafer_topology
+} // namespace marocco